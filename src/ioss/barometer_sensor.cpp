@@ -1,52 +1,111 @@
-// UART 방식
+// UART 방식 (GY-39)
+#include "barometer_sensor.h"
+#include "../oss/timer.h"
+#include "../oss/blackbox.h"
+#include "../oss/transport.h"
 #include <iostream>
-#include <fcntl.h>
-#include <termios.h>
 #include <unistd.h>
 #include <cstring>
+#include <cmath>
+#include <stdexcept>
 
+#define BARO_FRAME_TYPE 0x45     // 온도/기압/습도/고도 프레임
+#define LIGHT_FRAME_TYPE 0x15    // 조도 프레임 (사용하지 않음)
+#define BARO_READ_SIZE 64
 
-int main() {
-    int serial_fd = open("/dev/ttyAMA0", O_RDWR | O_NOCTTY | O_NDELAY);
-    if (serial_fd == -1) {
-        std::cerr << "UART 포트를 열 수 없습니다." << std::endl;
-        return -1;
+static int baro_port = -1;
+static BaroFrameParser baro_parser;
+static uint8_t rx_buffer[BARO_READ_SIZE];
+static int rx_length = 0;          // rx_buffer에 남은 바이트 수
+static int rx_index = 0;           // 다음에 파서에 넣을 위치
+static uint64_t rx_timestamp = 0;  // rx_buffer를 읽은 시각
+
+bool BaroFrameParser::push(uint8_t byte, BarometerData& out) {
+    // 헤더 동기화
+    if (length < 2) {
+        if (byte == 0x5A) {
+            frame[length++] = byte;
+        } else {
+            length = 0;
+        }
+        return false;
+    }
+
+    // 종류 바이트: 알려진 종류가 아니면 재동기화 (0x5A가 연속이면 헤더로 보고 한 칸 밀기)
+    if (length == 2) {
+        if (byte != BARO_FRAME_TYPE && byte != LIGHT_FRAME_TYPE) {
+            length = (byte == 0x5A) ? 2 : 0;
+            return false;
+        }
+    }
+
+    frame[length++] = byte;
+    if (length < 4) {
+        return false;
+    }
+
+    size_t total = 4 + frame[3] + 1;
+    if (length < total) {
+        return false;
     }
+    length = 0;
 
-    struct termios options;
-    tcgetattr(serial_fd, &options);
-    cfsetispeed(&options, B115200);
-    cfsetospeed(&options, B115200);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
-    tcsetattr(serial_fd, TCSANOW, &options);
+    uint8_t sum = 0;
+    for (size_t i = 0; i + 1 < total; ++i) {
+        sum += frame[i];
+    }
+    if (sum != frame[total - 1]) {
+        ++errors;
+        return false;
+    }
+    if (frame[2] != BARO_FRAME_TYPE || frame[3] < 6) {
+        return false;  // 조도 프레임
+    }
+
+    int16_t temperatureRaw = static_cast<int16_t>((frame[4] << 8) | frame[5]);
+    int32_t pressureRaw = static_cast<int32_t>((static_cast<uint32_t>(frame[6]) << 24) | (frame[7] << 16) | (frame[8] << 8) | frame[9]);
+    out.temperature = temperatureRaw / 100.0f;
+    out.pressure = pressureRaw / 100.0f;
+    ++frames;
+    return true;
+}
+
+// 기압 센서 초기화 함수
+void initBarometer(const std::string& port, int baudRate) {
+    if (blackboxReplaying()) {
+        return;  // 재생 중에는 포트를 열지 않음
+    }
+    if ((baro_port = openSerial(port, baudRate)) == -1) {
+        throw std::runtime_error("Unable to configure barometer port");
+    }
+}
+
+// 기압 데이터 읽기 함수
+// 한 번에 읽은 바이트 중 프레임 뒤에 남은 바이트는 다음 호출에서 이어서 처리
+BarometerData readBarometer() {
+    BarometerData data = {};
 
-    unsigned char buffer[256];
     while (true) {
-        int bytes_read = read(serial_fd, &buffer, sizeof(buffer));
-        if (bytes_read > 0) {
-            std::cout << "Raw data (hex): ";
-            for (int i = 0; i < bytes_read; i++) {
-                // 받은 데이터를 16진수로 출력
-                std::cout << std::hex << static_cast<int>(buffer[i]) << " ";
-            }
-            std::cout << std::endl;
-
-            // 압력 값이 4바이트로 들어온다고 가정하고 이를 처리
-            if (bytes_read >= 4) {
-                // 첫 4바이트를 하나의 압력 값으로 해석 (float 또는 int 형식에 따라)
-                uint32_t pressure_raw = (buffer[0] << 24) | (buffer[1] << 16) | (buffer[2] << 8) | buffer[3];
-                // 이 값을 실제 압력 값으로 변환 (센서에 따라 변환 공식이 다를 수 있음)
-                float pressure = static_cast<float>(pressure_raw) / 100.0; // 예: 압력 값을 헥토파스칼 단위로 변환
-                std::cout << "Pressure = " << pressure << " hPa" << std::endl;
+        while (rx_index < rx_length) {
+            if (baro_parser.push(rx_buffer[rx_index++], data)) {
+                data.timestampNs = rx_timestamp;  // 프레임 마지막 바이트를 읽은 시각
+                return data;
             }
         }
-        usleep(100000);  // 1초 대기
+
+        int bytesRead = blackboxRead(BLACKBOX_BARO, baro_port, rx_buffer, sizeof(rx_buffer), rx_timestamp);
+        if (bytesRead > 0) {
+            rx_length = bytesRead;
+            rx_index = 0;
+        } else {
+            rx_length = 0;
+            rx_index = 0;
+            usleep(2000);  // 수신 데이터 없음 (GY-39 출력 주기 수십 ms 대비 짧게 대기)
+        }
     }
+}
 
-    close(serial_fd);
-    return 0;
+// ISA 대류권 모델: h = 44330.77 * (1 - (p / p0)^0.190263)
+float pressureToAltitude(float pressurePa, float seaLevelPa) {
+    return 44330.77f * (1.0f - std::pow(pressurePa / seaLevelPa, 0.190263f));
 }
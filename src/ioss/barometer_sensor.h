@@ -3,17 +3,43 @@
 
 #include <string>
 #include <signal.h>
+#include <cstddef>
+#include <cstdint>
 
 // 기압 데이터를 저장하는 구조체
 struct BarometerData {
-    float pressure;
-    float temperature;
+    float pressure;        // Pa
+    float temperature;     // °C
+    uint64_t timestampNs;  // 수신 시각 (CLOCK_MONOTONIC, ns)
+};
+
+// GY-39(BME280) UART 프레임 스트림 파서
+// 프레임: 0x5A 0x5A | 종류 | 길이 | 데이터(길이) | 체크섬(앞 바이트 합의 하위 8비트)
+// 종류 0x45 데이터: 온도(int16, 0.01°C) 기압(int32, 0.01Pa) 습도(uint16, 0.01%) 고도(int16, m), 빅엔디언
+class BaroFrameParser {
+public:
+    // 바이트 하나를 넣고 기압 프레임이 완성되면 out에 기록하고 true (timestampNs는 호출자가 채움)
+    bool push(uint8_t byte, BarometerData& out);
+
+    uint32_t frameCount() const { return frames; }
+    uint32_t checksumErrors() const { return errors; }
+
+private:
+    static constexpr size_t MAX_FRAME = 4 + 255 + 1;
+
+    uint8_t frame[MAX_FRAME];
+    size_t length = 0;
+    uint32_t frames = 0;
+    uint32_t errors = 0;
 };
 
 // 기압 센서를 초기화하는 함수
 void initBarometer(const std::string& port, int baudRate);
 
-// 기압 데이터를 읽는 함수
+// 기압 데이터를 읽는 함수 (다음 프레임이 올 때까지 대기)
 BarometerData readBarometer();
 
+// 국제 표준 대기(ISA) 기준 기압 고도 (m)
+float pressureToAltitude(float pressurePa, float seaLevelPa = 101325.0f);
+
 #endif
@@ -1,8 +1,10 @@
 #include "gps_sensor.h"
+#include "../oss/timer.h"
+#include "../oss/blackbox.h"
+#include "../oss/transport.h"
+#include "../oss/perf_counters.h"
 #include <iostream>
 #include <vector>
-#include <fcntl.h>
-#include <termios.h>
 #include <unistd.h>
 
 using namespace std;
@@ -11,27 +13,10 @@ int serialPort = -1;  // 전역 변수로 시리얼 포트 관리
 
 // 시리얼 포트 설정 함수
 void initGPS(const char* port, int baudRate) {
-    serialPort = open(port, O_RDWR | O_NOCTTY | O_NDELAY);
-    if (serialPort == -1) {
-        perror("Unable to open serial port");
-        return;
+    if (blackboxReplaying()) {
+        return;  // 재생 중에는 포트를 열지 않음
     }
-
-    struct termios options;
-    tcgetattr(serialPort, &options);
-    cfsetispeed(&options, baudRate); // Baud rate 설정
-    cfsetospeed(&options, baudRate);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~PARENB; // 패리티 비트 없음
-    options.c_cflag &= ~CSTOPB; // 1 스톱 비트
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8; // 8 비트 데이터 비트
-    options.c_cflag &= ~CRTSCTS; // RTS/CTS 흐름 제어 없음
-    options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG); // 캐노닉 모드 해제
-    options.c_iflag &= ~(IXON | IXOFF | IXANY); // 소프트웨어 흐름 제어 없음
-    options.c_oflag &= ~OPOST; // 원시 모드
-
-    tcsetattr(serialPort, TCSANOW, &options);
+    serialPort = openSerial(port, baudRate);  // 실패하면 -1, 읽기는 계속 빈 값
 }
 
 // GPS 데이터 파싱 함수
@@ -46,6 +31,8 @@ GPSData parseGpsData(const vector<uint8_t>& data) {
     uint16_t length = (data[5] << 8) | data[4]; // Length 필드 (2바이트)
 
     if (msgId == 0x07) {
+        gpsData.iTOW = (data[9] << 24) | (data[8] << 16) | (data[7] << 8) | data[6];
+        gpsData.sensorTimestampNs = static_cast<uint64_t>(gpsData.iTOW) * 1000000ULL;
         gpsData.numSV = data[29];
         gpsData.longitude = (data[33] << 24) | (data[32] << 16) | (data[31] << 8) | data[30];
         gpsData.latitude = (data[37] << 24) | (data[36] << 16) | (data[35] << 8) | data[34];
@@ -65,9 +52,11 @@ GPSData readGPS() {
     uint8_t buffer[1024];
     GPSData gpsData = {};
     bool flag = false;  // 파싱이 성공했는지 확인하는 플래그
+    uint64_t rxTime = 0;
+    static PerfRegion& parseRegion = perfRegion("gps_parse");
 
     while (!flag) {
-        int bytesRead = read(serialPort, buffer, sizeof(buffer));
+        int bytesRead = blackboxRead(BLACKBOX_GPS, serialPort, buffer, sizeof(buffer), rxTime);  // 메시지를 완성시킨 바이트의 수신 시각
         if (bytesRead > 0) {
             receivedData.insert(receivedData.end(), buffer, buffer + bytesRead);
 
@@ -83,6 +72,7 @@ GPSData readGPS() {
                     uint16_t totalMessageLength = length + 6 + 2; // Length + Header + Checksum
 
                     if (receivedData.size() >= totalMessageLength) {
+                        PerfScope parseScope(parseRegion);
                         gpsData = parseGpsData(vector<uint8_t>(receivedData.begin(), receivedData.begin() + totalMessageLength));
                         flag = true;  // 올바른 값이 파싱되면 플래그를 true로 설정
 
@@ -103,5 +93,6 @@ GPSData readGPS() {
     }
 
     // flag가 true일 때 gpsData를 반환
+    gpsData.timestampNs = rxTime;
     return gpsData;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstdint>
+#include <vector>
 
 // GPSData 구조체 정의
 struct GPSData {
@@ -14,6 +15,9 @@ struct GPSData {
     int64_t velocityX;  // NED 북 방향 속도 (mm/s, 더 큰 범위 지원)
     int64_t velocityY;  // NED 동 방향 속도 (mm/s, 더 큰 범위 지원)
     int64_t velocityZ;  // NED 하강 방향 속도 (mm/s, 더 큰 범위 지원)
+    uint32_t iTOW;      // GPS 주간 시각 (ms, 수신기 자체 타임스탬프)
+    uint64_t timestampNs;       // 수신 시각 (CLOCK_MONOTONIC, ns)
+    uint64_t sensorTimestampNs; // 수신기 타임스탬프 (iTOW, ns)
 };
 
 // GPS 초기화 함수
@@ -22,4 +26,7 @@ void initGPS(const char* port, int baudRate);
 // GPS 데이터를 읽는 함수
 GPSData readGPS();
 
+// UBX 메시지 하나(헤더부터 체크섬까지) 파싱, NAV-PVT가 아니거나 짧으면 빈 값
+GPSData parseGpsData(const std::vector<uint8_t>& data);
+
 #endif
\ No newline at end of file
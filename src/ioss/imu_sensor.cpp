@@ -1,11 +1,12 @@
 #include "imu_sensor.h"
+#include "../oss/timer.h"
+#include "../oss/blackbox.h"
+#include "../oss/transport.h"
+#include "../oss/perf_counters.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
-#include <fcntl.h>
-#include <termios.h>
-#include <sys/time.h>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -18,10 +19,10 @@
 
 // 시그널 플래그
 static int serial_port;
-static long previous_timestamp = 0; // 이전 타임스탬프 저장 변수
+static uint64_t previous_timestamp = 0; // 이전 수신 시각 저장 변수 (ns)
 
 // CRC 계산 함수 (데이터 유효성 검증에 사용)
-static unsigned short calculateCRC(const unsigned char* data, unsigned int length) {
+unsigned short calculateIMUCRC(const unsigned char* data, unsigned int length) {
     unsigned short crc = 0;
     for (unsigned int i = 0; i < length; i++) {
         crc = (unsigned char)(crc >> 8) | (crc << 8);
@@ -33,34 +34,13 @@ static unsigned short calculateCRC(const unsigned char* data, unsigned int lengt
     return crc;
 }
 
-// 시리얼 포트 설정 함수
-static int configureSerial(const std::string& port, int baudrate) {
-    serial_port = open(port.c_str(), O_RDWR | O_NOCTTY | O_NDELAY);
-    if (serial_port == -1) {
-        perror("Failed to open serial port");
-        return -1;
-    }
-
-    struct termios options;
-    tcgetattr(serial_port, &options);
-    cfsetispeed(&options, baudrate);
-    cfsetospeed(&options, baudrate);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
-    options.c_iflag &= ~(IXON | IXOFF | IXANY);
-    options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-    options.c_oflag &= ~OPOST;
-    tcsetattr(serial_port, TCSANOW, &options);
-
-    return serial_port;
-}
-
 // IMU 초기화 함수
+// 재생 중에는 포트를 열지 않음 (blackboxRead가 기록을 돌려줌)
 void initIMU(const std::string& port, int baudRate) {
-    if (configureSerial(port, baudRate) == -1) {
+    if (blackboxReplaying()) {
+        return;
+    }
+    if ((serial_port = openSerial(port, baudRate)) == -1) {
         throw std::runtime_error("Unable to configure serial port");
     }
 }
@@ -69,22 +49,105 @@ void initIMU(const std::string& port, int baudRate) {
 void sendIMURequest() {
     char command[COMMAND_SIZE];
     snprintf(command, sizeof(command), "$VNRRG,20");
-    unsigned short crc = calculateCRC((unsigned char *)command + 1, strlen(command) - 1);
+    unsigned short crc = calculateIMUCRC((unsigned char *)command + 1, strlen(command) - 1);
     snprintf(command, sizeof(command), "$VNRRG,20*%04X\r\n", crc);
     write(serial_port, command, strlen(command));
 }
 
+// 시리얼 번호 읽기 함수 (초기화 직후, 측정 요청 전에 호출)
+uint32_t readIMUSerialNumber() {
+    char command[COMMAND_SIZE];
+    snprintf(command, sizeof(command), "$VNRRG,03");
+    unsigned short crc = calculateIMUCRC((unsigned char *)command + 1, strlen(command) - 1);
+    snprintf(command, sizeof(command), "$VNRRG,03*%04X\r\n", crc);
+    write(serial_port, command, strlen(command));
+
+    char buffer[BUFFER_SIZE];
+    int buffer_index = 0;
+    uint64_t deadline = monotonicNs() + 200000000ULL;  // 200ms
+    while (monotonicNs() < deadline) {
+        uint64_t rx_time;
+        int bytes_read = blackboxRead(BLACKBOX_IMU, serial_port, buffer + buffer_index, sizeof(buffer) - buffer_index - 1, rx_time);
+        if (bytes_read <= 0) {
+            usleep(1000);
+            continue;
+        }
+        buffer_index += bytes_read;
+        buffer[buffer_index] = '\0';
+
+        // 응답 형식: $VNRRG,03,<시리얼>*XXXX
+        char* start = strstr(buffer, "$VNRRG,03,");
+        if (start && strchr(start, '*')) {
+            return static_cast<uint32_t>(strtoul(start + 10, nullptr, 10));
+        }
+        if (buffer_index >= BUFFER_SIZE - 1) {
+            buffer_index = 0;
+        }
+    }
+    fprintf(stderr, "IMU serial number not received\n");
+    return 0;
+}
+
 // IMU 데이터 읽기 및 처리 함수
+// $VNRRG,20 응답 한 줄 파싱 ('\n' 없이 NUL로 끝나는 줄, '*' 자리를 NUL로 바꿈)
+// 자기장/가속도/자이로를 채우면 true, 다른 응답이거나 CRC/형식이 틀리면 false (시각 필드는 건드리지 않음)
+bool parseIMULine(char* line, IMUData& imuData) {
+    static PerfRegion& parseRegion = perfRegion("imu_parse");
+    if (strncmp(line, "$VNRRG", 6) != 0) {
+        return false;
+    }
+    PerfScope parseScope(parseRegion);
+    char* end_of_data = strchr(line, '*');
+    if (!end_of_data) {
+        return false;
+    }
+    *end_of_data = '\0';
+
+    std::vector<std::string> parts;
+    std::istringstream ss(line);
+    std::string token;
+
+    while (std::getline(ss, token, ',')) {
+        parts.push_back(token);
+    }
+
+    if (parts.size() < 11) {  // 자기장 데이터 포함
+        fprintf(stderr, "Invalid data format\n");
+        return false;
+    }
+    unsigned short received_crc = std::stoi(end_of_data + 1, nullptr, 16);
+    unsigned short calculated_crc = calculateIMUCRC((unsigned char *)line + 1, strlen(line) - 1);
+    if (received_crc != calculated_crc) {
+        fprintf(stderr, "CRC mismatch: Received: %04X, Calculated: %04X\n", received_crc, calculated_crc);
+        return false;
+    }
+    imuData.accelX = std::stof(parts[5]);
+    imuData.accelY = std::stof(parts[6]);
+    imuData.accelZ = std::stof(parts[7]);
+    imuData.gyroX = std::stof(parts[8]);
+    imuData.gyroY = std::stof(parts[9]);
+    imuData.gyroZ = std::stof(parts[10]);
+    imuData.magX = std::stof(parts[2]);
+    imuData.magY = std::stof(parts[3]);
+    imuData.magZ = std::stof(parts[4]);
+    return true;
+}
+
 IMUData readIMU() {
     char buffer[BUFFER_SIZE];  // IMU 데이터 저장 버퍼 (128로 설정)
     int buffer_index = 0;
     IMUData imuData = {};
 
+    bool replaying = blackboxReplaying();
     while (true) {
-        sendIMURequest();
-        usleep(1000);  // 요청 간격 설정
+        if (!replaying) {
+            sendIMURequest();
+            usleep(1000);  // 요청 간격 설정
+        }
 
-        int bytes_read = read(serial_port, buffer + buffer_index, sizeof(buffer) - buffer_index - 1);
+        // 바이트가 도착한 시점을 샘플 수신 시각으로 사용 (파싱 시간 제외, 블랙박스 기록과 같은 값)
+        uint64_t rx_time;
+        int bytes_read = blackboxRead(BLACKBOX_IMU, serial_port, buffer + buffer_index, sizeof(buffer) - buffer_index - 1, rx_time);
         if (bytes_read > 0) {
             buffer_index += bytes_read;
             buffer[buffer_index] = '\0';
@@ -95,48 +158,13 @@ IMUData readIMU() {
             while ((line_end = strchr(line_start, '\n')) != NULL) {
                 *line_end = '\0';
 
-                if (strncmp(line_start, "$VNRRG", 6) == 0) {
-                    char* end_of_data = strchr(line_start, '*');
-                    if (end_of_data) {
-                        *end_of_data = '\0';
-
-                        std::vector<std::string> parts;
-                        std::istringstream ss(line_start);
-                        std::string token;
-
-                        while (std::getline(ss, token, ',')) {
-                            parts.push_back(token);
-                        }
-
-                        if (parts.size() >= 11) {  // 자기장 데이터 포함
-                            unsigned short received_crc = std::stoi(end_of_data + 1, nullptr, 16);
-                            unsigned short calculated_crc = calculateCRC((unsigned char *)line_start + 1, strlen(line_start) - 1);
-
-                            if (received_crc == calculated_crc) {
-                                imuData.accelX = std::stof(parts[5]);
-                                imuData.accelY = std::stof(parts[6]);
-                                imuData.accelZ = std::stof(parts[7]);
-                                imuData.gyroX = std::stof(parts[8]);
-                                imuData.gyroY = std::stof(parts[9]);
-                                imuData.gyroZ = std::stof(parts[10]);
-                                imuData.magX = std::stof(parts[2]);
-                                imuData.magY = std::stof(parts[3]);
-                                imuData.magZ = std::stof(parts[4]);
-
-                                struct timeval current_time;
-                                gettimeofday(&current_time, NULL);
-                                imuData.timestamp = (current_time.tv_sec * 1000.0) + (current_time.tv_usec / 1000.0);
-                                imuData.elapsed_time = imuData.timestamp - previous_timestamp;
-                                previous_timestamp = imuData.timestamp;
-
-                                return imuData;
-                            } else {
-                                fprintf(stderr, "CRC mismatch: Received: %04X, Calculated: %04X\n", received_crc, calculated_crc);
-                            }
-                        } else {
-                            fprintf(stderr, "Invalid data format\n");
-                        }
-                    }
+                if (parseIMULine(line_start, imuData)) {
+                    // $VNRRG,20 응답에는 센서 시간이 없으므로 sensorTimestampNs는 0
+                    imuData.timestampNs = rx_time;
+                    imuData.sensorTimestampNs = 0;
+                    imuData.elapsedNs = previous_timestamp ? rx_time - previous_timestamp : 0;
+                    previous_timestamp = rx_time;
+                    return imuData;
                 }
 
                 // 다음 줄로 이동
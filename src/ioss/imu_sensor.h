@@ -3,6 +3,7 @@
 
 #include <string>   
 #include <signal.h> 
+#include <cstdint>
 
 // IMU 데이터를 저장하는 구조체
 struct IMUData {
@@ -15,11 +16,19 @@ struct IMUData {
     float magX;      // X축 자기장
     float magY;      // Y축 자기장
     float magZ;      // Z축 자기장
-    double timestamp;    // 타임스탬프
-    double elapsed_time; // 경과 시간
+    uint64_t timestampNs;       // 수신 시각 (CLOCK_MONOTONIC, ns)
+    uint64_t sensorTimestampNs; // 센서 자체 타임스탬프 (ns, 제공되지 않으면 0)
+    uint64_t elapsedNs;         // 이전 샘플과의 수신 간격 (ns)
 };
 
 void initIMU(const std::string& port, int baudRate);
 IMUData readIMU();
+// 센서 시리얼 번호 (VN-100 레지스터 3), 응답이 없으면 0. 캘리브레이션 저장소 키로 사용
+uint32_t readIMUSerialNumber();
+
+// VN-100 메시지 CRC16 ('$'와 '*' 사이)
+unsigned short calculateIMUCRC(const unsigned char* data, unsigned int length);
+// $VNRRG,20 응답 한 줄 파싱 ('*' 자리를 NUL로 바꿈), 자기장/가속도/자이로를 채우면 true (시각 필드는 그대로)
+bool parseIMULine(char* line, IMUData& imuData);
 
 #endif
\ No newline at end of file
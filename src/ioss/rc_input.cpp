@@ -1,6 +1,9 @@
 #include "rc_input.h"
-#include <fcntl.h>
-#include <termios.h>
+#include "../oss/timer.h"
+#include "../oss/blackbox.h"
+#include "../oss/transport.h"
+#include "../oss/trace.h"
+#include "../oss/perf_counters.h"
 #include <unistd.h>
 #include <iostream>
 #include <cstdint>
@@ -9,45 +12,24 @@
 #include <chrono>
 #include <deque>
 #include <thread>
-#include <vector>
+#include <algorithm>
 
-#define SBUS_FRAME_SIZE 35
 #define START_BYTE 0x0F
 
 static int serial_port;
-static uint16_t channels[16];           // 16채널 값을 저장할 배열
+static uint16_t channels[SBUS_CHANNELS];           // 16채널 값을 저장할 배열
 static std::deque<uint8_t> data_buffer; // 최신 데이터를 저장할 버퍼
-
-// 시리얼 포트 설정 함수
-static int configureSerial(const std::string& port, int baudrate) {
-    serial_port = open(port.c_str(), O_RDWR | O_NOCTTY | O_NDELAY);
-    if (serial_port == -1) {
-        perror("Failed to open serial port");
-        return -1;
-    }
-
-    struct termios options;
-    tcgetattr(serial_port, &options);
-    cfsetispeed(&options, baudrate);
-    cfsetospeed(&options, baudrate);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
-    options.c_iflag &= ~(IXON | IXOFF | IXANY);
-    options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-    options.c_oflag &= ~OPOST;
-    tcsetattr(serial_port, TCSANOW, &options);
-
-    return serial_port;
-}
+static uint64_t last_rx_ns = 0;         // 마지막 바이트 수신 시각
+static uint64_t frame_timestamp_ns = 0; // 마지막 유효 프레임 수신 시각
 
 // RC 입력 초기화 함수
 void initRC(const std::string& port, int baudRate) {
+    if (blackboxReplaying()) {
+        return;  // 재생 중에는 포트를 열지 않음
+    }
     // 올바르게 초기화되지 않았을 경우 반복적으로 시도
     while (true) {
-        if (configureSerial(port, baudRate) == -1) {
+        if ((serial_port = openSerial(port, baudRate)) == -1) {
             std::cerr << "Failed to initialize RC input. Retrying..." << std::endl;
             std::this_thread::sleep_for(std::chrono::seconds(1)); // 1초 대기 후 재시도
             continue;
@@ -56,6 +38,26 @@ void initRC(const std::string& port, int baudRate) {
     }
 }
 
+// 시작 바이트와 XOR 체크섬을 확인하고 유효하면 채널 값 갱신
+bool parseSbusFrame(const uint8_t* frame, uint16_t* channelsOut) {
+    if (frame[0] != START_BYTE) {
+        return false;
+    }
+
+    uint8_t xor_checksum = 0;
+    for (int i = 1; i < SBUS_FRAME_SIZE - 1; ++i) {
+        xor_checksum ^= frame[i];
+    }
+    if (xor_checksum != frame[SBUS_FRAME_SIZE - 1]) {
+        return false;
+    }
+
+    for (int i = 0; i < SBUS_CHANNELS; ++i) {
+        channelsOut[i] = (frame[1 + i * 2] << 8) | frame[2 + i * 2];
+    }
+    return true;
+}
+
 // 최신 RC 채널 값을 읽고 업데이트하는 함수
 int readRCChannel(int channel) {
     if (channel < 1 || channel > 16) {
@@ -63,43 +65,32 @@ int readRCChannel(int channel) {
         return -1;
     }
 
-    // 시리얼 포트에서 데이터 읽어 버퍼에 추가
-    uint8_t byte;
-    while (read(serial_port, &byte, 1) > 0) {
-        data_buffer.push_back(byte);
+    // 시리얼 포트에서 도착한 만큼 읽어 버퍼에 추가 (블랙박스 기록 단위도 이 덩어리)
+    uint8_t bytes[SBUS_FRAME_SIZE * 2];
+    int bytes_read;
+    while ((bytes_read = blackboxRead(BLACKBOX_RC, serial_port, bytes, sizeof(bytes), last_rx_ns)) > 0) {
+        data_buffer.insert(data_buffer.end(), bytes, bytes + bytes_read);
 
         // 오래된 데이터를 삭제하여 버퍼 크기를 제한
-        if (data_buffer.size() > SBUS_FRAME_SIZE * 10) {
+        while (data_buffer.size() > SBUS_FRAME_SIZE * 10) {
             data_buffer.pop_front();
         }
     }
 
     // 버퍼에서 최신 프레임을 찾아 데이터 갱신
+    static PerfRegion& parseRegion = perfRegion("sbus_parse");
+    PerfScope parseScope(parseRegion);
     while (data_buffer.size() >= SBUS_FRAME_SIZE) {
         // 버퍼에서 프레임 추출
-        std::vector<uint8_t> frame(data_buffer.begin(), data_buffer.begin() + SBUS_FRAME_SIZE);
+        uint8_t frame[SBUS_FRAME_SIZE];
+        std::copy(data_buffer.begin(), data_buffer.begin() + SBUS_FRAME_SIZE, frame);
 
-        // 시작 바이트 확인
-        if (frame[0] != START_BYTE) {
-            data_buffer.pop_front();
-            continue;
-        }
-
-        // 체크섬 검증
-        uint8_t xor_checksum = 0;
-        for (int i = 1; i < SBUS_FRAME_SIZE - 1; ++i) {
-            xor_checksum ^= frame[i];
-        }
-
-        if (xor_checksum != frame[SBUS_FRAME_SIZE - 1]) {
+        if (!parseSbusFrame(frame, channels)) {
             data_buffer.pop_front(); // 잘못된 프레임을 버림
             continue;
         }
-
-        // 유효한 프레임이면 채널 데이터 업데이트
-        for (int i = 0; i < 16; ++i) {
-            channels[i] = (frame[1 + i * 2] << 8) | frame[2 + i * 2];
-        }
+        frame_timestamp_ns = last_rx_ns;
+        trace(TRACE_PARSE, frame_timestamp_ns, BLACKBOX_RC);
 
         // 프레임을 버퍼에서 제거
         data_buffer.erase(data_buffer.begin(), data_buffer.begin() + SBUS_FRAME_SIZE);
@@ -108,4 +99,9 @@ int readRCChannel(int channel) {
 
     // 요청된 채널 값을 반환
     return channels[channel - 1];
-}
\ No newline at end of file
+}
+
+// 마지막 유효 프레임의 수신 시각 반환
+uint64_t getRCTimestampNs() {
+    return frame_timestamp_ns;
+}
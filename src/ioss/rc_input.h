@@ -2,6 +2,7 @@
 #define RC_INPUT_H
 
 #include <string>
+#include <cstdint>
 
 // RC 입력 초기화 함수
 void initRC(const std::string& port, int baudRate);
@@ -9,4 +10,13 @@ void initRC(const std::string& port, int baudRate);
 // RC 데이터를 읽는 함수
 int readRCChannel(int channel);
 
+#define SBUS_FRAME_SIZE 35
+#define SBUS_CHANNELS 16
+
+// 프레임 하나(SBUS_FRAME_SIZE 바이트)를 검사하여 유효하면 채널 값(SBUS_CHANNELS개)을 쓰고 true
+bool parseSbusFrame(const uint8_t* frame, uint16_t* channels);
+
+// 마지막으로 유효한 SBUS 프레임의 수신 시각 (CLOCK_MONOTONIC, ns)
+uint64_t getRCTimestampNs();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "binary_logger.h"
+#include "timer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+namespace {
+
+const size_t RING_CAPACITY = 4096;          // 스레드당 256KB, 400Hz 기록 기준 약 10초
+const size_t MAX_THREADS = 32;
+const size_t CHUNK_RECORDS = 1024;          // 청크당 최대 레코드 수 (64KB)
+const size_t INDEX_CHUNKS = 64;             // 색인 블록 하나가 가리키는 청크 수
+const uint64_t CHUNK_FLUSH_NS = 500000000ULL;  // 덜 찬 청크도 이 시간마다 씀 (비정상 종료 시 잃는 구간)
+const int WRITER_NICE = 10;                 // 제어/센서 스레드보다 낮은 우선순위
+const auto WRITER_IDLE = std::chrono::milliseconds(10);
+
+// 단일 생산자(기록 스레드) / 단일 소비자(쓰기 스레드) 링
+// head/tail은 단조 증가 카운터, 위치는 & MASK
+struct LogRing {
+    static constexpr size_t MASK = RING_CAPACITY - 1;
+
+    alignas(64) std::atomic<uint64_t> head{0};   // 소비자가 갱신
+    alignas(64) std::atomic<uint64_t> tail{0};   // 생산자가 갱신
+    uint64_t cachedHead = 0;                      // 생산자 전용 (가득 찼을 때만 head를 다시 읽음)
+    uint32_t sequence = 0;
+    std::atomic<uint64_t> dropped{0};
+    alignas(64) LogRecord records[RING_CAPACITY];
+};
+static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "Ring capacity must be a power of two");
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<LogRing>> allRings;  // 정지 후에도 해제하지 않음 (기록 중이던 스레드 보호)
+std::array<LogRing*, MAX_THREADS> rings{};
+std::atomic<size_t> ringCount{0};
+std::atomic<uint32_t> generation{0};           // 시작할 때마다 증가, 스레드는 새 링을 등록
+std::atomic<bool> active{false};
+
+std::thread writerThread;
+std::atomic<bool> writerRunning{false};
+int logFd = -1;
+std::atomic<uint64_t> writtenRecords{0};
+std::atomic<uint64_t> writtenBytes{0};
+
+// 종류별로 모으는 청크 (쓰기 스레드 전용), records[0]은 청크 머리 자리
+struct ChunkBuffer {
+    uint16_t type;
+    size_t count = 0;
+    uint64_t minNs = 0;
+    uint64_t maxNs = 0;
+    std::vector<LogRecord> records;
+};
+
+std::vector<ChunkBuffer> chunkBuffers;
+std::vector<LogIndexEntry> pendingIndex;    // 아직 색인 블록에 쓰지 않은 청크
+uint64_t fileOffset = 0;
+uint64_t lastIndexOffset = 0;
+
+thread_local LogRing* localRing = nullptr;
+thread_local uint32_t localGeneration = 0;
+thread_local uint8_t localThread = 0;
+
+LogRing* registerThread() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t n = ringCount.load(std::memory_order_relaxed);
+    if (n >= MAX_THREADS) {
+        return nullptr;
+    }
+    allRings.emplace_back(new LogRing());
+    rings[n] = allRings.back().get();
+    ringCount.store(n + 1, std::memory_order_release);
+    localThread = static_cast<uint8_t>(n);
+    return rings[n];
+}
+
+bool writeAll(const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = ::write(logFd, p, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Failed to write log");
+            return false;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// 파일 끝에 쓰고 위치 갱신
+bool writeBlock(const void* data, size_t size) {
+    if (!writeAll(data, size)) {
+        return false;
+    }
+    fileOffset += size;
+    writtenBytes.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+// 구조 레코드 (청크 머리/색인/꼬리)
+template <typename T>
+void fillStructureRecord(LogRecord& record, uint16_t type, uint64_t timeNs, const T& info) {
+    static_assert(sizeof(T) <= LogRecord::PAYLOAD_SIZE, "Structure payload too large");
+    std::memset(&record, 0, sizeof(record));
+    record.timestampNs = timeNs;
+    record.type = type;
+    record.size = static_cast<uint8_t>(sizeof(T));
+    std::memcpy(record.payload, &info, sizeof(T));
+}
+
+void writeIndex() {
+    if (pendingIndex.empty()) {
+        return;
+    }
+    size_t slots = (pendingIndex.size() + 1) / 2;
+    std::vector<LogRecord> block(1 + slots);
+    std::memset(block.data() + 1, 0, slots * sizeof(LogRecord));
+    LogIndexInfo info = {lastIndexOffset, static_cast<uint32_t>(pendingIndex.size())};
+    fillStructureRecord(block[0], LOG_TYPE_INDEX, monotonicNs(), info);
+    std::memcpy(block.data() + 1, pendingIndex.data(), pendingIndex.size() * sizeof(LogIndexEntry));
+
+    uint64_t offset = fileOffset;
+    if (writeBlock(block.data(), block.size() * sizeof(LogRecord))) {
+        lastIndexOffset = offset;
+    }
+    pendingIndex.clear();
+}
+
+void writeChunk(ChunkBuffer& buffer) {
+    LogChunkInfo info = {buffer.minNs, buffer.maxNs, static_cast<uint32_t>(buffer.count), buffer.type};
+    fillStructureRecord(buffer.records[0], LOG_TYPE_CHUNK, buffer.minNs, info);
+
+    uint64_t offset = fileOffset;
+    if (writeBlock(buffer.records.data(), (buffer.count + 1) * sizeof(LogRecord))) {
+        writtenRecords.fetch_add(buffer.count, std::memory_order_relaxed);
+        pendingIndex.push_back(LogIndexEntry{offset, buffer.minNs, buffer.maxNs, info.count, buffer.type, 0});
+    }
+    buffer.count = 0;
+    if (pendingIndex.size() >= INDEX_CHUNKS) {
+        writeIndex();
+    }
+}
+
+void flushChunks() {
+    for (ChunkBuffer& buffer : chunkBuffers) {
+        if (buffer.count > 0) {
+            writeChunk(buffer);
+        }
+    }
+}
+
+// 종류 수는 많지 않으므로 선형 검색
+ChunkBuffer& chunkFor(uint16_t type) {
+    for (ChunkBuffer& buffer : chunkBuffers) {
+        if (buffer.type == type) {
+            return buffer;
+        }
+    }
+    chunkBuffers.emplace_back();
+    chunkBuffers.back().type = type;
+    chunkBuffers.back().records.resize(CHUNK_RECORDS + 1);
+    return chunkBuffers.back();
+}
+
+// 모든 링에서 가능한 만큼 꺼내 종류별 청크에 모음 (가득 찬 청크는 바로 씀), 꺼낸 레코드 수 반환
+size_t drainRings() {
+    size_t total = 0;
+    size_t count = ringCount.load(std::memory_order_acquire);
+    for (size_t r = 0; r < count; ++r) {
+        LogRing* ring = rings[r];
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        uint64_t tail = ring->tail.load(std::memory_order_acquire);
+        total += tail - head;
+        for (; head < tail; ++head) {
+            const LogRecord& record = ring->records[head & LogRing::MASK];
+            ChunkBuffer& buffer = chunkFor(record.type);
+            if (buffer.count == 0) {
+                buffer.minNs = buffer.maxNs = record.timestampNs;
+            }
+            buffer.minNs = std::min(buffer.minNs, record.timestampNs);
+            buffer.maxNs = std::max(buffer.maxNs, record.timestampNs);
+            buffer.records[1 + buffer.count++] = record;
+            if (buffer.count == CHUNK_RECORDS) {
+                ring->head.store(head + 1, std::memory_order_release);  // 파일 쓰기 전에 자리를 돌려줌
+                writeChunk(buffer);
+            }
+        }
+        ring->head.store(head, std::memory_order_release);
+    }
+    return total;
+}
+
+void writerLoop() {
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), WRITER_NICE);
+    uint64_t lastFlushNs = monotonicNs();
+    while (writerRunning.load(std::memory_order_relaxed)) {
+        size_t drained = drainRings();
+        uint64_t now = monotonicNs();
+        if (now - lastFlushNs >= CHUNK_FLUSH_NS) {
+            flushChunks();
+            lastFlushNs = now;
+        }
+        if (drained == 0) {
+            std::this_thread::sleep_for(WRITER_IDLE);
+        }
+    }
+    // 정지 시 남은 레코드, 마지막 색인과 꼬리
+    drainRings();
+    flushChunks();
+    writeIndex();
+    LogRecord footer;
+    LogFooterInfo info = {lastIndexOffset, writtenRecords.load(std::memory_order_relaxed)};
+    fillStructureRecord(footer, LOG_TYPE_FOOTER, monotonicNs(), info);
+    writeBlock(&footer, sizeof(footer));
+}
+
+// 스키마 텍스트 (recordSize 배수로 0 채움)
+std::string schemaText(const LogSchema* schemas, size_t schemaCount) {
+    std::string text;
+    char buffer[160];
+    for (size_t i = 0; i < schemaCount; ++i) {
+        const LogSchema& schema = schemas[i];
+        snprintf(buffer, sizeof(buffer), "%u %s %u", schema.type, schema.name, schema.size);
+        text += buffer;
+        for (uint32_t f = 0; f < schema.fieldCount; ++f) {
+            const LogField& field = schema.fields[f];
+            if (field.count > 1) {
+                snprintf(buffer, sizeof(buffer), " %s:%s[%u]@%u", field.name, logFieldTypeName(field.type), field.count, field.offset);
+            } else {
+                snprintf(buffer, sizeof(buffer), " %s:%s@%u", field.name, logFieldTypeName(field.type), field.offset);
+            }
+            text += buffer;
+        }
+        text += '\n';
+    }
+    text.resize((text.size() + sizeof(LogRecord) - 1) / sizeof(LogRecord) * sizeof(LogRecord), '\0');
+    return text;
+}
+
+}  // namespace
+
+const char* logFieldTypeName(LogFieldType type) {
+    static const char* const NAMES[] = {"u8", "i8", "u16", "i16", "u32", "i32", "u64", "i64", "f32", "f64", "char"};
+    return type <= LOG_CHAR ? NAMES[type] : "?";
+}
+
+size_t logFieldTypeSize(LogFieldType type) {
+    static const size_t SIZES[] = {1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 1};
+    return type <= LOG_CHAR ? SIZES[type] : 0;
+}
+
+bool startLogger(const char* path, const LogSchema* schemas, size_t schemaCount) {
+    if (writerRunning) {
+        return true;
+    }
+    logFd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (logFd < 0) {
+        perror("Failed to open log file");
+        return false;
+    }
+
+    std::string schema = schemaText(schemas, schemaCount);
+    LogFileHeader header = {{'F', 'L', 'O', 'G'}, 2, sizeof(LogRecord), static_cast<uint32_t>(schema.size()), monotonicNs()};
+    if (!writeAll(&header, sizeof(header)) || !writeAll(schema.data(), schema.size())) {
+        ::close(logFd);
+        logFd = -1;
+        return false;
+    }
+    writtenRecords = 0;
+    writtenBytes = sizeof(header) + schema.size();
+    fileOffset = writtenBytes;
+    lastIndexOffset = 0;
+    chunkBuffers.clear();
+    pendingIndex.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        ringCount.store(0, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_relaxed);
+    }
+    writerRunning = true;
+    writerThread = std::thread(writerLoop);
+    active.store(true, std::memory_order_release);
+    return true;
+}
+
+void stopLogger() {
+    if (!writerRunning) {
+        return;
+    }
+    active.store(false, std::memory_order_release);
+    writerRunning = false;
+    writerThread.join();
+    fsync(logFd);
+    ::close(logFd);
+    logFd = -1;
+}
+
+bool loggerRunning() {
+    return active.load(std::memory_order_relaxed);
+}
+
+LoggerStats loggerStats() {
+    LoggerStats stats;
+    stats.records = writtenRecords.load(std::memory_order_relaxed);
+    stats.bytes = writtenBytes.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(registryMutex);  // 정지 후에도 다음 시작 전까지 마지막 실행의 링이 남아 있음
+    size_t count = ringCount.load(std::memory_order_relaxed);
+    for (size_t r = 0; r < count; ++r) {
+        stats.dropped += rings[r]->dropped.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+bool logWrite(uint16_t type, const void* payload, size_t size) {
+    if (!active.load(std::memory_order_acquire) || size > LogRecord::PAYLOAD_SIZE || type >= LOG_TYPE_RESERVED) {
+        return false;
+    }
+    uint32_t current = generation.load(std::memory_order_relaxed);
+    if (localGeneration != current) {
+        localRing = registerThread();
+        localGeneration = current;
+    }
+    LogRing* ring = localRing;
+    if (ring == nullptr) {
+        return false;  // 등록 가능한 스레드 수 초과
+    }
+
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->cachedHead >= RING_CAPACITY) {
+        ring->cachedHead = ring->head.load(std::memory_order_acquire);
+        if (tail - ring->cachedHead >= RING_CAPACITY) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            ++ring->sequence;
+            return false;
+        }
+    }
+
+    LogRecord& record = ring->records[tail & LogRing::MASK];
+    record.timestampNs = monotonicNs();
+    record.sequence = ring->sequence++;
+    record.type = type;
+    record.thread = localThread;
+    record.size = static_cast<uint8_t>(size);
+    std::memcpy(record.payload, payload, size);
+    std::memset(record.payload + size, 0, LogRecord::PAYLOAD_SIZE - size);
+    ring->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
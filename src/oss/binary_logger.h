@@ -0,0 +1,126 @@
+// 비동기 바이너리 로거
+// 기록하는 스레드마다 고정 크기 레코드 링(SPSC, lock-free)을 하나씩 두고
+// 우선순위를 낮춘 쓰기 스레드가 모든 링을 모아 큰 단위로 파일에 씀
+// 기록 쪽은 복사 한 번과 원자적 저장 한 번뿐이며, 링이 가득 차면 기다리지 않고 버림 (버린 수는 통계로 확인)
+//
+// 파일 (version 2): LogFileHeader | 스키마 텍스트 (64바이트 단위로 0 채움) | 청크/색인 블록 ... | 꼬리
+//   청크: LOG_TYPE_CHUNK 레코드(LogChunkInfo) 뒤에 같은 종류의 LogRecord count개 → 한 종류만 읽을 때 다른 청크는 건너뜀
+//   색인 블록: LOG_TYPE_INDEX 레코드(LogIndexInfo) 뒤에 직전 청크들의 LogIndexEntry (64바이트에 2개씩)
+//   꼬리: LOG_TYPE_FOOTER 레코드(LogFooterInfo), 정상 종료 시에만 있음 (없으면 청크 머리를 따라가며 복구)
+//   스키마 텍스트: 종류마다 한 줄 "<type> <이름> <크기> <필드>:<형식>[개수]@<오프셋> ..."
+#ifndef BINARY_LOGGER_H
+#define BINARY_LOGGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// 파일 레코드 (64바이트, 캐시 라인 하나)
+struct LogRecord {
+    static constexpr size_t PAYLOAD_SIZE = 48;
+
+    uint64_t timestampNs;   // monotonicNs() 기준 기록 시각
+    uint32_t sequence;      // 스레드별 일련번호 (버려진 구간 확인용)
+    uint16_t type;          // 레코드 종류 (log_records.h)
+    uint8_t thread;         // 링 번호 (등록 순서)
+    uint8_t size;           // payload 유효 길이
+    uint8_t payload[PAYLOAD_SIZE];
+};
+static_assert(sizeof(LogRecord) == 64, "LogRecord must be one cache line");
+
+// 파일 헤더, 뒤에 스키마와 청크가 이어짐 (청크 사이 시각 순서는 섞일 수 있으므로 읽을 때 시각으로 정렬)
+struct LogFileHeader {
+    char magic[4];          // "FLOG"
+    uint32_t version;       // 2
+    uint32_t recordSize;
+    uint32_t schemaSize;    // 스키마 텍스트 영역 크기 (recordSize의 배수)
+    uint64_t startNs;       // 로거 시작 시각 (monotonicNs)
+};
+
+// 파일 구조용 예약 종류 (기록 종류는 LOG_TYPE_RESERVED 미만)
+const uint16_t LOG_TYPE_RESERVED = 0xFF00;
+const uint16_t LOG_TYPE_CHUNK = 0xFFF0;
+const uint16_t LOG_TYPE_INDEX = 0xFFF1;
+const uint16_t LOG_TYPE_FOOTER = 0xFFF2;
+
+struct LogChunkInfo {
+    uint64_t minNs;         // 청크 안 레코드 시각 범위
+    uint64_t maxNs;
+    uint32_t count;
+    uint16_t recordType;
+};
+
+// 색인 항목 하나 = 청크 하나
+struct LogIndexEntry {
+    uint64_t offset;        // 청크 머리 레코드의 파일 위치
+    uint64_t minNs;
+    uint64_t maxNs;
+    uint32_t count;
+    uint16_t recordType;
+    uint16_t reserved;
+};
+static_assert(sizeof(LogIndexEntry) * 2 == sizeof(LogRecord), "Two index entries per record slot");
+
+struct LogIndexInfo {
+    uint64_t previousOffset;    // 이전 색인 블록 위치 (첫 블록은 0)
+    uint32_t entries;
+};
+
+struct LogFooterInfo {
+    uint64_t lastIndexOffset;
+    uint64_t records;           // 기록 레코드 총수
+};
+
+// 기록 종류 스키마 (log_records.h에서 정의하고 startLogger에 전달, 파일에 텍스트로 포함)
+enum LogFieldType : uint8_t {
+    LOG_U8, LOG_I8, LOG_U16, LOG_I16, LOG_U32, LOG_I32, LOG_U64, LOG_I64, LOG_F32, LOG_F64,
+    LOG_CHAR,               // 고정 길이 문자열 (count 바이트, NUL로 끝나거나 꽉 참), 변환 시 한 열
+};
+
+struct LogField {
+    const char* name;
+    LogFieldType type;
+    uint32_t count;         // 배열 길이 (스칼라는 1)
+    uint32_t offset;        // payload 안 위치
+};
+
+struct LogSchema {
+    uint16_t type;
+    const char* name;
+    uint32_t size;
+    const LogField* fields;
+    uint32_t fieldCount;
+};
+
+template <size_t N>
+constexpr LogSchema makeLogSchema(uint16_t type, const char* name, size_t size, const LogField (&fields)[N]) {
+    return LogSchema{type, name, static_cast<uint32_t>(size), fields, static_cast<uint32_t>(N)};
+}
+
+const char* logFieldTypeName(LogFieldType type);
+size_t logFieldTypeSize(LogFieldType type);
+
+struct LoggerStats {
+    uint64_t records = 0;   // 파일에 쓴 레코드 수
+    uint64_t dropped = 0;   // 링이 가득 차서 버린 레코드 수
+    uint64_t bytes = 0;     // 헤더 포함 파일에 쓴 바이트
+};
+
+// 로그 파일을 만들고 쓰기 스레드 시작, 실패 시 false
+// schemas: 기록할 종류의 설명 (없어도 기록은 되지만 변환 도구가 필드를 알 수 없음)
+bool startLogger(const char* path, const LogSchema* schemas = nullptr, size_t schemaCount = 0);
+// 남은 레코드를 모두 쓰고 파일을 닫음
+void stopLogger();
+bool loggerRunning();
+LoggerStats loggerStats();
+
+// 현재 스레드의 링에 레코드 추가 (첫 호출 시 링 등록), 로거가 꺼져 있거나 링이 가득 차면 false
+bool logWrite(uint16_t type, const void* payload, size_t size);
+
+template <typename T>
+inline bool logWrite(uint16_t type, const T& payload) {
+    static_assert(sizeof(T) <= LogRecord::PAYLOAD_SIZE, "Log payload too large");
+    return logWrite(type, &payload, sizeof(T));
+}
+
+#endif
@@ -0,0 +1,548 @@
+#include "blackbox.h"
+#include "timer.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+namespace {
+
+const size_t RING_SIZE = 256 * 1024;         // 장치당, IMU 최대 선로 속도(921600bps)에서 약 2.5초
+const size_t MAX_CHUNK = RING_SIZE / 4;
+const size_t WRITE_THRESHOLD = 64 * 1024;    // 이만큼 쌓이거나
+const uint64_t WRITE_INTERVAL_NS = 200000000ULL;  // 이 시간이 지나면 씀 (작은 write 호출 줄이기)
+const auto WRITER_IDLE = std::chrono::milliseconds(20);
+const int WRITER_NICE = 10;
+
+struct ByteRing {
+    alignas(64) std::atomic<uint64_t> head{0};   // 쓰기 스레드가 갱신
+    alignas(64) std::atomic<uint64_t> tail{0};   // 장치 스레드가 갱신
+    // 장치 스레드 전용
+    uint64_t cachedHead = 0;
+    uint64_t lastTimeNs = 0;
+    uint32_t generation = 0;
+    bool gap = false;
+    std::atomic<uint64_t> chunks{0};
+    std::atomic<uint64_t> rawBytes{0};
+    std::atomic<uint64_t> dropped{0};
+    alignas(64) uint8_t bytes[RING_SIZE];
+
+    void copyIn(uint64_t position, const void* src, size_t size) {
+        size_t start = position % RING_SIZE;
+        size_t first = std::min(size, RING_SIZE - start);
+        std::memcpy(bytes + start, src, first);
+        std::memcpy(bytes, static_cast<const uint8_t*>(src) + first, size - first);
+    }
+};
+
+ByteRing rings[BLACKBOX_DEVICES];
+std::atomic<bool> active{false};
+std::atomic<uint32_t> generation{0};
+std::atomic<bool> writerRunning{false};
+std::thread writerThread;
+int blackboxFd = -1;
+std::atomic<uint64_t> fileBytes{0};
+std::atomic<uint64_t> writerCpuNs{0};
+
+size_t putVarint(uint8_t* out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+// 항목 머리: [장치 | 버림 표시] [varint 길이] [varint 시각 차]
+const size_t MAX_ENTRY_HEADER = 1 + 10 + 10;
+
+size_t encodeEntryHeader(uint8_t* out, BlackboxDevice device, bool gap, uint64_t size, uint64_t deltaNs) {
+    size_t n = 0;
+    out[n++] = static_cast<uint8_t>(device) | (gap ? 0x80 : 0);
+    n += putVarint(out + n, size);
+    n += putVarint(out + n, deltaNs);
+    return n;
+}
+
+void record(BlackboxDevice device, const void* data, size_t size, uint64_t timeNs) {
+    ByteRing& ring = rings[device];
+    uint32_t current = generation.load(std::memory_order_acquire);
+    if (ring.generation != current) {
+        ring.generation = current;  // 새 파일: 시각 차 기준과 버림 표시 초기화
+        ring.lastTimeNs = 0;
+        ring.gap = false;
+    }
+
+    uint8_t header[MAX_ENTRY_HEADER];
+    size_t headerSize = encodeEntryHeader(header, device, ring.gap, size, timeNs - ring.lastTimeNs);
+    size_t total = headerSize + size;
+
+    uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    if (size > MAX_CHUNK || RING_SIZE - (tail - ring.cachedHead) < total) {
+        ring.cachedHead = ring.head.load(std::memory_order_acquire);
+        if (size > MAX_CHUNK || RING_SIZE - (tail - ring.cachedHead) < total) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            ring.gap = true;
+            return;
+        }
+    }
+    ring.copyIn(tail, header, headerSize);
+    ring.copyIn(tail + headerSize, data, size);
+    ring.tail.store(tail + total, std::memory_order_release);
+
+    ring.lastTimeNs = timeNs;
+    ring.gap = false;
+    ring.chunks.fetch_add(1, std::memory_order_relaxed);
+    ring.rawBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+// 모든 링의 [head, tail) 을 writev 한 번으로 씀 (링 끝에서 나뉘면 두 조각)
+size_t flushRings() {
+    struct iovec iov[2 * BLACKBOX_DEVICES];
+    uint64_t tails[BLACKBOX_DEVICES];
+    int count = 0;
+    size_t total = 0;
+    for (int d = 0; d < BLACKBOX_DEVICES; ++d) {
+        ByteRing& ring = rings[d];
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        tails[d] = ring.tail.load(std::memory_order_acquire);
+        size_t size = tails[d] - head;
+        if (size == 0) {
+            continue;
+        }
+        size_t start = head % RING_SIZE;
+        size_t first = std::min(size, RING_SIZE - start);
+        iov[count++] = {ring.bytes + start, first};
+        if (size > first) {
+            iov[count++] = {ring.bytes, size - first};
+        }
+        total += size;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // 부분 쓰기는 남은 조각을 이어서 씀
+    struct iovec* next = iov;
+    size_t remaining = total;
+    while (remaining > 0) {
+        ssize_t n = ::writev(blackboxFd, next, count - static_cast<int>(next - iov));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Failed to write blackbox");
+            break;
+        }
+        remaining -= static_cast<size_t>(n);
+        fileBytes.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+        while (n > 0 && static_cast<size_t>(n) >= next->iov_len) {
+            n -= next->iov_len;
+            ++next;
+        }
+        if (n > 0) {
+            next->iov_base = static_cast<uint8_t*>(next->iov_base) + n;
+            next->iov_len -= n;
+        }
+    }
+
+    for (int d = 0; d < BLACKBOX_DEVICES; ++d) {
+        rings[d].head.store(tails[d], std::memory_order_release);
+    }
+    return total;
+}
+
+size_t pendingBytes() {
+    size_t total = 0;
+    for (const ByteRing& ring : rings) {
+        total += ring.tail.load(std::memory_order_acquire) - ring.head.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t threadCpuNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+void writerLoop() {
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), WRITER_NICE);
+    uint64_t lastWriteNs = monotonicNs();
+    while (writerRunning.load(std::memory_order_relaxed)) {
+        uint64_t now = monotonicNs();
+        if (pendingBytes() >= WRITE_THRESHOLD || now - lastWriteNs >= WRITE_INTERVAL_NS) {
+            flushRings();
+            lastWriteNs = now;
+        }
+        writerCpuNs.store(threadCpuNs(), std::memory_order_relaxed);
+        std::this_thread::sleep_for(WRITER_IDLE);
+    }
+    flushRings();
+    writerCpuNs.store(threadCpuNs(), std::memory_order_relaxed);
+}
+
+// 재생 상태 (모든 필드는 replay.mutex로 보호)
+// IMU/GPS/기압은 전용 스레드가 블로킹으로 읽으므로 대기, RC는 제어 루프가 폴링하므로 대기하지 않음
+const bool REPLAY_BLOCKING[BLACKBOX_DEVICES] = {true, true, false, true};
+
+struct ReplayChunk {
+    uint64_t timeNs;
+    std::vector<uint8_t> bytes;
+    size_t offset;              // 호출자 버퍼가 작아 나누어 돌려준 위치
+};
+
+struct ReplayDevice {
+    std::deque<ReplayChunk> queue;   // 파일에서 미리 읽은 덩어리 (장치 사이 순서가 섞여 있으므로)
+    bool reader = false;             // blackboxRead를 호출한 스레드가 있음
+    bool waiting = false;            // 그 스레드가 다음 덩어리를 기다리는 중
+};
+
+struct ReplayState {
+    std::mutex mutex;
+    std::condition_variable changed;
+    BlackboxReader reader;
+    bool active = false;
+    bool endOfFile = false;
+    bool finished = false;
+    double speed = 1.0;
+    uint64_t dataStartNs = 0;        // 기록 시작 시각
+    uint64_t releasedNs = 0;         // 이 시각까지의 덩어리를 내보낼 수 있음
+    uint64_t wallStartNs = 0;        // 첫 replayStep 호출 시각 (속도 맞춤 기준)
+    ReplayDevice devices[BLACKBOX_DEVICES];
+};
+
+ReplayState replay;
+
+// device의 큐가 비어 있으면 그 장치의 항목이 나올 때까지 파일을 읽음
+void fetchReplay(int device) {
+    BlackboxChunk chunk;
+    while (replay.devices[device].queue.empty() && !replay.endOfFile) {
+        if (!replay.reader.next(chunk)) {
+            replay.endOfFile = true;
+            break;
+        }
+        replay.devices[chunk.device].queue.push_back(
+            ReplayChunk{chunk.timestampNs, std::vector<uint8_t>(chunk.data, chunk.data + chunk.size), 0});
+    }
+}
+
+// 데이터 시각 t를 내보낼 벽시계 시각
+uint64_t wallDueNs(uint64_t timeNs) {
+    if (replay.speed <= 0.0 || timeNs <= replay.dataStartNs) {
+        return 0;
+    }
+    return replay.wallStartNs + static_cast<uint64_t>((timeNs - replay.dataStartNs) / replay.speed);
+}
+
+void waitUntilWall(std::unique_lock<std::mutex>& lock, uint64_t dueNs) {
+    uint64_t now = monotonicNs();
+    if (dueNs > now) {
+        replay.changed.wait_for(lock, std::chrono::nanoseconds(dueNs - now));
+    }
+}
+
+// 대기하는 장치가 모두 풀린 시각까지의 덩어리를 가져가 처리를 끝내고 다음 읽기를 기다리는지
+// 풀린 덩어리가 남아 있으면 아직 읽는 스레드가 시작하지 않았어도 기다림 (첫 스텝의 시작 순서와 무관하게)
+bool replayCaughtUp() {
+    for (int d = 0; d < BLACKBOX_DEVICES; ++d) {
+        ReplayDevice& device = replay.devices[d];
+        if (!REPLAY_BLOCKING[d]) {
+            continue;
+        }
+        fetchReplay(d);
+        bool pending = !device.queue.empty() && device.queue.front().timeNs <= replay.releasedNs;
+        if (pending || (device.reader && !device.waiting)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ssize_t replayRead(BlackboxDevice index, void* buffer, size_t size, uint64_t& rxTimeNs) {
+    std::unique_lock<std::mutex> lock(replay.mutex);
+    ReplayDevice& device = replay.devices[index];
+    device.reader = true;
+    while (replay.active) {
+        fetchReplay(index);
+        if (!device.queue.empty() && device.queue.front().timeNs <= replay.releasedNs) {
+            ReplayChunk& chunk = device.queue.front();
+            uint64_t due = wallDueNs(chunk.timeNs);
+            if (monotonicNs() >= due) {
+                size_t n = std::min(size, chunk.bytes.size() - chunk.offset);
+                std::memcpy(buffer, chunk.bytes.data() + chunk.offset, n);
+                rxTimeNs = chunk.timeNs;
+                chunk.offset += n;
+                if (chunk.offset == chunk.bytes.size()) {
+                    device.queue.pop_front();
+                }
+                return static_cast<ssize_t>(n);
+            }
+            if (!REPLAY_BLOCKING[index]) {
+                return 0;
+            }
+            waitUntilWall(lock, due);  // 기록 당시 간격(또는 N배속)에 맞춤
+            continue;
+        }
+        if (!REPLAY_BLOCKING[index]) {
+            return 0;
+        }
+        device.waiting = true;
+        replay.changed.notify_all();
+        replay.changed.wait(lock);
+        device.waiting = false;
+    }
+    return 0;
+}
+
+}  // namespace
+
+bool startBlackbox(const char* path) {
+    if (writerRunning) {
+        return true;
+    }
+    blackboxFd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (blackboxFd < 0) {
+        perror("Failed to open blackbox file");
+        return false;
+    }
+    BlackboxFileHeader header = {{'B', 'B', 'O', 'X'}, 1, monotonicNs()};
+    if (::write(blackboxFd, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+        perror("Failed to write blackbox header");
+        ::close(blackboxFd);
+        blackboxFd = -1;
+        return false;
+    }
+    fileBytes = sizeof(header);
+    writerCpuNs = 0;
+
+    // 이전 기록에서 남은 바이트는 버리고 장치 스레드는 다음 덩어리부터 새 기준으로 기록
+    for (ByteRing& ring : rings) {
+        ring.head.store(ring.tail.load(std::memory_order_acquire), std::memory_order_release);
+        ring.chunks = 0;
+        ring.rawBytes = 0;
+        ring.dropped = 0;
+    }
+    generation.fetch_add(1, std::memory_order_release);
+    writerRunning = true;
+    writerThread = std::thread(writerLoop);
+    active.store(true, std::memory_order_release);
+    return true;
+}
+
+void stopBlackbox() {
+    if (!writerRunning) {
+        return;
+    }
+    active.store(false, std::memory_order_release);
+    writerRunning = false;
+    writerThread.join();
+    fsync(blackboxFd);
+    ::close(blackboxFd);
+    blackboxFd = -1;
+}
+
+bool blackboxRecording() {
+    return active.load(std::memory_order_relaxed);
+}
+
+BlackboxStats blackboxStats() {
+    BlackboxStats stats;
+    for (const ByteRing& ring : rings) {
+        stats.chunks += ring.chunks.load(std::memory_order_relaxed);
+        stats.rawBytes += ring.rawBytes.load(std::memory_order_relaxed);
+        stats.dropped += ring.dropped.load(std::memory_order_relaxed);
+    }
+    stats.fileBytes = fileBytes.load(std::memory_order_relaxed);
+    stats.writerCpuNs = writerCpuNs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+ssize_t blackboxRead(BlackboxDevice device, int fd, void* buffer, size_t size, uint64_t& rxTimeNs) {
+    if (blackboxReplaying()) {
+        ssize_t n = replayRead(device, buffer, size, rxTimeNs);
+        if (n > 0) {
+            trace(TRACE_SERIAL_READ, rxTimeNs, device);
+        }
+        return n;
+    }
+    ssize_t n = ::read(fd, buffer, size);
+    if (n > 0) {
+        rxTimeNs = monotonicNs();
+        trace(TRACE_SERIAL_READ, rxTimeNs, device);
+        if (active.load(std::memory_order_acquire)) {
+            record(device, buffer, static_cast<size_t>(n), rxTimeNs);
+        }
+    }
+    return n;
+}
+
+bool BlackboxReader::open(const char* path) {
+    close();
+    file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    if (fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, "BBOX", 4) != 0 || header.version != 1) {
+        close();
+        return false;
+    }
+    std::fill(lastTimeNs, lastTimeNs + BLACKBOX_DEVICES, 0);
+    return true;
+}
+
+void BlackboxReader::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool BlackboxReader::readVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(file);
+        if (c == EOF) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BlackboxReader::next(BlackboxChunk& chunk) {
+    if (!file) {
+        return false;
+    }
+    int tag = fgetc(file);
+    uint64_t size, delta;
+    if (tag == EOF || !readVarint(size) || !readVarint(delta)) {
+        return false;
+    }
+    uint8_t device = static_cast<uint8_t>(tag) & 0x7F;
+    if (device >= BLACKBOX_DEVICES || size > sizeof(data) || fread(data, 1, size, file) != size) {
+        return false;
+    }
+    lastTimeNs[device] += delta;
+    chunk.device = static_cast<BlackboxDevice>(device);
+    chunk.gap = (tag & 0x80) != 0;
+    chunk.timestampNs = lastTimeNs[device];
+    chunk.size = static_cast<uint32_t>(size);
+    chunk.data = data;
+    return true;
+}
+
+bool startReplay(const char* path, double speed) {
+    std::lock_guard<std::mutex> lock(replay.mutex);
+    if (!replay.reader.open(path)) {
+        fprintf(stderr, "Failed to open replay file %s\n", path);
+        return false;
+    }
+    for (ReplayDevice& device : replay.devices) {
+        device.queue.clear();
+        device.reader = false;
+        device.waiting = false;
+    }
+    replay.endOfFile = false;
+    replay.finished = false;
+    replay.speed = speed;
+    replay.dataStartNs = replay.reader.startNs();
+    replay.releasedNs = replay.dataStartNs;
+    replay.wallStartNs = 0;
+    replay.active = true;
+    return true;
+}
+
+void stopReplay() {
+    std::lock_guard<std::mutex> lock(replay.mutex);
+    replay.active = false;
+    replay.reader.close();
+    replay.changed.notify_all();
+}
+
+bool blackboxReplaying() {
+    std::lock_guard<std::mutex> lock(replay.mutex);
+    return replay.active;
+}
+
+bool replayStep(uint64_t stepNs) {
+    std::unique_lock<std::mutex> lock(replay.mutex);
+    if (!replay.active || replay.finished) {
+        return false;
+    }
+
+    // 대기하는 장치의 덩어리가 모두 나갔으면 끝 (폴링 장치의 남은 덩어리는 기다리지 않음)
+    bool remaining = false;
+    for (int d = 0; d < BLACKBOX_DEVICES; ++d) {
+        fetchReplay(d);
+        remaining = remaining || (REPLAY_BLOCKING[d] && !replay.devices[d].queue.empty());
+    }
+    if (!remaining) {
+        replay.finished = true;
+        replay.changed.notify_all();
+        return false;
+    }
+
+    if (replay.wallStartNs == 0) {
+        replay.wallStartNs = monotonicNs();
+    }
+    replay.releasedNs += stepNs;
+    uint64_t due = wallDueNs(replay.releasedNs);
+    while (replay.active && monotonicNs() < due) {
+        waitUntilWall(lock, due);
+    }
+    replay.changed.notify_all();
+    replay.changed.wait(lock, [] { return !replay.active || replayCaughtUp(); });
+    return replay.active;
+}
+
+bool replayFinished() {
+    std::lock_guard<std::mutex> lock(replay.mutex);
+    return replay.finished;
+}
+
+bool BlackboxWriter::open(const char* path, uint64_t startNs) {
+    close();
+    file = fopen(path, "wb");
+    if (!file) {
+        perror("Failed to open blackbox file");
+        return false;
+    }
+    BlackboxFileHeader header = {{'B', 'B', 'O', 'X'}, 1, startNs};
+    std::fill(lastTimeNs, lastTimeNs + BLACKBOX_DEVICES, 0);
+    return fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+bool BlackboxWriter::append(BlackboxDevice device, const void* data, size_t size, uint64_t timeNs) {
+    if (!file || device >= BLACKBOX_DEVICES) {
+        return false;
+    }
+    uint8_t header[MAX_ENTRY_HEADER];
+    size_t headerSize = encodeEntryHeader(header, device, false, size, timeNs - lastTimeNs[device]);
+    lastTimeNs[device] = timeNs;
+    return fwrite(header, 1, headerSize, file) == headerSize && fwrite(data, 1, size, file) == size;
+}
+
+void BlackboxWriter::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
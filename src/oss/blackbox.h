@@ -0,0 +1,103 @@
+// 블랙박스: 센서 시리얼 포트에서 읽은 원시 바이트를 그대로 기록
+// 드라이버는 read() 대신 blackboxRead()를 사용하고, 읽은 덩어리(chunk)마다 수신 시각과 장치 번호를 붙여
+// 장치별 SPSC 바이트 링에 복사 → 쓰기 스레드가 링 내용을 그대로 파일 끝에 덧붙임
+// 드라이버가 쓰는 수신 시각도 blackboxRead가 찍은 값이므로, 같은 덩어리를 같은 순서로 다시 넣으면 출력이 비트 단위로 같음
+// 재생 모드에서는 blackboxRead가 포트 대신 기록 파일의 덩어리와 기록된 수신 시각을 돌려줌
+//
+// 파일: BlackboxFileHeader 뒤에 항목이 이어짐
+//   [장치 | 0x80(앞에 버려진 덩어리 있음)] [varint 길이] [varint 같은 장치 이전 항목과의 시각 차 ns] [바이트]
+//   장치별 첫 항목의 시각 차는 0 기준 (절대 시각), 장치 사이 순서는 섞일 수 있음
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <sys/types.h>
+
+enum BlackboxDevice : uint8_t {
+    BLACKBOX_IMU = 0,
+    BLACKBOX_GPS = 1,
+    BLACKBOX_RC = 2,
+    BLACKBOX_BARO = 3,
+    BLACKBOX_DEVICES = 4,
+};
+
+struct BlackboxFileHeader {
+    char magic[4];          // "BBOX"
+    uint32_t version;
+    uint64_t startNs;       // 기록 시작 시각 (monotonicNs)
+};
+
+struct BlackboxStats {
+    uint64_t chunks = 0;        // 링에 넣은 덩어리 수
+    uint64_t rawBytes = 0;      // 센서 바이트 수
+    uint64_t fileBytes = 0;     // 헤더 포함 파일에 쓴 바이트
+    uint64_t dropped = 0;       // 링이 가득 차서 버린 덩어리 수
+    uint64_t writerCpuNs = 0;   // 쓰기 스레드 CPU 시간
+};
+
+bool startBlackbox(const char* path);
+void stopBlackbox();
+bool blackboxRecording();
+BlackboxStats blackboxStats();
+
+// read()와 같은 반환값. 읽은 바이트가 있으면 rxTimeNs에 수신 시각을 기록하고 블랙박스가 켜져 있으면 복사
+// 장치마다 한 스레드에서만 호출해야 함 (SPSC)
+ssize_t blackboxRead(BlackboxDevice device, int fd, void* buffer, size_t size, uint64_t& rxTimeNs);
+
+// 재생 시작: 이후 init 함수는 포트를 열지 않고 blackboxRead는 기록된 덩어리를 돌려줌
+// speed: 1 = 기록 당시 속도, N = N배속, 0 = 최대 속도
+// 데이터 시각은 replayStep으로만 진행되며, IMU/GPS/기압 읽기는 다음 덩어리가 풀릴 때까지 대기하고
+// RC 읽기(제어 루프의 폴링)는 풀린 덩어리가 없으면 바로 0을 돌려줌
+bool startReplay(const char* path, double speed);
+void stopReplay();
+bool blackboxReplaying();
+// 추정 루프에서 호출: 데이터 시각을 stepNs만큼 풀고, 대기하는 장치 스레드가 그 시각까지의 덩어리를 모두 처리하고
+// 다시 읽기를 기다릴 때까지 대기 (스레드 실행 순서와 무관하게 매 스텝 같은 샘플 집합이 보장됨)
+// 이전 스텝에서 기록을 모두 내보냈으면 false
+// 기록에 있는 IMU/GPS/기압 장치는 모두 읽는 스레드가 있어야 함 (없으면 그 장치 덩어리를 계속 기다림)
+bool replayStep(uint64_t stepNs);
+bool replayFinished();
+
+// 기록 파일 순차 읽기 (재생/분석용)
+struct BlackboxChunk {
+    BlackboxDevice device;
+    bool gap;                   // 이 덩어리 앞에 버려진 덩어리가 있음
+    uint64_t timestampNs;
+    uint32_t size;
+    const uint8_t* data;        // 다음 next() 호출 전까지 유효
+};
+
+class BlackboxReader {
+public:
+    ~BlackboxReader() { close(); }
+    bool open(const char* path);
+    void close();
+    // 다음 항목, 파일 끝이거나 잘린 항목이면 false
+    bool next(BlackboxChunk& chunk);
+    uint64_t startNs() const { return header.startNs; }
+
+private:
+    FILE* file = nullptr;
+    BlackboxFileHeader header = {};
+    uint64_t lastTimeNs[BLACKBOX_DEVICES] = {};
+    uint8_t data[65536];
+
+    bool readVarint(uint64_t& value);
+};
+
+// 지정한 시각으로 항목을 바로 파일에 쓰기 (합성 기록/변환 도구용, 스레드 안전하지 않음)
+class BlackboxWriter {
+public:
+    ~BlackboxWriter() { close(); }
+    bool open(const char* path, uint64_t startNs);
+    bool append(BlackboxDevice device, const void* data, size_t size, uint64_t timeNs);
+    void close();
+
+private:
+    FILE* file = nullptr;
+    uint64_t lastTimeNs[BLACKBOX_DEVICES] = {};
+};
+
+#endif
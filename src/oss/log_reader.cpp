@@ -0,0 +1,469 @@
+#include "log_reader.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cinttypes>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const size_t RECORD = sizeof(LogRecord);
+const size_t MAX_INDEX_BLOCKS = 1u << 24;   // 손상된 연결 고리에서 무한 반복 방지
+
+template <typename T>
+T payloadAs(const LogRecord& record) {
+    T value;
+    std::memcpy(&value, record.payload, sizeof(T));
+    return value;
+}
+
+bool parseFieldType(const std::string& name, LogFieldType& type) {
+    for (int t = LOG_U8; t <= LOG_CHAR; ++t) {
+        if (name == logFieldTypeName(static_cast<LogFieldType>(t))) {
+            type = static_cast<LogFieldType>(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+// "name:type[count]@offset" 또는 "name:type@offset"
+bool parseField(const std::string& token, LogFieldInfo& field) {
+    size_t colon = token.find(':');
+    size_t at = token.find('@', colon);
+    if (colon == std::string::npos || at == std::string::npos) {
+        return false;
+    }
+    size_t bracket = token.find('[', colon);
+    field.name = token.substr(0, colon);
+    field.count = 1;
+    std::string typeName;
+    if (bracket != std::string::npos && bracket < at) {
+        typeName = token.substr(colon + 1, bracket - colon - 1);
+        field.count = static_cast<uint32_t>(std::strtoul(token.c_str() + bracket + 1, nullptr, 10));
+    } else {
+        typeName = token.substr(colon + 1, at - colon - 1);
+    }
+    field.offset = static_cast<uint32_t>(std::strtoul(token.c_str() + at + 1, nullptr, 10));
+    return parseFieldType(typeName, field.type) && field.count > 0 &&
+           field.offset + field.count * logFieldTypeSize(field.type) <= LogRecord::PAYLOAD_SIZE;
+}
+
+template <typename T>
+char* formatAs(char* p, char* end, const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return std::to_chars(p, end, value).ptr;
+}
+
+// 원래 형식 그대로 문자열로 (float는 되읽으면 같은 값이 되는 가장 짧은 표현)
+char* formatField(char* p, char* end, const LogRecord& record, const LogFieldInfo& field, uint32_t index) {
+    const uint8_t* data = record.payload + field.offset + index * logFieldTypeSize(field.type);
+    switch (field.type) {
+    case LOG_U8: return formatAs<uint8_t>(p, end, data);
+    case LOG_I8: return formatAs<int8_t>(p, end, data);
+    case LOG_U16: return formatAs<uint16_t>(p, end, data);
+    case LOG_I16: return formatAs<int16_t>(p, end, data);
+    case LOG_U32: return formatAs<uint32_t>(p, end, data);
+    case LOG_I32: return formatAs<int32_t>(p, end, data);
+    case LOG_U64: return formatAs<uint64_t>(p, end, data);
+    case LOG_I64: return formatAs<int64_t>(p, end, data);
+    case LOG_F32: return formatAs<float>(p, end, data);
+    case LOG_F64: return formatAs<double>(p, end, data);
+    case LOG_CHAR: return formatAs<int8_t>(p, end, data);
+    }
+    return p;
+}
+
+// 문자열 필드는 한 열 (NUL까지, CSV 구분자는 '_'로 바꿈)
+char* formatText(char* p, const LogRecord& record, const LogFieldInfo& field) {
+    const char* text = reinterpret_cast<const char*>(record.payload + field.offset);
+    for (uint32_t i = 0; i < field.count && text[i] != '\0'; ++i) {
+        *p++ = (text[i] == ',' || text[i] == '\n' || text[i] == '"') ? '_' : text[i];
+    }
+    return p;
+}
+
+}  // namespace
+
+double logFieldValue(const LogRecord& record, const LogFieldInfo& field, uint32_t index) {
+    const uint8_t* p = record.payload + field.offset + index * logFieldTypeSize(field.type);
+    switch (field.type) {
+    case LOG_U8: { uint8_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_I8: { int8_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_U16: { uint16_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_I16: { int16_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_U32: { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_I32: { int32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_U64: { uint64_t v; std::memcpy(&v, p, sizeof(v)); return static_cast<double>(v); }
+    case LOG_I64: { int64_t v; std::memcpy(&v, p, sizeof(v)); return static_cast<double>(v); }
+    case LOG_F32: { float v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_F64: { double v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case LOG_CHAR: { int8_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    }
+    return 0.0;
+}
+
+bool LogReader::open(const char* path) {
+    close();
+    fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror("Failed to open log file");
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(LogFileHeader)) {
+        fprintf(stderr, "Log file too small: %s\n", path);
+        close();
+        return false;
+    }
+    fileSize = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        perror("Failed to map log file");
+        base = nullptr;
+        close();
+        return false;
+    }
+    base = static_cast<const uint8_t*>(mapped);
+
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, "FLOG", 4) != 0 || header.version != 2 || header.recordSize != RECORD ||
+        sizeof(header) + header.schemaSize > fileSize) {
+        fprintf(stderr, "Unsupported log file: %s\n", path);
+        close();
+        return false;
+    }
+    if (!parseSchema(reinterpret_cast<const char*>(base + sizeof(header)), header.schemaSize)) {
+        fprintf(stderr, "Invalid log schema: %s\n", path);
+        close();
+        return false;
+    }
+
+    fromIndex = loadIndex();
+    if (!fromIndex) {
+        scanChunks();
+    }
+    buildTypeLists();
+    return true;
+}
+
+void LogReader::close() {
+    if (base) {
+        munmap(const_cast<uint8_t*>(base), fileSize);
+        base = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    fileSize = 0;
+    header = {};
+    fromIndex = false;
+    schemaList.clear();
+    chunks.clear();
+    types.clear();
+}
+
+bool LogReader::parseSchema(const char* text, size_t size) {
+    std::istringstream lines(std::string(text, strnlen(text, size)));
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream tokens(line);
+        LogSchemaInfo schema;
+        if (!(tokens >> schema.type >> schema.name >> schema.size)) {
+            return false;
+        }
+        std::string token;
+        while (tokens >> token) {
+            LogFieldInfo field;
+            if (!parseField(token, field)) {
+                return false;
+            }
+            schema.fields.push_back(field);
+        }
+        schemaList.push_back(schema);
+    }
+    return true;
+}
+
+// 꼬리 → 마지막 색인 블록 → 이전 블록 ... 순서로 읽어 파일 순서로 뒤집음
+bool LogReader::loadIndex() {
+    size_t dataStart = sizeof(header) + header.schemaSize;
+    if (fileSize < dataStart + RECORD || (fileSize - dataStart) % RECORD != 0) {
+        return false;
+    }
+    const LogRecord* footer = recordAt(fileSize - RECORD);
+    if (footer->type != LOG_TYPE_FOOTER) {
+        return false;
+    }
+
+    std::vector<std::pair<const LogIndexEntry*, uint32_t>> blocks;
+    uint64_t offset = payloadAs<LogFooterInfo>(*footer).lastIndexOffset;
+    while (offset != 0) {
+        if (offset < dataStart || offset + RECORD > fileSize || blocks.size() >= MAX_INDEX_BLOCKS) {
+            return false;
+        }
+        const LogRecord* block = recordAt(offset);
+        if (block->type != LOG_TYPE_INDEX) {
+            return false;
+        }
+        LogIndexInfo info = payloadAs<LogIndexInfo>(*block);
+        if (offset + RECORD + static_cast<uint64_t>(info.entries) * sizeof(LogIndexEntry) > fileSize ||
+            info.previousOffset >= offset) {
+            return false;
+        }
+        blocks.emplace_back(reinterpret_cast<const LogIndexEntry*>(base + offset + RECORD), info.entries);
+        offset = info.previousOffset;
+    }
+
+    for (auto block = blocks.rbegin(); block != blocks.rend(); ++block) {
+        for (uint32_t i = 0; i < block->second; ++i) {
+            const LogIndexEntry& entry = block->first[i];
+            if (entry.offset + (entry.count + 1) * RECORD > fileSize) {
+                chunks.clear();
+                return false;
+            }
+            chunks.push_back(entry);
+        }
+    }
+    return true;
+}
+
+// 꼬리가 없거나 손상된 파일: 청크 머리만 읽으며 건너뜀 (잘린 마지막 청크는 버림)
+void LogReader::scanChunks() {
+    chunks.clear();
+    uint64_t offset = sizeof(header) + header.schemaSize;
+    while (offset + RECORD <= fileSize) {
+        const LogRecord* record = recordAt(offset);
+        if (record->type == LOG_TYPE_CHUNK) {
+            LogChunkInfo info = payloadAs<LogChunkInfo>(*record);
+            uint64_t size = (info.count + 1) * RECORD;
+            if (offset + size > fileSize) {
+                break;
+            }
+            chunks.push_back(LogIndexEntry{offset, info.minNs, info.maxNs, info.count, info.recordType, 0});
+            offset += size;
+        } else if (record->type == LOG_TYPE_INDEX) {
+            offset += RECORD * (1 + (payloadAs<LogIndexInfo>(*record).entries + 1) / 2);
+        } else if (record->type == LOG_TYPE_FOOTER) {
+            offset += RECORD;
+        } else {
+            fprintf(stderr, "Unexpected record at offset %" PRIu64 ", log truncated\n", offset);
+            break;
+        }
+    }
+}
+
+void LogReader::buildTypeLists() {
+    types.clear();
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto list = std::find_if(types.begin(), types.end(),
+                                 [&](const TypeChunks& t) { return t.type == chunks[i].recordType; });
+        if (list == types.end()) {
+            types.push_back(TypeChunks{chunks[i].recordType, {}, {}, {}});
+            list = types.end() - 1;
+        }
+        list->chunks.push_back(i);
+    }
+    for (TypeChunks& list : types) {
+        size_t n = list.chunks.size();
+        list.maxPrefix.resize(n);
+        list.minSuffix.resize(n);
+        uint64_t maxNs = 0;
+        for (size_t i = 0; i < n; ++i) {
+            maxNs = std::max(maxNs, chunks[list.chunks[i]].maxNs);
+            list.maxPrefix[i] = maxNs;
+        }
+        uint64_t minNs = UINT64_MAX;
+        for (size_t i = n; i-- > 0;) {
+            minNs = std::min(minNs, chunks[list.chunks[i]].minNs);
+            list.minSuffix[i] = minNs;
+        }
+    }
+}
+
+const LogReader::TypeChunks* LogReader::typeChunks(uint16_t type) const {
+    for (const TypeChunks& list : types) {
+        if (list.type == type) {
+            return &list;
+        }
+    }
+    return nullptr;
+}
+
+const LogSchemaInfo* LogReader::findSchema(uint16_t type) const {
+    for (const LogSchemaInfo& schema : schemaList) {
+        if (schema.type == type) {
+            return &schema;
+        }
+    }
+    return nullptr;
+}
+
+const LogSchemaInfo* LogReader::findSchema(const std::string& name) const {
+    for (const LogSchemaInfo& schema : schemaList) {
+        if (schema.name == name) {
+            return &schema;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t LogReader::recordCount(uint16_t type) const {
+    uint64_t count = 0;
+    if (const TypeChunks* list = typeChunks(type)) {
+        for (size_t i : list->chunks) {
+            count += chunks[i].count;
+        }
+    }
+    return count;
+}
+
+std::vector<uint16_t> LogReader::recordTypes() const {
+    std::vector<uint16_t> result;
+    for (const TypeChunks& list : types) {
+        result.push_back(list.type);
+    }
+    return result;
+}
+
+// 누적 최대 maxNs가 fromNs 이상인 첫 청크부터, 이후 청크의 최소 minNs가 toNs 이상이 되는 곳까지
+LogReader::Cursor LogReader::query(uint16_t type, uint64_t fromNs, uint64_t toNs) const {
+    Cursor cursor;
+    cursor.reader = this;
+    cursor.fromNs = fromNs;
+    cursor.toNs = toNs;
+    const TypeChunks* list = typeChunks(type);
+    if (!list) {
+        return cursor;
+    }
+    cursor.list = &list->chunks;
+    cursor.position = std::lower_bound(list->maxPrefix.begin(), list->maxPrefix.end(), fromNs) - list->maxPrefix.begin();
+    cursor.end = std::lower_bound(list->minSuffix.begin(), list->minSuffix.end(), toNs) - list->minSuffix.begin();
+    return cursor;
+}
+
+bool LogReader::Cursor::next(const LogRecord*& record) {
+    while (position < end) {
+        const LogIndexEntry& chunk = reader->chunks[(*list)[position]];
+        if (recordIndex == 0 && (chunk.maxNs < fromNs || chunk.minNs >= toNs)) {
+            ++position;  // 청크 전체가 범위 밖
+            continue;
+        }
+        while (recordIndex < chunk.count) {
+            const LogRecord* candidate = reader->recordAt(chunk.offset + (1 + recordIndex++) * RECORD);
+            if (candidate->timestampNs >= fromNs && candidate->timestampNs < toNs) {
+                record = candidate;
+                return true;
+            }
+        }
+        ++position;
+        recordIndex = 0;
+    }
+    return false;
+}
+
+size_t exportCsv(const LogReader& reader, const LogSchemaInfo& schema, FILE* out, uint64_t fromNs, uint64_t toNs) {
+    std::string line = "time_ns";
+    for (const LogFieldInfo& field : schema.fields) {
+        if (field.type == LOG_CHAR) {
+            line += ',' + field.name;
+            continue;
+        }
+        for (uint32_t i = 0; i < field.count; ++i) {
+            line += ',' + (field.count > 1 ? field.name + '_' + std::to_string(i) : field.name);
+        }
+    }
+    line += '\n';
+    fputs(line.c_str(), out);
+
+    size_t rows = 0;
+    char buffer[1024];
+    LogReader::Cursor cursor = reader.query(schema.type, fromNs, toNs);
+    const LogRecord* record;
+    char* end = buffer + sizeof(buffer) - 1;  // 한 줄 최대: 필드 48바이트 x 최대 24자
+    while (cursor.next(record)) {
+        char* p = std::to_chars(buffer, end, record->timestampNs).ptr;
+        for (const LogFieldInfo& field : schema.fields) {
+            if (field.type == LOG_CHAR) {
+                *p++ = ',';
+                p = formatText(p, *record, field);
+                continue;
+            }
+            for (uint32_t i = 0; i < field.count; ++i) {
+                *p++ = ',';
+                p = formatField(p, end, *record, field, i);
+            }
+        }
+        *p++ = '\n';
+        fwrite(buffer, 1, p - buffer, out);
+        ++rows;
+    }
+    return rows;
+}
+
+size_t exportColumns(const LogReader& reader, const LogSchemaInfo& schema, const std::string& prefix,
+                     uint64_t fromNs, uint64_t toNs) {
+    // 열마다 버퍼에 모아 크게 씀 (원소마다 fwrite를 부르면 호출 비용이 변환보다 큼)
+    const size_t COLUMN_BUFFER = 1 << 16;
+    struct Column {
+        FILE* file;
+        uint32_t offset;
+        size_t size;
+        std::vector<uint8_t> buffer;
+    };
+    std::vector<Column> columns;
+    auto openColumn = [&](const std::string& name, uint32_t offset, size_t size) {
+        FILE* file = fopen((prefix + "." + name).c_str(), "wb");
+        if (!file) {
+            perror("Failed to open column file");
+            return false;
+        }
+        columns.push_back(Column{file, offset, size, {}});
+        columns.back().buffer.reserve(COLUMN_BUFFER);
+        return true;
+    };
+
+    // 시각은 레코드 머리에 있으므로 payload 밖 위치로 따로 표시
+    const uint32_t TIME_COLUMN = UINT32_MAX;
+    bool ok = openColumn("time_ns.u64", TIME_COLUMN, sizeof(uint64_t));
+    for (const LogFieldInfo& field : schema.fields) {
+        size_t size = logFieldTypeSize(field.type);
+        if (field.type == LOG_CHAR) {
+            ok = ok && openColumn(field.name + ".char" + std::to_string(field.count), field.offset, field.count);  // 원소 = count 바이트
+            continue;
+        }
+        for (uint32_t i = 0; ok && i < field.count; ++i) {
+            std::string name = field.count > 1 ? field.name + "_" + std::to_string(i) : field.name;
+            ok = openColumn(name + "." + logFieldTypeName(field.type), field.offset + i * size, size);
+        }
+    }
+
+    size_t rows = 0;
+    if (ok) {
+        LogReader::Cursor cursor = reader.query(schema.type, fromNs, toNs);
+        const LogRecord* record;
+        while (cursor.next(record)) {
+            for (Column& column : columns) {
+                const uint8_t* data = column.offset == TIME_COLUMN ? reinterpret_cast<const uint8_t*>(&record->timestampNs)
+                                                                   : record->payload + column.offset;
+                column.buffer.insert(column.buffer.end(), data, data + column.size);
+                if (column.buffer.size() >= COLUMN_BUFFER) {
+                    fwrite(column.buffer.data(), 1, column.buffer.size(), column.file);
+                    column.buffer.clear();
+                }
+            }
+            ++rows;
+        }
+    }
+    for (Column& column : columns) {
+        fwrite(column.buffer.data(), 1, column.buffer.size(), column.file);
+        fclose(column.file);
+    }
+    return rows;
+}
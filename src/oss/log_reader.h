@@ -0,0 +1,100 @@
+// 바이너리 로그 (binary_logger.h, version 2) 읽기
+// 파일 전체를 mmap하고 꼬리 → 색인 블록을 따라 청크 목록만 읽음 (레코드 영역은 실제로 접근할 때만 페이지가 올라옴)
+// 종류별 청크 목록의 누적 최대/최소 시각으로 시각 검색, 한 종류만 읽을 때 다른 종류의 청크는 건드리지 않음
+// 꼬리가 없는 파일(비정상 종료)은 청크 머리를 따라가며 목록을 다시 만듦
+#ifndef LOG_READER_H
+#define LOG_READER_H
+
+#include "binary_logger.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct LogFieldInfo {
+    std::string name;
+    LogFieldType type;
+    uint32_t count;
+    uint32_t offset;
+};
+
+struct LogSchemaInfo {
+    uint16_t type;
+    std::string name;
+    uint32_t size;
+    std::vector<LogFieldInfo> fields;
+};
+
+// 레코드의 필드 값 (배열은 index번째 원소)
+double logFieldValue(const LogRecord& record, const LogFieldInfo& field, uint32_t index);
+
+class LogReader {
+public:
+    ~LogReader() { close(); }
+    bool open(const char* path);
+    void close();
+
+    uint64_t startNs() const { return header.startNs; }
+    const std::vector<LogSchemaInfo>& schemas() const { return schemaList; }
+    const LogSchemaInfo* findSchema(uint16_t type) const;
+    const LogSchemaInfo* findSchema(const std::string& name) const;
+    // 꼬리의 색인을 사용했는지 (false면 청크 머리를 따라가며 복구한 목록)
+    bool indexed() const { return fromIndex; }
+    size_t chunkCount() const { return chunks.size(); }
+    uint64_t recordCount(uint16_t type) const;
+    // 기록된 종류 (파일 순서)
+    std::vector<uint16_t> recordTypes() const;
+
+    // type 레코드 중 시각이 [fromNs, toNs)인 것을 파일 순서로 (청크 사이 시각은 조금 섞일 수 있음)
+    class Cursor {
+    public:
+        bool next(const LogRecord*& record);
+
+    private:
+        friend class LogReader;
+        const LogReader* reader = nullptr;
+        const std::vector<size_t>* list = nullptr;   // chunks 번호
+        size_t position = 0;                          // list 위치
+        size_t end = 0;
+        uint32_t recordIndex = 0;                     // 현재 청크 안 위치
+        uint64_t fromNs = 0;
+        uint64_t toNs = 0;
+    };
+    Cursor query(uint16_t type, uint64_t fromNs = 0, uint64_t toNs = UINT64_MAX) const;
+
+private:
+    struct TypeChunks {
+        uint16_t type;
+        std::vector<size_t> chunks;         // chunks 번호 (파일 순서)
+        std::vector<uint64_t> maxPrefix;    // 앞에서부터 maxNs 누적 최대 (시작 검색)
+        std::vector<uint64_t> minSuffix;    // 뒤에서부터 minNs 누적 최소 (끝 검색)
+    };
+
+    int fd = -1;
+    const uint8_t* base = nullptr;
+    size_t fileSize = 0;
+    LogFileHeader header = {};
+    bool fromIndex = false;
+    std::vector<LogSchemaInfo> schemaList;
+    std::vector<LogIndexEntry> chunks;
+    std::vector<TypeChunks> types;
+
+    bool parseSchema(const char* text, size_t size);
+    bool loadIndex();
+    void scanChunks();
+    void buildTypeLists();
+    const TypeChunks* typeChunks(uint16_t type) const;
+    const LogRecord* recordAt(uint64_t offset) const {
+        return reinterpret_cast<const LogRecord*>(base + offset);
+    }
+};
+
+// 변환 (log_convert, 벤치마크 공용), 쓴 레코드 수 반환
+// CSV: time_ns와 필드 열 (배열은 이름_0, 이름_1 ...)
+size_t exportCsv(const LogReader& reader, const LogSchemaInfo& schema, FILE* out,
+                 uint64_t fromNs = 0, uint64_t toNs = UINT64_MAX);
+// 열 단위: prefix.time_ns.u64, prefix.<필드>[_i].<형식> 파일에 원래 형식 그대로 (numpy.fromfile 등으로 바로 읽음)
+size_t exportColumns(const LogReader& reader, const LogSchemaInfo& schema, const std::string& prefix,
+                     uint64_t fromNs = 0, uint64_t toNs = UINT64_MAX);
+
+#endif
@@ -0,0 +1,182 @@
+#include "loop_stats.h"
+#include <mutex>
+#include <cstring>
+
+namespace {
+
+LoopStats loops[LOOP_STATS_MAX];
+LoopStats spareLoop;                        // 등록 공간이 없을 때 (스냅샷에 나오지 않음)
+std::atomic<size_t> loopCount{0};
+std::mutex registryMutex;
+
+uint64_t percentile(const uint64_t (&histogram)[LOOP_HISTOGRAM_BUCKETS], uint64_t total, double q, uint64_t maxNs) {
+    uint64_t rank = static_cast<uint64_t>(q * total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < LOOP_HISTOGRAM_BUCKETS; ++i) {
+        seen += histogram[i];
+        if (seen > rank) {
+            uint64_t upper = loopHistogramUpperNs(i);
+            return upper < maxNs ? upper : maxNs;
+        }
+    }
+    return maxNs;
+}
+
+}  // namespace
+
+uint64_t loopHistogramUpperNs(size_t bucket) {
+    const uint64_t SUB = 1u << LOOP_HISTOGRAM_SUB_BITS;
+    if (bucket < SUB) {
+        return bucket;
+    }
+    if (bucket >= LOOP_HISTOGRAM_BUCKETS - 1) {
+        return UINT64_MAX;
+    }
+    int shift = static_cast<int>(bucket >> LOOP_HISTOGRAM_SUB_BITS) - 1;
+    uint64_t mantissa = SUB + (bucket & (SUB - 1));
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LoopStats::Accumulator::add(uint64_t ns) {
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sumNs.store(sumNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns < minNs.load(std::memory_order_relaxed)) {
+        minNs.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > maxNs.load(std::memory_order_relaxed)) {
+        maxNs.store(ns, std::memory_order_relaxed);
+    }
+    std::atomic<uint64_t>& bucket = buckets[loopHistogramBucket(ns)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void LoopStats::Accumulator::read(uint64_t (&histogram)[LOOP_HISTOGRAM_BUCKETS], LoopTiming& timing) const {
+    timing.count = count.load(std::memory_order_relaxed);
+    timing.minNs = timing.count ? minNs.load(std::memory_order_relaxed) : 0;
+    timing.maxNs = maxNs.load(std::memory_order_relaxed);
+    timing.meanNs = timing.count ? sumNs.load(std::memory_order_relaxed) / timing.count : 0;
+    for (size_t i = 0; i < LOOP_HISTOGRAM_BUCKETS; ++i) {
+        histogram[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+void LoopStats::Accumulator::clear() {
+    count.store(0, std::memory_order_relaxed);
+    minNs.store(UINT64_MAX, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+    sumNs.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint64_t>& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+// seqlock 쓰기: 번호를 홀수로 올리고, 값을 쓴 뒤 짝수로 올림
+void LoopStats::writeBegin() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void LoopStats::writeEnd() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void LoopStats::begin(uint64_t nowNs) {
+    if (lastBeginNs != 0 && nowNs > lastBeginNs) {
+        writeBegin();
+        period.add(nowNs - lastBeginNs);
+        writeEnd();
+    }
+    lastBeginNs = nowNs;
+}
+
+void LoopStats::end(uint64_t nowNs) {
+    if (lastBeginNs == 0 || nowNs < lastBeginNs) {
+        return;
+    }
+    uint64_t elapsed = nowNs - lastBeginNs;
+    writeBegin();
+    execution.add(elapsed);
+    iterations.store(iterations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (targetPeriodNs != 0 && elapsed > targetPeriodNs) {
+        overruns.store(overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    writeEnd();
+}
+
+void LoopStats::snapshot(LoopStatsSnapshot& out) const {
+    uint64_t periodHistogram[LOOP_HISTOGRAM_BUCKETS];
+    uint64_t executionHistogram[LOOP_HISTOGRAM_BUCKETS];
+    uint32_t before, after;
+    do {
+        before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;  // 쓰는 중 (한 반복의 기록은 수십 ns)
+        }
+        out.iterations = iterations.load(std::memory_order_relaxed);
+        out.overruns = overruns.load(std::memory_order_relaxed);
+        period.read(periodHistogram, out.period);
+        execution.read(executionHistogram, out.execution);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    std::memcpy(out.name, name, sizeof(out.name));
+    out.targetPeriodNs = targetPeriodNs;
+    for (LoopTiming* timing : {&out.period, &out.execution}) {
+        const uint64_t (&histogram)[LOOP_HISTOGRAM_BUCKETS] = timing == &out.period ? periodHistogram : executionHistogram;
+        timing->p50Ns = percentile(histogram, timing->count, 0.50, timing->maxNs);
+        timing->p99Ns = percentile(histogram, timing->count, 0.99, timing->maxNs);
+        timing->p999Ns = percentile(histogram, timing->count, 0.999, timing->maxNs);
+    }
+}
+
+void LoopStats::reset() {
+    writeBegin();
+    period.clear();
+    execution.clear();
+    iterations.store(0, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+    writeEnd();
+}
+
+LoopStats& registerLoop(const char* name, uint64_t targetPeriodNs) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t count = loopCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::strncmp(loops[i].name, name, LOOP_NAME_SIZE - 1) == 0) {
+            return loops[i];
+        }
+    }
+    LoopStats* stats = &spareLoop;
+    if (count < LOOP_STATS_MAX) {
+        stats = &loops[count];
+    } else {
+        fprintf(stderr, "Loop stats full, %s not listed\n", name);
+    }
+    std::strncpy(stats->name, name, LOOP_NAME_SIZE - 1);
+    stats->targetPeriodNs = targetPeriodNs;
+    if (stats != &spareLoop) {
+        loopCount.store(count + 1, std::memory_order_release);   // 이름과 목표 주기를 쓴 뒤 공개
+    }
+    return *stats;
+}
+
+std::vector<LoopStatsSnapshot> loopStatsSnapshots() {
+    size_t count = loopCount.load(std::memory_order_acquire);
+    std::vector<LoopStatsSnapshot> snapshots(count);
+    for (size_t i = 0; i < count; ++i) {
+        loops[i].snapshot(snapshots[i]);
+    }
+    return snapshots;
+}
+
+void printLoopStats(FILE* out) {
+    fprintf(out, "%-11s %9s %9s %8s   %-26s   %-26s\n", "loop", "target ms", "iters", "overrun",
+            "period ms (mean/p99/max)", "exec ms (mean/p99/max)");
+    for (const LoopStatsSnapshot& s : loopStatsSnapshots()) {
+        fprintf(out, "%-11s %9.1f %9llu %8llu   %8.3f %8.3f %8.3f   %8.3f %8.3f %8.3f\n", s.name, s.targetPeriodNs * 1e-6,
+                static_cast<unsigned long long>(s.iterations), static_cast<unsigned long long>(s.overruns),
+                s.period.meanNs * 1e-6, s.period.p99Ns * 1e-6, s.period.maxNs * 1e-6,
+                s.execution.meanNs * 1e-6, s.execution.p99Ns * 1e-6, s.execution.maxNs * 1e-6);
+    }
+}
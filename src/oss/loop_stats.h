@@ -0,0 +1,108 @@
+// 주기 태스크 타이밍 통계 (주기와 실행 시간의 최소/최대/평균, 로그-선형 히스토그램, 오버런 수)
+// 태스크 스레드만 자기 블록에 쓰고, 텔레메트리/CLI는 seqlock으로 잠금 없이 스냅샷을 읽음
+// 메모리는 고정: 블록은 정적 배열(LOOP_STATS_MAX개), 블록마다 히스토그램 두 개
+#ifndef LOOP_STATS_H
+#define LOOP_STATS_H
+
+#include "timer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// HDR 방식 히스토그램: 2의 거듭제곱 구간마다 8칸 (칸 폭은 값의 12.5% 이하), 2^40ns(약 18분) 이상은 마지막 칸
+const int LOOP_HISTOGRAM_SUB_BITS = 3;
+const int LOOP_HISTOGRAM_MAX_BIT = 39;
+const size_t LOOP_HISTOGRAM_BUCKETS = (LOOP_HISTOGRAM_MAX_BIT - LOOP_HISTOGRAM_SUB_BITS + 2) << LOOP_HISTOGRAM_SUB_BITS;
+const size_t LOOP_STATS_MAX = 16;
+const size_t LOOP_NAME_SIZE = 12;
+
+inline size_t loopHistogramBucket(uint64_t ns) {
+    const uint64_t SUB = 1u << LOOP_HISTOGRAM_SUB_BITS;
+    if (ns < SUB) {
+        return static_cast<size_t>(ns);
+    }
+    int msb = 63 - __builtin_clzll(ns);
+    if (msb > LOOP_HISTOGRAM_MAX_BIT) {
+        return LOOP_HISTOGRAM_BUCKETS - 1;
+    }
+    int shift = msb - LOOP_HISTOGRAM_SUB_BITS;
+    return (static_cast<size_t>(shift + 1) << LOOP_HISTOGRAM_SUB_BITS) + ((ns >> shift) & (SUB - 1));
+}
+
+// 칸에 들어가는 가장 큰 값
+uint64_t loopHistogramUpperNs(size_t bucket);
+
+// 주기 또는 실행 시간 요약 (ns)
+struct LoopTiming {
+    uint64_t count = 0;
+    uint64_t minNs = 0;
+    uint64_t maxNs = 0;
+    uint64_t meanNs = 0;
+    uint64_t p50Ns = 0;     // 백분위는 칸 상한 (최대값을 넘지 않음)
+    uint64_t p99Ns = 0;
+    uint64_t p999Ns = 0;
+};
+
+struct LoopStatsSnapshot {
+    char name[LOOP_NAME_SIZE];
+    uint64_t targetPeriodNs;    // 0이면 센서가 주기를 정하는 루프 (오버런 판정 없음)
+    uint64_t iterations;
+    uint64_t overruns;          // 실행 시간이 목표 주기를 넘은 반복
+    LoopTiming period;          // begin() 사이 간격
+    LoopTiming execution;       // begin() → end()
+};
+
+class LoopStats {
+public:
+    // 반복 시작 (이전 시작부터의 간격을 주기로 기록)
+    void begin() { begin(monotonicNs()); }
+    void begin(uint64_t nowNs);
+    // 반복 끝 (시작부터의 실행 시간 기록)
+    void end() { end(monotonicNs()); }
+    void end(uint64_t nowNs);
+
+    // 쓰는 중이면 다시 읽음 (쓰기 스레드를 기다리게 하지 않음)
+    void snapshot(LoopStatsSnapshot& out) const;
+    void reset();
+
+private:
+    friend LoopStats& registerLoop(const char* name, uint64_t targetPeriodNs);
+
+    struct Accumulator {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> minNs{UINT64_MAX};
+        std::atomic<uint64_t> maxNs{0};
+        std::atomic<uint64_t> sumNs{0};
+        std::atomic<uint64_t> buckets[LOOP_HISTOGRAM_BUCKETS] = {};
+
+        // 쓰기 스레드 하나만 호출하므로 읽고 쓰기를 따로 (원자적 증가 불필요)
+        void add(uint64_t ns);
+        void read(uint64_t (&histogram)[LOOP_HISTOGRAM_BUCKETS], LoopTiming& timing) const;
+        void clear();
+    };
+
+    void writeBegin();
+    void writeEnd();
+
+    char name[LOOP_NAME_SIZE] = {};
+    uint64_t targetPeriodNs = 0;
+    std::atomic<uint32_t> sequence{0};     // 홀수면 쓰는 중
+    std::atomic<uint64_t> iterations{0};
+    std::atomic<uint64_t> overruns{0};
+    Accumulator period;
+    Accumulator execution;
+    uint64_t lastBeginNs = 0;               // 쓰기 스레드 전용
+};
+
+// 이름으로 블록을 얻음 (같은 이름은 같은 블록, 가득 차면 목록에 없는 예비 블록)
+LoopStats& registerLoop(const char* name, uint64_t targetPeriodNs);
+
+// 등록된 모든 루프 (등록 순서)
+std::vector<LoopStatsSnapshot> loopStatsSnapshots();
+
+// 루프별 한 줄씩 표로 출력 (ms)
+void printLoopStats(FILE* out);
+
+#endif
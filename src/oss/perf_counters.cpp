@@ -0,0 +1,258 @@
+#include "perf_counters.h"
+#include <mutex>
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+class PerfAccess {
+public:
+    static std::atomic<uint64_t>& calls(PerfRegion& region) { return region.calls; }
+    static std::atomic<uint64_t>& samples(PerfRegion& region) { return region.samples; }
+    static std::atomic<uint64_t>& multiplexed(PerfRegion& region) { return region.multiplexed; }
+    static std::atomic<uint64_t>& total(PerfRegion& region, int counter) { return region.totals[counter]; }
+    static const char* name(const PerfRegion& region) { return region.name; }
+};
+
+namespace perfDetail {
+std::atomic<bool> enabled{false};
+}
+
+namespace {
+
+struct CounterSpec {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+    bool userOnly;      // 사용자 공간만 셈 (읽기 시스템 호출이 섞이지 않게)
+};
+
+// PerfCounter 순서
+const CounterSpec COUNTER_SPECS[PERF_COUNTERS] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, true},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, true},
+    {"cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, true},
+    {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, true},
+    {"ctx-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, false},
+};
+
+// 스레드별 카운터 묶음 (처음 측정할 때 열고 스레드가 끝날 때 닫음)
+struct ThreadCounters {
+    int state = 0;                  // 0: 아직 안 엶, 1: 열림, -1: 쓸 수 있는 카운터 없음
+    int leader = -1;
+    int fds[PERF_COUNTERS];
+    int position[PERF_COUNTERS];    // 묶음 읽기 결과에서의 위치 (-1: 없음)
+    int opened = 0;
+
+    ~ThreadCounters() {
+        if (state == 0) {
+            return;
+        }
+        for (int i = 0; i < PERF_COUNTERS; ++i) {
+            if (position[i] >= 0) {
+                close(fds[i]);
+            }
+        }
+    }
+
+    bool open();
+    bool read(perfDetail::Reading& out) const;
+};
+
+thread_local ThreadCounters threadCounters;
+
+PerfRegion regions[PERF_REGION_MAX];
+PerfRegion spareRegion;
+std::atomic<size_t> regionCount{0};
+std::mutex registryMutex;
+std::atomic<uint32_t> sampleEvery{1};
+std::atomic<uint32_t> available{0};
+std::atomic<uint32_t> warned{0};        // 카운터별로 한 번만 경고 (비트), PERF_COUNTERS 비트는 스레드 전체 실패
+
+long perfEventOpen(perf_event_attr* attr, int groupFd) {
+    return syscall(SYS_perf_event_open, attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);   // 이 스레드, 모든 CPU
+}
+
+void warnOnce(uint32_t bit, const char* what, int error) {
+    if (!(warned.fetch_or(bit, std::memory_order_relaxed) & bit)) {
+        fprintf(stderr, "Perf counters: %s unavailable (%s)\n", what, strerror(error));
+    }
+}
+
+// 먼저 열린 카운터가 묶음의 대표가 되고, 나머지는 함께 스케줄되어 같은 구간을 셈
+bool ThreadCounters::open() {
+    int lastError = 0;
+    for (int i = 0; i < PERF_COUNTERS; ++i) {
+        position[i] = -1;
+        perf_event_attr attr = {};
+        attr.size = sizeof(attr);
+        attr.type = COUNTER_SPECS[i].type;
+        attr.config = COUNTER_SPECS[i].config;
+        attr.exclude_kernel = COUNTER_SPECS[i].userOnly;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = leader < 0;     // 대표를 다 연 뒤에 켬
+        long fd = perfEventOpen(&attr, leader);
+        if (fd < 0) {
+            lastError = errno;
+            warnOnce(1u << i, COUNTER_SPECS[i].name, errno);
+            continue;
+        }
+        fds[i] = static_cast<int>(fd);
+        position[i] = opened++;
+        if (leader < 0) {
+            leader = fds[i];
+        }
+        available.fetch_or(1u << i, std::memory_order_relaxed);
+    }
+    if (leader < 0) {
+        warnOnce(1u << PERF_COUNTERS, "all counters", lastError);
+        return false;
+    }
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+bool ThreadCounters::read(perfDetail::Reading& out) const {
+    uint64_t buffer[3 + PERF_COUNTERS];   // nr, time_enabled, time_running, 값들
+    ssize_t expected = static_cast<ssize_t>((3 + opened) * sizeof(uint64_t));
+    if (::read(leader, buffer, sizeof(buffer)) != expected) {
+        return false;
+    }
+    out.enabledNs = buffer[1];
+    out.runningNs = buffer[2];
+    for (int i = 0; i < PERF_COUNTERS; ++i) {
+        out.values[i] = position[i] >= 0 ? buffer[3 + position[i]] : 0;
+    }
+    return true;
+}
+
+}  // namespace
+
+namespace perfDetail {
+
+bool begin(PerfRegion& region, Reading& start) {
+    uint32_t every = sampleEvery.load(std::memory_order_relaxed);
+    if (PerfAccess::calls(region).fetch_add(1, std::memory_order_relaxed) % every != 0) {
+        return false;
+    }
+    ThreadCounters& counters = threadCounters;
+    if (counters.state == 0) {
+        counters.state = counters.open() ? 1 : -1;
+    }
+    return counters.state > 0 && counters.read(start);
+}
+
+void end(PerfRegion& region, const Reading& start) {
+    Reading now;
+    if (!threadCounters.read(now)) {
+        return;
+    }
+    uint64_t enabledNs = now.enabledNs - start.enabledNs;
+    uint64_t runningNs = now.runningNs - start.runningNs;
+    if (runningNs == 0) {
+        return;     // 구간 동안 카운터가 한 번도 돌지 않음
+    }
+    // 카운터가 다른 이벤트와 번갈아 돌았으면 돈 시간 비율로 늘림
+    bool scaled = runningNs < enabledNs;
+    for (int i = 0; i < PERF_COUNTERS; ++i) {
+        uint64_t delta = now.values[i] - start.values[i];
+        if (scaled) {
+            delta = static_cast<uint64_t>(static_cast<double>(delta) * enabledNs / runningNs);
+        }
+        PerfAccess::total(region, i).fetch_add(delta, std::memory_order_relaxed);
+    }
+    if (scaled) {
+        PerfAccess::multiplexed(region).fetch_add(1, std::memory_order_relaxed);
+    }
+    PerfAccess::samples(region).fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace perfDetail
+
+const char* perfCounterName(PerfCounter counter) {
+    return counter < PERF_COUNTERS ? COUNTER_SPECS[counter].name : "?";
+}
+
+PerfRegion& perfRegion(const char* name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t count = regionCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::strncmp(regions[i].name, name, PERF_NAME_SIZE - 1) == 0) {
+            return regions[i];
+        }
+    }
+    PerfRegion* region = &spareRegion;
+    if (count < PERF_REGION_MAX) {
+        region = &regions[count];
+    } else {
+        fprintf(stderr, "Perf regions full, %s not listed\n", name);
+    }
+    std::strncpy(region->name, name, PERF_NAME_SIZE - 1);
+    if (region != &spareRegion) {
+        regionCount.store(count + 1, std::memory_order_release);   // 이름을 쓴 뒤 공개
+    }
+    return *region;
+}
+
+void startPerfCounters(uint32_t every) {
+    sampleEvery.store(every ? every : 1, std::memory_order_relaxed);
+    perfDetail::enabled.store(true, std::memory_order_release);
+}
+
+void stopPerfCounters() {
+    perfDetail::enabled.store(false, std::memory_order_release);
+}
+
+bool perfCountersEnabled() {
+    return perfDetail::enabled.load(std::memory_order_relaxed);
+}
+
+uint32_t perfCountersAvailable() {
+    return available.load(std::memory_order_relaxed);
+}
+
+std::vector<PerfRegionSnapshot> perfRegionSnapshots() {
+    size_t count = regionCount.load(std::memory_order_acquire);
+    std::vector<PerfRegionSnapshot> snapshots(count);
+    for (size_t i = 0; i < count; ++i) {
+        PerfRegionSnapshot& s = snapshots[i];
+        std::memcpy(s.name, PerfAccess::name(regions[i]), PERF_NAME_SIZE);
+        s.calls = PerfAccess::calls(regions[i]).load(std::memory_order_relaxed);
+        s.samples = PerfAccess::samples(regions[i]).load(std::memory_order_relaxed);
+        s.multiplexed = PerfAccess::multiplexed(regions[i]).load(std::memory_order_relaxed);
+        for (int c = 0; c < PERF_COUNTERS; ++c) {
+            s.totals[c] = PerfAccess::total(regions[i], c).load(std::memory_order_relaxed);
+        }
+    }
+    return snapshots;
+}
+
+void printPerfCounters(FILE* out) {
+    uint32_t mask = perfCountersAvailable();
+    fprintf(out, "%-11s %9s %9s", "region", "calls", "samples");
+    for (int c = 0; c < PERF_COUNTERS; ++c) {
+        fprintf(out, " %13s", COUNTER_SPECS[c].name);
+    }
+    fprintf(out, " %6s %6s\n", "IPC", "muxed");
+    for (const PerfRegionSnapshot& s : perfRegionSnapshots()) {
+        fprintf(out, "%-11s %9llu %9llu", s.name, static_cast<unsigned long long>(s.calls),
+                static_cast<unsigned long long>(s.samples));
+        for (int c = 0; c < PERF_COUNTERS; ++c) {
+            if (mask & (1u << c)) {
+                fprintf(out, " %13.1f", s.mean(static_cast<PerfCounter>(c)));
+            } else {
+                fprintf(out, " %13s", "-");
+            }
+        }
+        bool ipc = (mask & (1u << PERF_CYCLES)) && (mask & (1u << PERF_INSTRUCTIONS)) && s.totals[PERF_CYCLES] > 0;
+        if (ipc) {
+            fprintf(out, " %6.2f", static_cast<double>(s.totals[PERF_INSTRUCTIONS]) / s.totals[PERF_CYCLES]);
+        } else {
+            fprintf(out, " %6s", "-");
+        }
+        fprintf(out, " %6llu\n", static_cast<unsigned long long>(s.multiplexed));
+    }
+}
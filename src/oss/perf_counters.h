@@ -0,0 +1,108 @@
+// 하드웨어 성능 카운터 (perf_event) 구간 측정
+// 스레드마다 처음 측정할 때 자기 스레드용 카운터 묶음(cycles, instructions, cache/branch miss, context switch)을 열고
+// PerfScope가 구간 시작/끝에서 묶음을 한 번씩 읽어 차이를 이름 붙은 구간에 누적
+// 하드웨어 카운터는 사용자 공간만 셈 (읽기 시스템 호출 자체는 포함되지 않음), context switch는 커널 이벤트라 전체를 셈
+// 커널/VM/권한(perf_event_paranoid) 때문에 열 수 없는 카운터는 빼고, 하나도 없으면 그 스레드의 구간은 아무것도 하지 않음
+// 꺼져 있으면 PerfScope는 relaxed 읽기 한 번, 켜져 있으면 측정마다 read() 두 번 (sampleEvery로 N번에 한 번만 측정)
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+enum PerfCounter {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS = 1,
+    PERF_CACHE_MISSES = 2,
+    PERF_BRANCH_MISSES = 3,
+    PERF_CONTEXT_SWITCHES = 4,
+    PERF_COUNTERS = 5,
+};
+
+const size_t PERF_REGION_MAX = 16;
+const size_t PERF_NAME_SIZE = 12;
+
+const char* perfCounterName(PerfCounter counter);
+
+class PerfRegion {
+private:
+    friend PerfRegion& perfRegion(const char* name);
+    friend class PerfAccess;
+
+    // 여러 스레드가 같은 구간을 쓸 수 있으므로 원자적 증가
+    char name[PERF_NAME_SIZE] = {};
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> multiplexed{0};
+    std::atomic<uint64_t> totals[PERF_COUNTERS] = {};
+};
+
+// 이름으로 구간을 얻음 (같은 이름은 같은 구간, 가득 차면 목록에 없는 예비 구간)
+PerfRegion& perfRegion(const char* name);
+
+// 측정 시작/정지 (sampleEvery번 들어올 때마다 한 번 측정)
+// 열린 카운터는 스레드가 끝날 때 닫힘 (정지해도 유지하여 다시 시작할 때 재사용)
+void startPerfCounters(uint32_t sampleEvery = 1);
+void stopPerfCounters();
+bool perfCountersEnabled();
+
+// 한 스레드에서라도 열린 카운터 (PerfCounter 비트)
+uint32_t perfCountersAvailable();
+
+namespace perfDetail {
+extern std::atomic<bool> enabled;
+
+struct Reading {
+    uint64_t enabledNs;
+    uint64_t runningNs;
+    uint64_t values[PERF_COUNTERS];
+};
+
+bool begin(PerfRegion& region, Reading& start);
+void end(PerfRegion& region, const Reading& start);
+}
+
+// 구간 측정 (스코프가 끝날 때 누적, 중첩하면 바깥 구간은 안쪽을 포함)
+class PerfScope {
+public:
+    explicit PerfScope(PerfRegion& region) : region(region) {
+        if (__builtin_expect(perfDetail::enabled.load(std::memory_order_relaxed), 0)) {
+            measuring = perfDetail::begin(region, start);
+        }
+    }
+    ~PerfScope() {
+        if (measuring) {
+            perfDetail::end(region, start);
+        }
+    }
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfRegion& region;
+    bool measuring = false;
+    perfDetail::Reading start;
+};
+
+struct PerfRegionSnapshot {
+    char name[PERF_NAME_SIZE];
+    uint64_t calls;                 // 켜진 동안 구간에 들어온 횟수
+    uint64_t samples;               // 측정한 횟수
+    uint64_t multiplexed;           // 카운터가 다른 이벤트와 번갈아 돌아 시간 비율로 보정한 측정
+    uint64_t totals[PERF_COUNTERS]; // 측정한 구간의 합 (없는 카운터는 0)
+
+    double mean(PerfCounter counter) const {
+        return samples ? static_cast<double>(totals[counter]) / samples : 0.0;
+    }
+};
+
+// 등록된 모든 구간 (등록 순서, 측정 중에 읽으면 합과 횟수가 한 측정만큼 어긋날 수 있음)
+std::vector<PerfRegionSnapshot> perfRegionSnapshots();
+
+// 구간별 한 줄씩 측정당 평균을 표로 출력 (없는 카운터는 -)
+void printPerfCounters(FILE* out);
+
+#endif
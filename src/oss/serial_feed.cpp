@@ -0,0 +1,162 @@
+#include "serial_feed.h"
+#include "transport.h"
+#include "timer.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+// 기록 파일은 장치 링을 몰아서 쓰므로 장치 사이 순서가 섞여 있음 → 이만큼 앞까지 읽어 두고 시각 순으로 내보냄
+const uint64_t REORDER_WINDOW_NS = 1000000000ULL;
+const uint64_t MAX_SLEEP_NS = 50000000ULL;     // 멈춤 요청 확인 간격
+
+struct FeedChunk {
+    uint64_t timeNs;
+    std::vector<uint8_t> data;
+};
+
+std::mutex controlMutex;
+std::thread feedThread;
+std::atomic<bool> running{false};
+std::atomic<bool> finished{false};
+std::atomic<uint64_t> chunkCount{0};
+std::atomic<uint64_t> byteCount{0};
+std::atomic<uint64_t> overrunBytes{0};
+std::atomic<uint64_t> maxLateNs{0};
+
+// 드라이버가 보낸 바이트 버리기 (쌓이면 드라이버 쪽 write가 막힘)
+void drain(const int (&peers)[BLACKBOX_DEVICES]) {
+    uint8_t discard[512];
+    for (int peer : peers) {
+        if (peer >= 0) {
+            while (read(peer, discard, sizeof(discard)) > 0) {
+            }
+        }
+    }
+}
+
+void sleepUntil(uint64_t dueNs) {
+    timespec due = {static_cast<time_t>(dueNs / 1000000000ULL), static_cast<long>(dueNs % 1000000000ULL)};
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr);
+}
+
+void feedLoop(BlackboxReader* reader, double speed, const int (&peers)[BLACKBOX_DEVICES]) {
+    std::deque<FeedChunk> queues[BLACKBOX_DEVICES];
+    bool endOfFile = false;
+    uint64_t newestNs = 0;
+    uint64_t dataStartNs = reader->startNs();
+    uint64_t wallStartNs = monotonicNs();
+
+    while (running.load(std::memory_order_relaxed)) {
+        // 가장 이른 대기 덩어리보다 REORDER_WINDOW_NS 뒤까지 읽음
+        int next = -1;
+        while (true) {
+            next = -1;
+            for (int d = 0; d < BLACKBOX_DEVICES; ++d) {
+                if (!queues[d].empty() && (next < 0 || queues[d].front().timeNs < queues[next].front().timeNs)) {
+                    next = d;
+                }
+            }
+            if (endOfFile || (next >= 0 && newestNs >= queues[next].front().timeNs + REORDER_WINDOW_NS)) {
+                break;
+            }
+            BlackboxChunk chunk;
+            if (!reader->next(chunk)) {
+                endOfFile = true;
+                continue;
+            }
+            newestNs = chunk.timestampNs > newestNs ? chunk.timestampNs : newestNs;
+            if (peers[chunk.device] >= 0) {
+                queues[chunk.device].push_back(FeedChunk{chunk.timestampNs, std::vector<uint8_t>(chunk.data, chunk.data + chunk.size)});
+            }
+        }
+        if (next < 0) {
+            break;  // 기록 끝
+        }
+
+        FeedChunk& chunk = queues[next].front();
+        uint64_t offsetNs = chunk.timeNs > dataStartNs ? chunk.timeNs - dataStartNs : 0;
+        uint64_t dueNs = wallStartNs + static_cast<uint64_t>(offsetNs / speed);
+        drain(peers);
+        uint64_t now = monotonicNs();
+        if (dueNs > now) {
+            sleepUntil(dueNs - now > MAX_SLEEP_NS ? now + MAX_SLEEP_NS : dueNs);
+            continue;   // 멈춤 요청 확인 후 다시
+        }
+        if (now - dueNs > maxLateNs.load(std::memory_order_relaxed)) {
+            maxLateNs.store(now - dueNs, std::memory_order_relaxed);
+        }
+
+        ssize_t written = write(peers[next], chunk.data.data(), chunk.data.size());
+        size_t accepted = written > 0 ? static_cast<size_t>(written) : 0;
+        overrunBytes.fetch_add(chunk.data.size() - accepted, std::memory_order_relaxed);
+        byteCount.fetch_add(accepted, std::memory_order_relaxed);
+        chunkCount.fetch_add(1, std::memory_order_relaxed);
+        queues[next].pop_front();
+    }
+    delete reader;
+    finished.store(true, std::memory_order_release);
+}
+
+}  // namespace
+
+bool startSerialFeed(const char* path, double speed, const char* const ports[BLACKBOX_DEVICES]) {
+    stopSerialFeed();
+    if (speed <= 0.0) {
+        fprintf(stderr, "Serial feed needs a positive speed\n");
+        return false;
+    }
+    int peers[BLACKBOX_DEVICES];
+    bool any = false;
+    for (int d = 0; d < BLACKBOX_DEVICES; ++d) {
+        peers[d] = ports[d] ? simulatedSerialPeer(ports[d]) : -1;
+        any = any || peers[d] >= 0;
+    }
+    if (!any) {
+        fprintf(stderr, "Serial feed: no simulated ports open\n");
+        return false;
+    }
+    BlackboxReader* reader = new BlackboxReader();   // 기록 읽기 버퍼가 커서 힙에 둠, 피더 스레드가 해제
+    if (!reader->open(path)) {
+        fprintf(stderr, "Failed to open feed file %s\n", path);
+        delete reader;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(controlMutex);
+    chunkCount = 0;
+    byteCount = 0;
+    overrunBytes = 0;
+    maxLateNs = 0;
+    finished = false;
+    running = true;
+    feedThread = std::thread([reader, speed, peers] { feedLoop(reader, speed, peers); });
+    return true;
+}
+
+void stopSerialFeed() {
+    std::lock_guard<std::mutex> lock(controlMutex);
+    running = false;
+    if (feedThread.joinable()) {
+        feedThread.join();
+    }
+}
+
+bool serialFeedFinished() {
+    return finished.load(std::memory_order_acquire);
+}
+
+SerialFeedStats serialFeedStats() {
+    SerialFeedStats stats;
+    stats.chunks = chunkCount.load(std::memory_order_relaxed);
+    stats.bytes = byteCount.load(std::memory_order_relaxed);
+    stats.overruns = overrunBytes.load(std::memory_order_relaxed);
+    stats.maxLateNs = maxLateNs.load(std::memory_order_relaxed);
+    return stats;
+}
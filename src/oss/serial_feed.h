@@ -0,0 +1,26 @@
+// 모의 시리얼 피더: 블랙박스 기록의 장치별 바이트를 모의 포트(pty 마스터)에 기록 당시 간격으로 써 넣음
+// 재생(startReplay)과 달리 드라이버는 실제 포트처럼 read()로 받으므로, 포트 열기/termios/논블로킹 읽기/수신 시각 경로까지
+// 하드웨어 없이 실시간으로 돌려볼 수 있음 (부하 시험, 배포 전 확인)
+// 드라이버가 쓴 바이트(IMU 요청 등)는 읽어서 버림
+#ifndef SERIAL_FEED_H
+#define SERIAL_FEED_H
+
+#include "blackbox.h"
+#include <cstdint>
+
+struct SerialFeedStats {
+    uint64_t chunks = 0;        // 써 넣은 덩어리 수
+    uint64_t bytes = 0;
+    uint64_t overruns = 0;      // pty 버퍼가 가득 차 버린 바이트 (드라이버가 제때 읽지 못함, 실제 UART 오버런에 해당)
+    uint64_t maxLateNs = 0;     // 예정 시각보다 늦게 쓴 최대 시간
+};
+
+// ports[device]: 그 장치 바이트를 받을 포트 이름 (nullptr이거나 모의 포트로 열리지 않은 포트는 건너뜀)
+// speed: 1 = 기록 당시 속도, N = N배속 (드라이버가 실시간으로 읽으므로 최대 속도는 없음)
+// 장치 초기화(openSerial) 뒤에 호출
+bool startSerialFeed(const char* path, double speed, const char* const ports[BLACKBOX_DEVICES]);
+void stopSerialFeed();
+bool serialFeedFinished();
+SerialFeedStats serialFeedStats();
+
+#endif
@@ -1 +1,11 @@
-// 주기적인 타이머를 설정하고 관리
\ No newline at end of file
+// 비행 제어 전반에서 사용하는 시간 함수
+#include "timer.h"
+#include <time.h>
+
+// CLOCK_MONOTONIC 기준 현재 시각 (나노초)
+// 벽시계(gettimeofday)와 달리 NTP/수동 시간 변경에 영향을 받지 않음
+uint64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
@@ -0,0 +1,39 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <cstdint>
+#include <limits>
+
+// CLOCK_MONOTONIC 기준 현재 시각 (나노초)
+uint64_t monotonicNs();
+
+// 나노초 간격을 초 단위로 변환
+inline float nsToSec(int64_t ns) {
+    return static_cast<float>(ns) * 1e-9f;
+}
+
+// 파이프라인 단계별 샘플 지연(age) 통계
+struct LatencyStat {
+    uint64_t count = 0;
+    uint64_t minNs = std::numeric_limits<uint64_t>::max();
+    uint64_t maxNs = 0;
+    uint64_t sumNs = 0;
+
+    // 샘플 수신 시각과 현재 단계 처리 시각으로 지연 기록
+    void add(uint64_t sampleTimeNs, uint64_t nowNs) {
+        if (sampleTimeNs == 0 || nowNs < sampleTimeNs) {
+            return;  // 타임스탬프가 없는 샘플은 무시
+        }
+        uint64_t age = nowNs - sampleTimeNs;
+        if (age < minNs) minNs = age;
+        if (age > maxNs) maxNs = age;
+        sumNs += age;
+        ++count;
+    }
+
+    double meanMs() const {
+        return count ? (sumNs / static_cast<double>(count)) * 1e-6 : 0.0;
+    }
+};
+
+#endif
@@ -0,0 +1,229 @@
+#include "trace.h"
+#include "blackbox.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <cinttypes>
+#include <cstdio>
+#include <pthread.h>
+
+namespace traceDetail {
+std::atomic<bool> enabled{false};
+}
+
+namespace {
+
+struct TraceRing {
+    std::atomic<uint64_t> count{0};     // 기록한 이벤트 수 (위치는 % TRACE_RING_EVENTS)
+    uint16_t thread = 0;
+    char name[16] = {};
+    TraceEvent events[TRACE_RING_EVENTS];
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<TraceRing>> rings;  // 스레드가 끝나도 해제하지 않음 (다음 수집에 필요)
+thread_local TraceRing* localRing = nullptr;
+
+// 틱 → ns 변환 기준 두 점
+uint64_t startTick = 0, startNs = 0;
+uint64_t stopTick = 0, stopNs = 0;
+
+TraceRing* registerThread() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    rings.emplace_back(new TraceRing());
+    TraceRing* ring = rings.back().get();
+    ring->thread = static_cast<uint16_t>(rings.size() - 1);
+    pthread_getname_np(pthread_self(), ring->name, sizeof(ring->name));
+    return ring;
+}
+
+const char* deviceName(uint8_t device) {
+    switch (device) {
+    case BLACKBOX_IMU: return "imu";
+    case BLACKBOX_GPS: return "gps";
+    case BLACKBOX_RC: return "rc";
+    case BLACKBOX_BARO: return "baro";
+    default: return "?";
+    }
+}
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, double q) {
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()));
+    return sorted[index];
+}
+
+}  // namespace
+
+void traceDetail::record(TraceStage stage, uint64_t id, uint8_t arg) {
+    uint64_t tick = traceTick();
+    TraceRing* ring = localRing;
+    if (ring == nullptr) {
+        ring = localRing = registerThread();
+    }
+    uint64_t count = ring->count.load(std::memory_order_relaxed);
+    ring->events[count % TRACE_RING_EVENTS] = TraceEvent{tick, id, stage, arg, ring->thread};
+    ring->count.store(count + 1, std::memory_order_release);
+}
+
+const char* traceStageName(TraceStage stage) {
+    static const char* const NAMES[TRACE_STAGES] = {"serial_read", "parse", "estimator", "controller", "mixer", "i2c_write"};
+    return stage < TRACE_STAGES ? NAMES[stage] : "?";
+}
+
+void startTracing() {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (auto& ring : rings) {
+            ring->count.store(0, std::memory_order_relaxed);
+        }
+    }
+    startNs = monotonicNs();
+    startTick = traceTick();
+    stopTick = stopNs = 0;
+    traceDetail::enabled.store(true, std::memory_order_release);
+}
+
+void stopTracing() {
+    traceDetail::enabled.store(false, std::memory_order_release);
+    stopNs = monotonicNs();
+    stopTick = traceTick();
+}
+
+bool tracingEnabled() {
+    return traceDetail::enabled.load(std::memory_order_relaxed);
+}
+
+std::vector<TraceEvent> collectTrace() {
+    uint64_t endTick = stopTick ? stopTick : traceTick();
+    uint64_t endNs = stopNs ? stopNs : monotonicNs();
+    double nsPerTick = endTick > startTick ? static_cast<double>(endNs - startNs) / (endTick - startTick) : 1.0;
+
+    std::vector<TraceEvent> events;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& ring : rings) {
+        uint64_t count = ring->count.load(std::memory_order_acquire);
+        uint64_t first = count > TRACE_RING_EVENTS ? count - TRACE_RING_EVENTS : 0;
+        for (uint64_t i = first; i < count; ++i) {
+            TraceEvent event = ring->events[i % TRACE_RING_EVENTS];
+            event.tick = startNs + static_cast<uint64_t>((static_cast<int64_t>(event.tick - startTick)) * nsPerTick);
+            events.push_back(event);
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.tick < b.tick; });
+    return events;
+}
+
+std::vector<TraceStageStats> traceLatencies(const std::vector<TraceEvent>& events) {
+    struct Origin {
+        uint64_t serialNs;
+        uint8_t device;
+        uint8_t seen;   // 단계별 첫 이벤트만 사용
+    };
+    std::unordered_map<uint64_t, Origin> origins;
+    std::vector<uint64_t> samples[BLACKBOX_DEVICES][TRACE_STAGES];
+    for (const TraceEvent& event : events) {
+        if (event.stage == TRACE_SERIAL_READ) {
+            if (event.arg < BLACKBOX_DEVICES) {
+                origins.emplace(event.id, Origin{event.tick, event.arg, 1});
+            }
+            continue;
+        }
+        auto origin = origins.find(event.id);
+        if (origin == origins.end() || event.stage >= TRACE_STAGES || (origin->second.seen & (1u << event.stage))) {
+            continue;  // 수신 이벤트가 링에서 밀려났거나 이미 센 단계
+        }
+        origin->second.seen |= 1u << event.stage;
+        samples[origin->second.device][event.stage].push_back(event.tick - origin->second.serialNs);
+    }
+
+    std::vector<TraceStageStats> result;
+    for (int d = 0; d < BLACKBOX_DEVICES; ++d) {
+        for (int s = TRACE_PARSE; s < TRACE_STAGES; ++s) {
+            std::vector<uint64_t>& latencies = samples[d][s];
+            if (latencies.empty()) {
+                continue;
+            }
+            std::sort(latencies.begin(), latencies.end());
+            TraceStageStats stats;
+            stats.device = static_cast<uint8_t>(d);
+            stats.stage = static_cast<TraceStage>(s);
+            stats.count = latencies.size();
+            stats.p50Ns = percentile(latencies, 0.50);
+            stats.p90Ns = percentile(latencies, 0.90);
+            stats.p99Ns = percentile(latencies, 0.99);
+            stats.maxNs = latencies.back();
+            result.push_back(stats);
+        }
+    }
+    return result;
+}
+
+bool exportChromeTrace(const std::vector<TraceEvent>& events, const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        perror("Failed to open trace file");
+        return false;
+    }
+
+    // 같은 id의 이벤트가 둘 이상이면 흐름 화살표로 연결 (첫 이벤트 s, 마지막 f, 사이 t)
+    std::unordered_map<uint64_t, std::pair<size_t, size_t>> span;   // id → (첫 위치, 마지막 위치)
+    for (size_t i = 0; i < events.size(); ++i) {
+        auto inserted = span.emplace(events[i].id, std::make_pair(i, i));
+        if (!inserted.second) {
+            inserted.first->second.second = i;
+        }
+    }
+    std::unordered_map<uint64_t, uint8_t> devices;   // id → 수신 장치
+    for (const TraceEvent& event : events) {
+        if (event.stage == TRACE_SERIAL_READ) {
+            devices.emplace(event.id, event.arg);
+        }
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (auto& ring : rings) {
+            fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",\n", ring->thread, ring->name[0] ? ring->name : "thread");
+            first = false;
+        }
+    }
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& event = events[i];
+        auto device = devices.find(event.id);
+        const char* category = device != devices.end() ? deviceName(device->second) : "unknown";
+        double us = event.tick * 1e-3;
+        fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"dur\":0.1,\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                     "\"args\":{\"id\":%" PRIu64 "}}",
+                first ? "" : ",\n", traceStageName(static_cast<TraceStage>(event.stage)), category, us, event.thread, event.id);
+        first = false;
+
+        const std::pair<size_t, size_t>& range = span[event.id];
+        if (range.first != range.second) {
+            const char* phase = i == range.first ? "s" : (i == range.second ? "f" : "t");
+            fprintf(out, ",\n{\"name\":\"sample\",\"cat\":\"%s\",\"ph\":\"%s\",\"bp\":\"e\",\"id\":%" PRIu64
+                         ",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                    category, phase, event.id, us, event.thread);
+        }
+    }
+    fprintf(out, "\n]}\n");
+    return fclose(out) == 0;
+}
+
+bool writeTraceReport(const char* path) {
+    stopTracing();
+    std::vector<TraceEvent> events = collectTrace();
+    bool written = exportChromeTrace(events, path);
+    printf("trace: %zu events%s%s\n", events.size(), written ? " -> " : "", written ? path : "");
+    printf("%-6s %-12s %8s %10s %10s %10s %10s\n", "device", "stage", "count", "p50 us", "p90 us", "p99 us", "max us");
+    for (const TraceStageStats& stats : traceLatencies(events)) {
+        printf("%-6s %-12s %8zu %10.1f %10.1f %10.1f %10.1f\n", deviceName(stats.device), traceStageName(stats.stage),
+               stats.count, stats.p50Ns * 1e-3, stats.p90Ns * 1e-3, stats.p99Ns * 1e-3, stats.maxNs * 1e-3);
+    }
+    fflush(stdout);  // 호출 뒤 quick_exit로 끝나는 경우가 있음
+    return written;
+}
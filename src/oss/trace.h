@@ -0,0 +1,89 @@
+// 단계별 지연 추적 (센서 바이트 수신 → 파싱 → 추정 → 제어 → 믹서 → I2C 쓰기)
+// 추적점은 스레드별 링에 (타이머 틱, 샘플 id, 단계)만 기록하고, 해석은 정지 후 내보낼 때 함
+// 샘플 id는 blackboxRead가 찍은 수신 시각 (드라이버/추정기/제어가 이미 샘플 시각으로 들고 다니는 값)
+// 링은 가득 차면 가장 오래된 이벤트를 덮어씀 (마지막 TRACE_RING_EVENTS개 유지)
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "timer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum TraceStage : uint8_t {
+    TRACE_SERIAL_READ = 0,      // blackboxRead가 바이트를 받음 (arg: BlackboxDevice)
+    TRACE_PARSE = 1,            // 드라이버가 샘플/프레임을 완성 (arg: 장치)
+    TRACE_ESTIMATOR = 2,        // EKF 예측/업데이트에 반영 (arg: 장치)
+    TRACE_CONTROLLER = 3,       // 제어 루프가 샘플을 반영한 값을 받음/계산
+    TRACE_MIXER = 4,            // 모터 출력 계산
+    TRACE_I2C_WRITE = 5,        // PCA9685 쓰기 완료
+    TRACE_STAGES = 6,
+};
+
+const size_t TRACE_RING_EVENTS = 65536;  // 스레드당 1.5MB
+
+struct TraceEvent {
+    uint64_t tick;
+    uint64_t id;
+    uint8_t stage;
+    uint8_t arg;
+    uint16_t thread;
+};
+
+// 타이머 틱 (x86: TSC, aarch64: 가상 카운터, 그 외 CLOCK_MONOTONIC ns)
+// 틱과 ns의 관계는 시작/정지 시 두 점으로 맞춤
+inline uint64_t traceTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return monotonicNs();
+#endif
+}
+
+void startTracing();
+void stopTracing();
+bool tracingEnabled();
+
+namespace traceDetail {
+extern std::atomic<bool> enabled;
+void record(TraceStage stage, uint64_t id, uint8_t arg);
+}
+
+// 추적점 (꺼져 있으면 relaxed 읽기 한 번), id 0은 시각이 없는 샘플이므로 무시
+inline void trace(TraceStage stage, uint64_t id, uint8_t arg = 0) {
+    if (__builtin_expect(traceDetail::enabled.load(std::memory_order_relaxed), 0) && id != 0) {
+        traceDetail::record(stage, id, arg);
+    }
+}
+
+// 정지 후 모든 스레드의 이벤트 (시각 순서, tick은 monotonicNs 기준 ns로 변환됨)
+std::vector<TraceEvent> collectTrace();
+
+// 단계별 지연: 같은 id의 TRACE_SERIAL_READ부터 각 단계 첫 이벤트까지 (ns), 장치(SERIAL_READ의 arg)별
+struct TraceStageStats {
+    uint8_t device;
+    TraceStage stage;
+    size_t count = 0;
+    uint64_t p50Ns = 0;
+    uint64_t p90Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t maxNs = 0;
+};
+std::vector<TraceStageStats> traceLatencies(const std::vector<TraceEvent>& events);
+const char* traceStageName(TraceStage stage);
+
+// Chrome trace / Perfetto JSON (스레드별 짧은 구간 이벤트 + 같은 id를 잇는 흐름 화살표)
+bool exportChromeTrace(const std::vector<TraceEvent>& events, const char* path);
+
+// 추적을 멈추고 JSON을 쓴 뒤 장치/단계별 지연 백분위를 표준 출력에 표로 출력
+bool writeTraceReport(const char* path);
+
+#endif
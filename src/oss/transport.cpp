@@ -0,0 +1,135 @@
+#include "transport.h"
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+
+namespace {
+
+const size_t SIMULATED_PORT_MAX = 8;
+const size_t PORT_NAME_SIZE = 32;
+
+struct SimulatedPort {
+    char name[PORT_NAME_SIZE];
+    int master;
+};
+
+std::atomic<bool> simulated{false};
+SimulatedPort simulatedPorts[SIMULATED_PORT_MAX];
+size_t simulatedPortCount = 0;
+std::mutex portMutex;
+
+// 원시 8N1: 패리티/흐름 제어/줄 단위 처리/에코 없음, 입력 변환 없음 (UBX/SBUS 바이너리의 0x0D, 0x11 등이 바뀌거나 먹히지 않게)
+bool configureRaw(int fd, int baudRate) {
+    struct termios options;
+    if (tcgetattr(fd, &options) != 0) {
+        return false;
+    }
+    cfsetispeed(&options, baudRate);
+    cfsetospeed(&options, baudRate);
+    options.c_cflag |= (CLOCAL | CREAD);
+    options.c_cflag &= ~(PARENB | CSTOPB | CSIZE | CRTSCTS);
+    options.c_cflag |= CS8;
+    options.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+    options.c_lflag &= ~(ICANON | ECHO | ECHOE | ECHONL | ISIG | IEXTEN);
+    options.c_oflag &= ~OPOST;
+    return tcsetattr(fd, TCSANOW, &options) == 0;
+}
+
+// pty 쌍을 만들고 슬레이브를 드라이버용으로 열기 (같은 이름을 다시 열면 기존 마스터를 재사용)
+int openSimulatedSerial(const std::string& port) {
+    std::lock_guard<std::mutex> lock(portMutex);
+    SimulatedPort* entry = nullptr;
+    for (size_t i = 0; i < simulatedPortCount; ++i) {
+        if (port == simulatedPorts[i].name) {
+            entry = &simulatedPorts[i];
+        }
+    }
+    if (!entry) {
+        if (simulatedPortCount >= SIMULATED_PORT_MAX) {
+            fprintf(stderr, "Simulated serial ports full, %s not opened\n", port.c_str());
+            return -1;
+        }
+        int master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+            perror("Failed to create simulated serial port");
+            if (master >= 0) {
+                close(master);
+            }
+            return -1;
+        }
+        entry = &simulatedPorts[simulatedPortCount++];
+        std::strncpy(entry->name, port.c_str(), PORT_NAME_SIZE - 1);
+        entry->master = master;
+    }
+    char slaveName[64];
+    if (ptsname_r(entry->master, slaveName, sizeof(slaveName)) != 0) {
+        perror("Failed to name simulated serial port");
+        return -1;
+    }
+    return open(slaveName, O_RDWR | O_NOCTTY | O_NDELAY);
+}
+
+}  // namespace
+
+void useSimulatedTransports(bool value) {
+    simulated.store(value, std::memory_order_relaxed);
+}
+
+bool simulatedTransports() {
+    return simulated.load(std::memory_order_relaxed);
+}
+
+int openSerial(const std::string& port, int baudRate) {
+    int fd = simulatedTransports() ? openSimulatedSerial(port) : open(port.c_str(), O_RDWR | O_NOCTTY | O_NDELAY);
+    if (fd == -1) {
+        fprintf(stderr, "Failed to open serial port %s\n", port.c_str());
+        return -1;
+    }
+    if (!configureRaw(fd, baudRate)) {
+        perror("Failed to configure serial port");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int simulatedSerialPeer(const std::string& port) {
+    std::lock_guard<std::mutex> lock(portMutex);
+    for (size_t i = 0; i < simulatedPortCount; ++i) {
+        if (port == simulatedPorts[i].name) {
+            return simulatedPorts[i].master;
+        }
+    }
+    return -1;
+}
+
+I2CDevTransport::I2CDevTransport(const char* bus, int address) {
+    fd = open(bus, O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open the i2c bus");
+    }
+    if (ioctl(fd, I2C_SLAVE, address) < 0) {
+        close(fd);
+        throw std::runtime_error("Failed to acquire bus access and/or talk to slave");
+    }
+}
+
+I2CDevTransport::~I2CDevTransport() {
+    close(fd);
+}
+
+bool I2CDevTransport::write(const uint8_t* data, size_t length) {
+    return ::write(fd, data, length) == static_cast<ssize_t>(length);
+}
+
+bool I2CDevTransport::read(uint8_t* data, size_t length) {
+    return ::read(fd, data, length) == static_cast<ssize_t>(length);
+}
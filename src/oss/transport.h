@@ -0,0 +1,51 @@
+// 장치 전송 계층: 드라이버가 시리얼/I2C 장치를 여는 곳을 한 군데로 모음
+// 실제 백엔드(termios 시리얼, /dev/i2c-N)와 모의 백엔드를 초기화 시점에 골라, 하드웨어 없이 일반 리눅스에서 전체 스택을 돌림
+//
+// 시리얼은 파일 디스크립터 그대로 사용 (드라이버/블랙박스가 fd 기반)
+//   모의 모드에서는 포트마다 pty 쌍을 만들어 드라이버에 슬레이브를 주고, 마스터는 simulatedSerialPeer로 시뮬레이터/피더가 사용
+//   pty 슬레이브도 같은 termios 설정을 거치므로 read()/논블로킹/원시 모드 동작이 실제 UART와 같음
+// I2C는 write/read 인터페이스 (실제: i2c-dev, 모의: 장치 쪽에서 구현, 예: SimulatedPCA9685)
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// 모의 백엔드 사용 여부 (장치 초기화 전에 설정)
+void useSimulatedTransports(bool simulated);
+bool simulatedTransports();
+
+// 원시 8N1 모드로 시리얼 포트 열기 (논블로킹, 흐름 제어/줄 단위 처리/문자 변환 없음), 실패하면 -1
+// baudRate는 termios 상수 (B115200 등), 모의 모드에서는 같은 이름의 pty를 만들어 돌려줌
+int openSerial(const std::string& port, int baudRate);
+
+// 모의 포트의 반대쪽 (마스터, 논블로킹), 없는 포트면 -1
+// 여기에 쓴 바이트를 드라이버가 읽고, 드라이버가 쓴 바이트는 여기서 읽힘
+int simulatedSerialPeer(const std::string& port);
+
+// I2C 장치 하나 (주소가 정해진 연결), 실패하면 false
+class I2CTransport {
+public:
+    virtual ~I2CTransport() = default;
+    virtual bool write(const uint8_t* data, size_t length) = 0;
+    virtual bool read(uint8_t* data, size_t length) = 0;
+};
+
+// /dev/i2c-N + I2C_SLAVE, 열기 실패는 예외
+class I2CDevTransport : public I2CTransport {
+public:
+    I2CDevTransport(const char* bus, int address);
+    ~I2CDevTransport() override;
+    I2CDevTransport(const I2CDevTransport&) = delete;
+    I2CDevTransport& operator=(const I2CDevTransport&) = delete;
+
+    bool write(const uint8_t* data, size_t length) override;
+    bool read(uint8_t* data, size_t length) override;
+
+private:
+    int fd;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "watchdog.h"
+#include "timer.h"
+#include <mutex>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+
+class WatchdogAccess {
+public:
+    static uint64_t count(const Heartbeat& heartbeat) {
+        return heartbeat.count.load(std::memory_order_relaxed);
+    }
+};
+
+namespace {
+
+struct WatchdogEntry {
+    Heartbeat heartbeat;
+    const char* name = nullptr;
+    uint64_t timeoutNs = 0;
+    std::function<void()> onMiss;
+    std::function<void()> onRecover;
+    bool active = false;
+    // 감시 스레드 상태
+    uint64_t lastCount = 0;
+    uint64_t lastChangeNs = 0;
+    uint64_t misses = 0;
+    bool missed = false;
+};
+
+WatchdogEntry entries[WATCHDOG_MAX];
+Heartbeat spareHeartbeat;                   // 칸이 없을 때 (감시되지 않음)
+std::mutex registryMutex;
+std::thread supervisor;
+std::atomic<bool> supervising{false};
+
+void check(uint64_t now) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (WatchdogEntry& entry : entries) {
+        if (!entry.active) {
+            continue;
+        }
+        uint64_t count = WatchdogAccess::count(entry.heartbeat);
+        if (count != entry.lastCount) {
+            entry.lastCount = count;
+            entry.lastChangeNs = now;
+            if (entry.missed) {
+                entry.missed = false;
+                fprintf(stderr, "Watchdog: %s recovered\n", entry.name);
+                if (entry.onRecover) {
+                    entry.onRecover();
+                }
+            }
+        } else if (!entry.missed && now - entry.lastChangeNs > entry.timeoutNs) {
+            entry.missed = true;
+            ++entry.misses;
+            fprintf(stderr, "Watchdog: %s missed (no heartbeat for %llu ms)\n", entry.name,
+                    static_cast<unsigned long long>((now - entry.lastChangeNs) / 1000000ULL));
+            if (entry.onMiss) {
+                entry.onMiss();
+            }
+        }
+    }
+}
+
+// 절대 시각으로 잠들어 감시 주기가 검사 시간만큼 밀리지 않게 함
+void supervise(uint64_t checkPeriodNs, int priority) {
+    pthread_setname_np(pthread_self(), "watchdog");
+    sched_param param = {};
+    param.sched_priority = priority;
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0) {
+        fprintf(stderr, "Watchdog: SCHED_FIFO %d unavailable (%s), running at normal priority\n", priority, strerror(error));
+    }
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (supervising.load(std::memory_order_relaxed)) {
+        uint64_t nsec = static_cast<uint64_t>(next.tv_nsec) + checkPeriodNs;
+        next.tv_sec += static_cast<time_t>(nsec / 1000000000ULL);
+        next.tv_nsec = static_cast<long>(nsec % 1000000000ULL);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+        check(monotonicNs());
+    }
+}
+
+}  // namespace
+
+Heartbeat& watchdogRegister(const char* name, uint64_t timeoutNs, std::function<void()> onMiss, std::function<void()> onRecover) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    WatchdogEntry* slot = nullptr;
+    for (WatchdogEntry& entry : entries) {
+        if (entry.name != nullptr && std::strcmp(entry.name, name) == 0) {
+            slot = &entry;
+            break;
+        }
+        if (slot == nullptr && entry.name == nullptr) {
+            slot = &entry;
+        }
+    }
+    if (slot == nullptr) {
+        fprintf(stderr, "Watchdog full, %s not supervised\n", name);
+        return spareHeartbeat;
+    }
+    slot->name = name;
+    slot->timeoutNs = timeoutNs;
+    slot->onMiss = std::move(onMiss);
+    slot->onRecover = std::move(onRecover);
+    slot->lastCount = WatchdogAccess::count(slot->heartbeat);
+    slot->lastChangeNs = monotonicNs();   // 등록 시점부터 제한 시간 안에 첫 신호가 와야 함
+    slot->missed = false;
+    slot->active = true;
+    return slot->heartbeat;
+}
+
+void watchdogRelease(Heartbeat& heartbeat) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (WatchdogEntry& entry : entries) {
+        if (&entry.heartbeat == &heartbeat) {
+            entry.active = false;
+            entry.onMiss = nullptr;
+            entry.onRecover = nullptr;
+        }
+    }
+}
+
+bool startWatchdog(uint64_t checkPeriodNs, int priority) {
+    if (supervising.exchange(true)) {
+        return true;
+    }
+    {
+        // 등록 후 시작까지 걸린 시간은 놓침으로 세지 않음
+        std::lock_guard<std::mutex> lock(registryMutex);
+        uint64_t now = monotonicNs();
+        for (WatchdogEntry& entry : entries) {
+            entry.lastChangeNs = now;
+        }
+    }
+    supervisor = std::thread(supervise, checkPeriodNs, priority);
+    return true;
+}
+
+void stopWatchdog() {
+    if (!supervising.exchange(false)) {
+        return;
+    }
+    if (supervisor.joinable()) {
+        supervisor.join();
+    }
+}
+
+std::vector<WatchdogStatus> watchdogStatus() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::vector<WatchdogStatus> status;
+    uint64_t now = monotonicNs();
+    for (const WatchdogEntry& entry : entries) {
+        if (entry.active) {
+            status.push_back({entry.name, entry.timeoutNs, entry.misses, entry.missed, now - entry.lastChangeNs});
+        }
+    }
+    return status;
+}
@@ -0,0 +1,50 @@
+// 소프트웨어 워치독 (스레드 생존 감시)
+// 감시 대상 스레드는 반복마다 Heartbeat::kick()으로 카운터만 올리고 (relaxed 읽기/쓰기 한 번, 시각 읽기 없음)
+// 높은 우선순위의 감시 스레드가 주기적으로 카운터를 비교하여 제한 시간 동안 변화가 없으면 onMiss, 다시 움직이면 onRecover 호출
+// 마지막 신호부터 감지까지는 제한 시간 + 감시 주기 2번 이하 (변화를 감시 시각에 보므로)
+// 콜백은 감시 스레드에서 등록 잠금을 잡은 채 호출되므로 짧게 끝나야 하고 워치독 함수를 부르면 안 됨
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+const size_t WATCHDOG_MAX = 16;
+const uint64_t WATCHDOG_CHECK_PERIOD_NS = 5000000ULL;   // 5ms
+const int WATCHDOG_PRIORITY = 90;                       // SCHED_FIFO (제어/센서 스레드보다 높게)
+
+class Heartbeat {
+public:
+    void kick() {
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+private:
+    friend class WatchdogAccess;
+    alignas(64) std::atomic<uint64_t> count{0};   // 감시 대상 스레드만 씀 (다른 카운터와 캐시 라인 분리)
+};
+
+// 제한 시간은 감시 대상의 정상 주기보다 충분히 길게 (지터 포함)
+// 같은 이름으로 다시 등록하면 같은 칸을 새 설정으로 재사용 (이름은 문자열 상수, 포인터를 보관)
+Heartbeat& watchdogRegister(const char* name, uint64_t timeoutNs, std::function<void()> onMiss = {},
+                            std::function<void()> onRecover = {});
+// 감시 중단 (콜백이 가리키는 객체를 없애기 전에 호출, 반환 후에는 콜백이 불리지 않음)
+void watchdogRelease(Heartbeat& heartbeat);
+
+// 감시 스레드 시작/정지 (우선순위를 올릴 권한이 없으면 경고 후 일반 스레드로 실행)
+bool startWatchdog(uint64_t checkPeriodNs = WATCHDOG_CHECK_PERIOD_NS, int priority = WATCHDOG_PRIORITY);
+void stopWatchdog();
+
+struct WatchdogStatus {
+    const char* name;
+    uint64_t timeoutNs;
+    uint64_t misses;            // 누적 놓침 횟수
+    bool missed;                // 지금 놓친 상태
+    uint64_t sinceKickNs;       // 마지막으로 카운터 변화를 본 뒤 경과 시간
+};
+std::vector<WatchdogStatus> watchdogStatus();
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <Eigen/Dense>
 
+struct RCInput;
+
 class PIDController {
 public:
     PIDController(float kp, float ki, float kd)
@@ -0,0 +1,178 @@
+#include "calibration_store.h"
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const uint32_t CALIBRATION_MAGIC = 0x424C4143;  // "CALB"
+
+// 파일 전체 구조 (헤더 + 고정 슬롯 배열)
+struct CalibrationStore::FileLayout {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;
+    CalibrationRecord records[CAPACITY];
+};
+
+// FNV-1a (checksum 필드 앞까지), 0은 빈 슬롯 표시로 쓰므로 피함
+static uint32_t recordChecksum(const CalibrationRecord& r) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&r);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(CalibrationRecord, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash ? hash : 1;
+}
+
+static bool isValid(const CalibrationRecord& r) {
+    return r.checksum != 0 && r.checksum == recordChecksum(r);
+}
+
+CalibrationStore::~CalibrationStore() {
+    close();
+}
+
+bool CalibrationStore::open(const std::string& path) {
+    close();
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd == -1) {
+        perror("Failed to open calibration file");
+        return false;
+    }
+
+    struct stat st;
+    bool fresh = fstat(fd, &st) != 0 || st.st_size != static_cast<off_t>(sizeof(FileLayout));
+    if (fresh && ftruncate(fd, sizeof(FileLayout)) != 0) {
+        perror("Failed to size calibration file");
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, sizeof(FileLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        perror("Failed to map calibration file");
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    file = static_cast<FileLayout*>(mapped);
+
+    // 새 파일이거나 형식이 다르면 초기화 (이전 버전 레코드는 재사용하지 않음)
+    if (fresh || file->magic != CALIBRATION_MAGIC || file->version != VERSION
+        || file->recordSize != sizeof(CalibrationRecord) || file->capacity != CAPACITY) {
+        if (!fresh) {
+            std::cerr << "Calibration file format changed, starting empty" << std::endl;
+        }
+        std::memset(file, 0, sizeof(FileLayout));
+        file->magic = CALIBRATION_MAGIC;
+        file->version = VERSION;
+        file->recordSize = sizeof(CalibrationRecord);
+        file->capacity = CAPACITY;
+        msync(file, sizeof(FileLayout), MS_SYNC);
+    }
+    return true;
+}
+
+void CalibrationStore::close() {
+    if (file) {
+        msync(file, sizeof(FileLayout), MS_SYNC);
+        munmap(file, sizeof(FileLayout));
+        file = nullptr;
+    }
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+int16_t CalibrationStore::bucketOf(float temperatureC) {
+    if (std::isnan(temperatureC)) {
+        return 0;  // 온도를 모르는 경우
+    }
+    return static_cast<int16_t>(std::floor(temperatureC / TEMPERATURE_BUCKET_C));
+}
+
+bool CalibrationStore::find(uint32_t sensorSerial, float temperatureC, CalibrationRecord& out) const {
+    if (!file) {
+        return false;
+    }
+
+    bool anyTemperature = std::isnan(temperatureC);
+    int16_t bucket = anyTemperature ? 0 : bucketOf(temperatureC);
+    const CalibrationRecord* best = nullptr;
+    int bestDistance = 0;
+
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        const CalibrationRecord& r = file->records[i];
+        if (r.sensorSerial != sensorSerial) {
+            continue;
+        }
+        // 체크섬은 후보가 될 때만 계산
+        int distance = anyTemperature ? 0 : std::abs(r.temperatureBucket - bucket);
+        bool better = !best || distance < bestDistance || (distance == bestDistance && r.sequence > best->sequence);
+        if (better && isValid(r)) {
+            best = &r;
+            bestDistance = distance;
+        }
+    }
+
+    if (!best) {
+        return false;
+    }
+    out = *best;
+    return true;
+}
+
+void CalibrationStore::save(uint32_t sensorSerial, float temperatureC, const float gyroBias[3], const float accelBias[3]) {
+    if (!file) {
+        return;
+    }
+
+    // 같은 키(시리얼, 온도 구간)에 RECORDS_PER_KEY개가 있으면 그중 가장 오래된 슬롯,
+    // 아니면 빈 슬롯(또는 깨진 슬롯), 빈 슬롯이 없으면 같은 키의 가장 오래된 슬롯
+    // 다른 키의 레코드는 같은 키의 레코드가 하나도 없고 빈 슬롯도 없을 때만 (전체에서 가장 오래된 것) 덮어씀
+    // → 정지 중 주기적 저장이 다른 온도 구간/다른 IMU의 레코드를 밀어내지 않음
+    int16_t bucket = bucketOf(temperatureC);
+    uint64_t newest = 0;
+    long freeSlot = -1, oldestSlot = -1, oldestKeySlot = -1;
+    size_t keyRecords = 0;
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        const CalibrationRecord& r = file->records[i];
+        if (!isValid(r)) {
+            freeSlot = freeSlot < 0 ? static_cast<long>(i) : freeSlot;
+            continue;
+        }
+        newest = r.sequence > newest ? r.sequence : newest;
+        if (oldestSlot < 0 || r.sequence < file->records[oldestSlot].sequence) {
+            oldestSlot = static_cast<long>(i);
+        }
+        if (r.sensorSerial == sensorSerial && r.temperatureBucket == bucket) {
+            ++keyRecords;
+            if (oldestKeySlot < 0 || r.sequence < file->records[oldestKeySlot].sequence) {
+                oldestKeySlot = static_cast<long>(i);
+            }
+        }
+    }
+    long slot = keyRecords >= RECORDS_PER_KEY ? oldestKeySlot
+              : freeSlot >= 0 ? freeSlot
+              : oldestKeySlot >= 0 ? oldestKeySlot
+              : oldestSlot;
+
+    CalibrationRecord record = {};
+    record.sensorSerial = sensorSerial;
+    record.temperatureBucket = bucket;
+    record.sequence = newest + 1;
+    std::memcpy(record.gyroBias, gyroBias, sizeof(record.gyroBias));
+    std::memcpy(record.accelBias, accelBias, sizeof(record.accelBias));
+    record.temperatureC = temperatureC;
+    record.checksum = recordChecksum(record);
+
+    file->records[slot] = record;
+    msync(file, sizeof(FileLayout), MS_ASYNC);
+}
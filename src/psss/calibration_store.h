@@ -0,0 +1,57 @@
+// 영구 캘리브레이션 저장소 (버전이 있는 고정 크기 바이너리 파일, mmap)
+// 센서 시리얼 번호와 온도 구간별로 IMU 바이어스를 보관하여 부팅 직후 바로 사용하고
+// 실행 중 정제된 값을 덮어쓰지 않고 새 슬롯에 기록 (기록 중 전원이 꺼져도 이전 값이 남음)
+#ifndef CALIBRATION_STORE_H
+#define CALIBRATION_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 캘리브레이션 레코드 한 개 (파일에 그대로 기록되므로 필드 순서/크기 변경 시 버전을 올릴 것)
+struct CalibrationRecord {
+    uint32_t sensorSerial;
+    int16_t temperatureBucket;  // TEMPERATURE_BUCKET_C 단위 구간 번호
+    uint16_t reserved;
+    uint64_t sequence;          // 기록 순서 (같은 키에서 가장 큰 값이 최신)
+    float gyroBias[3];          // rad/s
+    float accelBias[3];         // m/s^2
+    float temperatureC;         // 기록 당시 온도
+    uint32_t checksum;          // 앞 필드들의 FNV-1a (0이면 빈 슬롯)
+};
+
+class CalibrationStore {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t CAPACITY = 64;          // 레코드 슬롯 수
+    static constexpr size_t RECORDS_PER_KEY = 2;    // (시리얼, 온도 구간)마다 보관하는 레코드 수 (최신 + 기록 중 끊길 때의 이전 값)
+    static constexpr float TEMPERATURE_BUCKET_C = 10.0f;
+
+    CalibrationStore() = default;
+    ~CalibrationStore();
+    CalibrationStore(const CalibrationStore&) = delete;
+    CalibrationStore& operator=(const CalibrationStore&) = delete;
+
+    // 파일을 열어 매핑 (없거나 버전이 다르면 빈 저장소로 새로 만듦), 실패 시 false
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // 시리얼이 같은 레코드 중 온도 구간이 가장 가까운 최신 레코드 (온도가 NaN이면 가장 최근 기록)
+    // 체크섬이 맞지 않는 슬롯은 건너뜀, 없으면 false
+    bool find(uint32_t sensorSerial, float temperatureC, CalibrationRecord& out) const;
+
+    // 같은 (시리얼, 온도 구간)의 가장 오래된 레코드나 빈 슬롯에 새 레코드 기록 후 비동기 msync
+    // 다른 키의 레코드는 이 키의 레코드가 없고 빈 슬롯도 없을 때만 가장 오래된 것을 덮어씀
+    void save(uint32_t sensorSerial, float temperatureC, const float gyroBias[3], const float accelBias[3]);
+
+    static int16_t bucketOf(float temperatureC);
+
+private:
+    struct FileLayout;
+
+    FileLayout* file = nullptr;
+    int fd = -1;
+};
+
+#endif
@@ -2,187 +2,846 @@
 #include "ekf.h"
 #include <Eigen/Dense>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
+#include "../oss/timer.h"
 
 // 상수 정의
-const float GRAVITY = 9.80665f;       // 중력 상수 (m/s^2)
-const float GYRO_THRESHOLD = 0.01f;   // 자이로 변화 임계값 (너무 작은 자이로 변화는 무시)
-const float ALPHA = 0.9f;             // 저주파 필터 계수 (노이즈 필터링에 사용)
+const double GRAVITY = 9.80665;       // 중력 상수 (m/s^2)
+
+// 공칭 상태 인덱스
+const int NOMINAL_QUAT = 6;           // 쿼터니언 (w, x, y, z)
+const int NOMINAL_GYRO_BIAS = 10;
+const int NOMINAL_ACCEL_BIAS = 13;
+const int NOMINAL_BARO_BIAS = 16;
+
+// IMU 노이즈 모델 (연속 시간 밀도)
+const double ACCEL_NOISE_DENSITY = 0.02;   // m/s^2/sqrt(Hz)
+const double GYRO_NOISE_DENSITY = 0.002;   // rad/s/sqrt(Hz)
+const double ACCEL_BIAS_RANDOM_WALK = 1e-3; // m/s^3/sqrt(Hz)
+const double GYRO_BIAS_RANDOM_WALK = 1e-4;  // rad/s^2/sqrt(Hz)
+const double BARO_BIAS_RANDOM_WALK = 0.02;  // m/sqrt(Hz), 기상 변화/온도에 의한 기압 고도 드리프트
+
+// 자기장 측정 모델
+const uint64_t MAG_MIN_INTERVAL_NS = 50000000ULL;  // 최대 20Hz로 융합
+const double MAG_NOISE = 0.05;                      // 정규화된 자기장 성분 표준편차
+const double HEADING_NOISE = 0.1;                   // 방위 표준편차 (rad, 약 6도)
+const double MAG_STRENGTH_TOLERANCE = 0.3;          // 모델 세기 대비 허용 오차 비율
+
+// 기압 고도 측정 모델
+const double BARO_NOISE = 0.5;                      // 기압 고도 표준편차 (m)
+const double BARO_GATE = 5.0;                       // 잔차가 예측 표준편차의 이 배수를 넘으면 버림 (돌풍/프롭워시)
+
+// 영속도(ZUPT) 측정 모델
+const uint64_t ZUPT_MIN_INTERVAL_NS = 50000000ULL; // 최대 20Hz (연속 샘플의 상관된 진동을 과신하지 않도록)
+const double ZUPT_NOISE = 0.02;                     // 정지 중 속도 표준편차 (m/s)
 
 // 유틸리티 함수
 float radToDeg(float rad) { return rad * (180.0f / M_PI); }
 float degToRad(float deg) { return deg * (M_PI / 180.0f); }
 bool isValidValue(float value) { return !std::isnan(value) && !std::isinf(value); }
 
-// EKF 생성자
-EKF::EKF() {
-    state = Eigen::VectorXf::Zero(16);  // 상태 벡터 확장
-    state(6) = 1.0f;  
-
-    covariance = Eigen::MatrixXf::Identity(16, 16) * 0.05f;
+// 회전 벡터를 쿼터니언으로 변환
+template <typename Scalar>
+static Eigen::Quaternion<Scalar> rotationVectorToQuaternion(const Eigen::Matrix<Scalar, 3, 1>& rv) {
+    Scalar angle = rv.norm();
+    if (angle > Scalar(1e-6)) {
+        return Eigen::Quaternion<Scalar>(Eigen::AngleAxis<Scalar>(angle, rv / angle));
+    }
+    return Eigen::Quaternion<Scalar>(Scalar(1), rv.x() / 2, rv.y() / 2, rv.z() / 2).normalized();
+}
 
-    processNoise = Eigen::MatrixXf::Zero(16, 16);
-    processNoise.block<3, 3>(0, 0) = Eigen::Matrix3f::Identity() * 0.05f;
-    processNoise.block<3, 3>(3, 3) = Eigen::Matrix3f::Identity() * 0.05f;
-    processNoise.block<4, 4>(6, 6) = Eigen::Matrix4f::Identity() * 0.001f;
+// UD 인수분해 대각 하한 (0 또는 음수가 되는 것을 방지)
+template <typename CovScalar>
+static CovScalar MIN_UD_DIAGONAL() { return CovScalar(1e-12); }
+
+// P = U D U^T 분해, 결과는 하나의 행렬에 저장 (대각 = D, 상삼각 = U, 하삼각 = 0)
+template <typename Matrix>
+static Matrix factorUD(const Matrix& P) {
+    typedef typename Matrix::Scalar CovScalar;
+    const int n = P.rows();
+    Matrix ud = Matrix::Zero();
+    for (int j = n - 1; j >= 0; --j) {
+        CovScalar d = P(j, j);
+        for (int k = j + 1; k < n; ++k) {
+            d -= ud(j, k) * ud(j, k) * ud(k, k);
+        }
+        d = std::max(d, MIN_UD_DIAGONAL<CovScalar>());
+        ud(j, j) = d;
+        for (int i = 0; i < j; ++i) {
+            CovScalar v = P(i, j);
+            for (int k = j + 1; k < n; ++k) {
+                v -= ud(i, k) * ud(k, k) * ud(j, k);
+            }
+            ud(i, j) = v / d;
+        }
+    }
+    return ud;
+}
 
-    measurementNoise = Eigen::MatrixXf::Zero(6, 6);
-    measurementNoise.block<3, 3>(0, 0) = Eigen::Matrix3f::Identity() * 0.1f;   // 노이즈 증가
-    measurementNoise.block<3, 3>(3, 3) = Eigen::Matrix3f::Identity() * 0.1f;   // 노이즈 증가
+// 저장된 U, D로부터 P = U D U^T 복원
+template <typename Matrix>
+static Matrix expandUD(const Matrix& ud) {
+    Matrix u = ud.template triangularView<Eigen::StrictlyUpper>();
+    u.diagonal().setOnes();
+    return u * ud.diagonal().asDiagonal() * u.transpose();
+}
 
-    accelLast = Eigen::Vector3f::Zero();
-    gyroLast = Eigen::Vector3f::Zero();
+// EKF 생성자
+template <typename Scalar, typename CovScalar>
+BasicEKF<Scalar, CovScalar>::BasicEKF() {
+    state = StateVector::Zero();
+    state(NOMINAL_QUAT) = Scalar(1);
+
+    // 초기 오차 공분산 (위치 1m, 속도 0.5m/s, 자세 약 6도, 자이로 바이어스 0.01rad/s, 가속도 바이어스 0.1m/s^2, 기압 바이어스 1m)
+    covariance = ErrorMatrix::Zero();
+    covariance.template block<3, 3>(POS, POS) = CovMatrix3::Identity() * CovScalar(1.0);
+    covariance.template block<3, 3>(VEL, VEL) = CovMatrix3::Identity() * CovScalar(0.25);
+    covariance.template block<3, 3>(ATT, ATT) = CovMatrix3::Identity() * CovScalar(0.01);
+    covariance.template block<3, 3>(GYRO_BIAS, GYRO_BIAS) = CovMatrix3::Identity() * CovScalar(1e-4);
+    covariance.template block<3, 3>(ACCEL_BIAS, ACCEL_BIAS) = CovMatrix3::Identity() * CovScalar(0.01);
+    covariance(BARO_BIAS, BARO_BIAS) = CovScalar(1.0);
+
+    measurementNoise.setZero();
+    measurementNoise.template block<3, 3>(0, 0) = CovMatrix3::Identity() * CovScalar(0.1);
+    measurementNoise.template block<3, 3>(3, 3) = CovMatrix3::Identity() * CovScalar(0.1);
+    baroNoise = static_cast<CovScalar>(BARO_NOISE * BARO_NOISE);
+
+    // 기본 자기장 모델: 편각/복각 0 (북쪽 수평), 세기 검사 없음
+    setMagneticField(Scalar(0), Scalar(0), Scalar(0));
+
+    jacobian.dt = 0;
+    jacobian.velAtt.setZero();
+    jacobian.velBias.setZero();
+    jacobian.attAtt.setIdentity();
 }
 
 // EKF 소멸자
-EKF::~EKF() {}
+template <typename Scalar, typename CovScalar>
+BasicEKF<Scalar, CovScalar>::~BasicEKF() {}
 
 // 쿼터니언을 회전 행렬로 변환하는 함수
-Eigen::Matrix3f EKF::quaternionToRotationMatrix(const Eigen::Quaternionf& q) const {
+template <typename Scalar, typename CovScalar>
+typename BasicEKF<Scalar, CovScalar>::Matrix3 BasicEKF<Scalar, CovScalar>::quaternionToRotationMatrix(const Quaternion& q) const {
     return q.toRotationMatrix();  // Eigen 라이브러리의 내장 함수 사용
 }
 
-// 저주파 필터 함수 (가속도와 자이로의 노이즈를 줄이기 위해 사용)
-Eigen::Vector3f EKF::lowPassFilter(const Eigen::Vector3f& input, const Eigen::Vector3f& last, float alpha) {
-    return alpha * last + (1.0f - alpha) * input;  // 필터링된 새로운 값 반환
+// 반대칭 행렬 [v]x
+template <typename Scalar, typename CovScalar>
+typename BasicEKF<Scalar, CovScalar>::Matrix3 BasicEKF<Scalar, CovScalar>::skewSymmetric(const Vector3& v) const {
+    Matrix3 m;
+    m <<        0, -v.z(),  v.y(),
+          v.z(),       0, -v.x(),
+         -v.y(),  v.x(),       0;
+    return m;
 }
 
 // 예측 함수
-void EKF::predict(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, float dt) {
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::predict(const Vector3& accel, const Vector3& gyro, Scalar dt, uint64_t timeNs) {
     if (!isValidValue(accel.norm()) || !isValidValue(gyro.norm())) {
         std::cerr << "유효하지 않은 IMU 데이터 감지됨" << std::endl;
         return;
     }
 
-    Eigen::Vector3f filteredAccel = lowPassFilter(accel, accelLast, ALPHA);
-    Eigen::Vector3f filteredGyro = lowPassFilter(gyro, gyroLast, ALPHA);
-
-    if (filteredGyro.norm() < GYRO_THRESHOLD) {
-        return;
+    if (!(dt > 0) || !isValidValue(dt)) {
+        return;  // 샘플 시각이 역전되었거나 없는 경우
     }
 
-    predictState(filteredAccel, filteredGyro, dt);
-    computeJacobian(filteredAccel, filteredGyro, dt);
-    covariance = jacobian * covariance * jacobian.transpose() + processNoise;
+    propagate(accel, gyro, dt);
+
+    // 지연 측정 재전파를 위해 입력과 결과 상태를 기록
+    if (timeNs != 0) {
+        Snapshot snap;
+        snap.accel = accel;
+        snap.gyro = gyro;
+        snap.dt = dt;
+        snap.gpsCount = 0;
+        snap.hasMag = false;
+        snap.hasBaro = false;
+        snap.hasZeroVelocity = false;
+        saveSnapshot(snap);
+        history.push(timeNs, snap);
+    }
+}
 
-    accelLast = filteredAccel;
-    gyroLast = filteredGyro;
+// 공칭 상태와 오차 공분산을 dt만큼 전파
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::propagate(const Vector3& accel, const Vector3& gyro, Scalar dt) {
+    // 바이어스를 제거한 입력
+    Vector3 correctedAccel = accel - state.template segment<3>(NOMINAL_ACCEL_BIAS);
+    Vector3 correctedGyro = gyro - state.template segment<3>(NOMINAL_GYRO_BIAS);
+
+    // Jacobian은 전파 전 자세 기준으로 계산
+    computeJacobian(correctedAccel, correctedGyro, dt);
+    predictState(correctedAccel, correctedGyro, dt);
+    propagateCovariance(dt);
 }
 
-// 상태 예측 함수
-void EKF::predictState(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, float dt) {
-    Eigen::Vector3f position = state.segment<3>(0);
-    Eigen::Vector3f velocity = state.segment<3>(3);
-    Eigen::Quaternionf attitude(state(6), state(7), state(8), state(9));
+// 공칭 상태 예측 함수 (바이어스가 제거된 입력 사용)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::predictState(const Vector3& accel, const Vector3& gyro, Scalar dt) {
+    Vector3 position = state.template segment<3>(0);
+    Vector3 velocity = state.template segment<3>(3);
+    Quaternion attitude(state(6), state(7), state(8), state(9));
     attitude.normalize();
 
-    Eigen::Vector3f angleAxis = gyro * dt;
-    float angle = angleAxis.norm();
-    Eigen::Quaternionf deltaQ;
+    // 비력(specific force)을 월드 좌표로 변환 후 중력 보상 (NED, 아래 방향 +)
+    Vector3 accelWorld = quaternionToRotationMatrix(attitude) * accel;
+    accelWorld(2) += Scalar(GRAVITY);
 
-    if (angle > 1e-6f) {
-        deltaQ = Eigen::AngleAxisf(angle, angleAxis.normalized());
-    } else {
-        deltaQ = Eigen::Quaternionf(1.0f, angleAxis.x()/2.0f, angleAxis.y()/2.0f, angleAxis.z()/2.0f);
+    position += velocity * dt + Scalar(0.5) * accelWorld * dt * dt;
+    velocity += accelWorld * dt;
+    attitude = (attitude * rotationVectorToQuaternion<Scalar>(gyro * dt)).normalized();
+
+    state.template segment<3>(0) = position;
+    state.template segment<3>(3) = velocity;
+    state(6) = attitude.w();
+    state.template segment<3>(7) = attitude.vec();
+}
+
+// 오차 상태 천이 행렬의 해석적 블록 계산
+//   d(dp)/dt = dv
+//   d(dv)/dt = -R [a]x dtheta - R dba
+//   d(dtheta)/dt = -[w]x dtheta - dbg
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::computeJacobian(const Vector3& accel, const Vector3& gyro, Scalar dt) {
+    Quaternion attitude(state(6), state(7), state(8), state(9));
+    Matrix3 R = quaternionToRotationMatrix(attitude.normalized());
+
+    jacobian.dt = static_cast<CovScalar>(dt);
+    jacobian.velAtt = (-R * skewSymmetric(accel) * dt).template cast<CovScalar>();
+    jacobian.velBias = (-R * dt).template cast<CovScalar>();
+    jacobian.attAtt = rotationVectorToQuaternion<Scalar>(gyro * dt).toRotationMatrix().transpose().template cast<CovScalar>();
+}
+
+// m <- F * m (행 블록 단위, 0/단위 블록은 곱하지 않음)
+// 각 행 블록은 아직 갱신되지 않은 아래쪽 블록만 참조하므로 제자리 계산 가능
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::applyTransition(ErrorMatrix& m) const {
+    const CovScalar dt = jacobian.dt;
+    m.template middleRows<3>(POS) += dt * m.template middleRows<3>(VEL);
+    m.template middleRows<3>(VEL) += jacobian.velAtt * m.template middleRows<3>(ATT)
+                                   + jacobian.velBias * m.template middleRows<3>(ACCEL_BIAS);
+    Eigen::Matrix<CovScalar, 3, ERROR_SIZE> att = jacobian.attAtt * m.template middleRows<3>(ATT)
+                                                - dt * m.template middleRows<3>(GYRO_BIAS);
+    m.template middleRows<3>(ATT) = att;
+}
+
+// P <- F P F^T + G Q G^T
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::propagateCovariance(Scalar dt) {
+    if (covarianceForm == CovarianceForm::UD) {
+        propagateUD(dt);
+        return;
     }
-    deltaQ.normalize();
-    attitude = (attitude * deltaQ).normalized();
 
-    Eigen::Matrix3f rotationMatrix = quaternionToRotationMatrix(attitude);
-    Eigen::Vector3f accelWorld = rotationMatrix * accel;
-    accelWorld(2) -= GRAVITY;
+    // F P 를 계산한 뒤 전치하여 다시 F를 곱하면 F P F^T (P 대칭)
+    ErrorMatrix fp = covariance;
+    applyTransition(fp);
+    covariance = fp.transpose();
+    applyTransition(covariance);
 
-    velocity += accelWorld * dt;
-    position += velocity * dt + 0.5f * accelWorld * dt * dt;
+    covariance.diagonal() += processNoise(dt);
+
+    // 반올림 오차로 인한 비대칭 제거
+    covariance = CovScalar(0.5) * (covariance + covariance.transpose()).eval();
+}
+
+// 노이즈가 등방성이므로 G Q G^T는 대각 행렬 (속도: R Qa R^T = Qa)
+template <typename Scalar, typename CovScalar>
+typename BasicEKF<Scalar, CovScalar>::ErrorVector BasicEKF<Scalar, CovScalar>::processNoise(Scalar dt) const {
+    ErrorVector q = ErrorVector::Zero();
+    q.template segment<3>(VEL).setConstant(static_cast<CovScalar>(ACCEL_NOISE_DENSITY * ACCEL_NOISE_DENSITY * dt));
+    q.template segment<3>(ATT).setConstant(static_cast<CovScalar>(GYRO_NOISE_DENSITY * GYRO_NOISE_DENSITY * dt));
+    q.template segment<3>(GYRO_BIAS).setConstant(static_cast<CovScalar>(GYRO_BIAS_RANDOM_WALK * GYRO_BIAS_RANDOM_WALK * dt));
+    q.template segment<3>(ACCEL_BIAS).setConstant(static_cast<CovScalar>(ACCEL_BIAS_RANDOM_WALK * ACCEL_BIAS_RANDOM_WALK * dt));
+    q(BARO_BIAS) = static_cast<CovScalar>(BARO_BIAS_RANDOM_WALK * BARO_BIAS_RANDOM_WALK * dt);
+    return q;
+}
+
+// UD 시간 전파 (Thornton, modified weighted Gram-Schmidt)
+// W = [F U | I], 가중치 [D | q] 의 행을 아래에서부터 가중 직교화하면
+// W diag(D, q) W^T = F P F^T + Q 의 새로운 U, D를 얻음 (P를 직접 만들지 않음)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::propagateUD(Scalar dt) {
+    typedef Eigen::Matrix<CovScalar, ERROR_SIZE, 2 * ERROR_SIZE, Eigen::RowMajor> WeightedRows;
+    typedef Eigen::Matrix<CovScalar, 1, 2 * ERROR_SIZE> WeightedRow;
+
+    ErrorMatrix fu = covariance.template triangularView<Eigen::StrictlyUpper>();
+    fu.diagonal().setOnes();
+    applyTransition(fu);
+
+    WeightedRows w;
+    w.template leftCols<ERROR_SIZE>() = fu;
+    w.template rightCols<ERROR_SIZE>().setIdentity();
+    WeightedRow weights;
+    weights.template head<ERROR_SIZE>() = covariance.diagonal().transpose();
+    weights.template tail<ERROR_SIZE>() = processNoise(dt).transpose();
+
+    covariance.setZero();
+    for (int j = ERROR_SIZE - 1; j >= 0; --j) {
+        WeightedRow c = w.row(j).cwiseProduct(weights);
+        CovScalar d = std::max(w.row(j).dot(c), MIN_UD_DIAGONAL<CovScalar>());
+        covariance(j, j) = d;
+        for (int i = 0; i < j; ++i) {
+            CovScalar u = w.row(i).dot(c) / d;
+            covariance(i, j) = u;
+            w.row(i) -= u * w.row(j);
+        }
+    }
+}
+
+// 추정된 오차를 공칭 상태에 반영 (오차 상태는 0으로 리셋)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::injectError(const ErrorVector& dx) {
+    const Eigen::Matrix<Scalar, ERROR_SIZE, 1> d = dx.template cast<Scalar>();
+    state.template segment<3>(0) += d.template segment<3>(POS);
+    state.template segment<3>(3) += d.template segment<3>(VEL);
 
-    state.segment<3>(0) = position;
-    state.segment<3>(3) = velocity;
+    Quaternion attitude(state(6), state(7), state(8), state(9));
+    attitude = (attitude * rotationVectorToQuaternion<Scalar>(d.template segment<3>(ATT))).normalized();
     state(6) = attitude.w();
-    state.segment<3>(7) = attitude.vec();
+    state.template segment<3>(7) = attitude.vec();
+
+    state.template segment<3>(NOMINAL_GYRO_BIAS) += d.template segment<3>(GYRO_BIAS);
+    state.template segment<3>(NOMINAL_ACCEL_BIAS) += d.template segment<3>(ACCEL_BIAS);
+    state(NOMINAL_BARO_BIAS) += d(BARO_BIAS);
+}
+
+// GPS로 위치/속도 초기화 (원점에서 먼 곳에서 시작할 때 큰 잔차로 수렴하는 것을 방지)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::initializeWithGPS(const Vector3& gpsPos, const Vector3& gpsVel) {
+    state.template segment<3>(0) = gpsPos;
+    state.template segment<3>(3) = gpsVel / Scalar(1000);
+    baroInitialized = false;  // 기압 바이어스는 다음 측정에서 새 고도 기준으로 다시 설정
+    history.clear();
 }
 
-// 자코비안 계산 함수
-void EKF::computeJacobian(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, float dt) {
-    jacobian = Eigen::MatrixXf::Identity(16, 16);
-    jacobian.block<3, 3>(0, 3) = Eigen::Matrix3f::Identity() * dt;
+// 상태 업데이트 함수 (GPS 기반, 현재 상태에 즉시 적용)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::updateWithGPS(const Vector3& gpsPos, const Vector3& gpsVel) {
+    correctWithGPS(gpsPos, gpsVel);
 }
 
-// 상태 업데이트 함수 (GPS 기반)
-void EKF::updateWithGPS(const Eigen::Vector3f& gpsPos, const Eigen::Vector3f& gpsVel) {
-    Eigen::Vector3f gpsPos_latlon = gpsPos;
-    Eigen::Vector3f gpsVel_m = gpsVel / 1000.0f;
+// 지연된 GPS 측정을 측정 시각의 상태에 적용한 뒤 현재까지 재전파
+template <typename Scalar, typename CovScalar>
+bool BasicEKF<Scalar, CovScalar>::updateWithGPS(const Vector3& gpsPos, const Vector3& gpsVel, uint64_t timeNs) {
+    replaySteps = 0;
+
+    if (history.empty()) {
+        correctWithGPS(gpsPos, gpsVel);
+        return true;
+    }
 
-    Eigen::VectorXf z(6);
-    z.segment<3>(0) = gpsPos_latlon;
-    z.segment<3>(3) = gpsVel_m;
+    // 최신 예측보다 새로운 측정은 현재 상태에 적용하고 최신 스텝에 기록
+    if (timeNs >= history.newestTime()) {
+        Snapshot& newest = history.at(history.size() - 1);
+        if (!recordGps(newest, history.newestTime(), gpsPos, gpsVel)) {
+            return false;
+        }
+        correctWithGPS(gpsPos, gpsVel);
+        saveSnapshot(newest);
+        return true;
+    }
 
-    Eigen::VectorXf z_pred(6);
-    z_pred.segment<3>(0) = state.segment<3>(0);
-    z_pred.segment<3>(3) = state.segment<3>(3);
+    // 측정 시각을 포함하는 스텝 (시각이 timeNs 이상인 첫 스텝)
+    size_t first = static_cast<size_t>(history.findAtOrBefore(timeNs - 1) + 1);
+    if (first == 0) {
+        return false;  // 히스토리보다 오래된 측정
+    }
+    if (!recordGps(history.at(first), timeNs, gpsPos, gpsVel)) {
+        return false;
+    }
 
-    Eigen::VectorXf y = z - z_pred;
-    Eigen::MatrixXf H = Eigen::MatrixXf::Zero(6, 16);
-    H.block<3, 3>(0, 0) = Eigen::Matrix3f::Identity();
-    H.block<3, 3>(3, 3) = Eigen::Matrix3f::Identity();
+    // 직전 스텝의 상태로 되돌린 뒤 저장된 IMU 입력으로 현재까지 재전파
+    restoreSnapshot(history.at(first - 1));
+    for (size_t i = first; i < history.size(); ++i) {
+        replayStep(history.timeAt(i - 1), history.at(i));
+        saveSnapshot(history.at(i));
+        ++replaySteps;
+    }
+    return true;
+}
+
+// 스텝의 GPS 목록에 측정 시각 순으로 추가 (가득 차면 버리고 집계, 먼저 들어온 측정은 유지)
+template <typename Scalar, typename CovScalar>
+bool BasicEKF<Scalar, CovScalar>::recordGps(Snapshot& step, uint64_t timeNs, const Vector3& gpsPos, const Vector3& gpsVel) {
+    if (step.gpsCount >= GPS_PER_STEP) {
+        ++droppedGpsCount;
+        return false;
+    }
+    int i = step.gpsCount++;
+    for (; i > 0 && step.gpsTimeNs[i - 1] > timeNs; --i) {
+        step.gpsTimeNs[i] = step.gpsTimeNs[i - 1];
+        step.gpsPos[i] = step.gpsPos[i - 1];
+        step.gpsVel[i] = step.gpsVel[i - 1];
+    }
+    step.gpsTimeNs[i] = timeNs;
+    step.gpsPos[i] = gpsPos;
+    step.gpsVel[i] = gpsVel;
+    return true;
+}
 
-    Eigen::MatrixXf S = H * covariance * H.transpose() + measurementNoise;
-    Eigen::MatrixXf K = covariance * H.transpose() * S.inverse();
+// 저장된 스텝 하나를 다시 전파 (구간 안의 GPS는 각 측정 시각에, 자기장/기압/영속도는 스텝 끝에 적용)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::replayStep(uint64_t startNs, const Snapshot& step) {
+    Scalar done = 0;
+    for (int k = 0; k < step.gpsCount; ++k) {
+        Scalar at = std::min(static_cast<Scalar>(static_cast<int64_t>(step.gpsTimeNs[k] - startNs) * 1e-9), step.dt);
+        if (at > done) {
+            propagate(step.accel, step.gyro, at - done);
+            done = at;
+        }
+        correctWithGPS(step.gpsPos[k], step.gpsVel[k]);
+    }
+    if (step.dt - done > 0) {
+        propagate(step.accel, step.gyro, step.dt - done);
+    }
 
-    state += K * y;
-    covariance = (Eigen::MatrixXf::Identity(16, 16) - K * H) * covariance;
+    if (step.hasMag) {
+        correctWithMag(step.mag);
+    }
+    if (step.hasBaro) {
+        correctWithBaro(step.baroAltitude);
+    }
+    if (step.hasZeroVelocity) {
+        correctWithZeroVelocity();
+    }
+}
 
-    Eigen::Quaternionf attitude(state(6), state(7), state(8), state(9));
-    attitude.normalize();
-    state(6) = attitude.w();
-    state.segment<3>(7) = attitude.vec();
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::saveSnapshot(Snapshot& snap) const {
+    snap.state = state;
+    snap.covariance = covariance;
 }
 
-// 자기장 업데이트 (yaw 보정)
-void EKF::updateWithMag(const Eigen::Vector3f& mag) {
-    static int updateCounter = 0;  // 보정 주기 설정을 위한 카운터
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::restoreSnapshot(const Snapshot& snap) {
+    state = snap.state;
+    covariance = snap.covariance;
+}
 
-    // 보정 주기 설정 (예: 매 10번째 호출마다 보정)
-    if (updateCounter++ % 10 != 0) {
+// GPS 측정 보정 (현재 상태 기준, 위치 NED m / 속도 NED mm/s)
+// H가 선택 행렬이고 측정 노이즈가 대각이므로 6개 성분을 스칼라로 순차 적용 (역행렬 없음)
+// 잔차는 상태 정밀도(Scalar)로 계산한 뒤 공분산 정밀도로 변환
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::correctWithGPS(const Vector3& gpsPos, const Vector3& gpsVel) {
+    if (!sequentialUpdate && covarianceForm == CovarianceForm::Standard) {
+        correctWithGPSDense(gpsPos, gpsVel);
         return;
     }
 
-    Eigen::Quaternionf attitude(state(6), state(7), state(8), state(9));
-    attitude.normalize();
+    Vector3 gpsVel_m = gpsVel / Scalar(1000);
 
-    Eigen::Matrix3f rotationMatrix = quaternionToRotationMatrix(attitude);
-    Eigen::Vector3f expectedMag = rotationMatrix.transpose() * Eigen::Vector3f(1, 0, 0);
+    ErrorVector dx = ErrorVector::Zero();
+    const int posCount = gpsAltitudeFusion ? 3 : 2;
+    for (int i = 0; i < posCount; ++i) {
+        scalarUpdate(POS + i, static_cast<CovScalar>(gpsPos(i) - state(i)), measurementNoise(i, i), dx);
+    }
+    for (int i = 0; i < 3; ++i) {
+        scalarUpdate(VEL + i, static_cast<CovScalar>(gpsVel_m(i) - state(3 + i)), measurementNoise(3 + i, 3 + i), dx);
+    }
+    injectError(dx);
+}
 
-    Eigen::Vector3f normalizedMag = mag.normalized();
-    Eigen::Vector3f normalizedExpectedMag = expectedMag.normalized();
+// 오차 상태의 index 성분을 직접 관측하는 스칼라 측정 업데이트 (H = e_index)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::scalarUpdate(int index, CovScalar residual, CovScalar variance, ErrorVector& dx) {
+    scalarUpdate(ErrorVector::Unit(index), residual, variance, dx);
+}
 
-    float yawError = atan2(normalizedMag.y(), normalizedMag.x()) - atan2(normalizedExpectedMag.y(), normalizedExpectedMag.x());
+// 측정 행 h에 대한 스칼라 측정 업데이트
+// K = P h / s,  P <- (I - K h^T) P (I - K h^T)^T + r K K^T  (Joseph 형태)
+// P - P h h^T P / s 로 정리하면 r이 h^T P h의 유효 자릿수보다 작을 때
+// 단정밀도에서 대각이 음수가 될 수 있으므로 인수 형태 그대로 계산
+// h는 대부분 0이므로 P h는 0이 아닌 열만 더함
+// dx에는 앞선 성분들의 보정량이 누적되어 있으므로 잔차에서 빼고 적용
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::scalarUpdate(const ErrorVector& h, CovScalar residual, CovScalar variance, ErrorVector& dx) {
+    if (covarianceForm == CovarianceForm::UD) {
+        scalarUpdateUD(h, residual, variance, dx);
+        return;
+    }
 
-    const float MIN_YAW_ERROR = degToRad(0.01f);  // 최소 보정 오차 (예: 0.01도)
-    const float MAX_YAW_ERROR = degToRad(1.0f);   // 최대 보정 한계
-    const float CORRECTION_SCALE = 0.05f;         // 점진적 보정 비율
+    ErrorVector p = ErrorVector::Zero();
+    for (int i = 0; i < ERROR_SIZE; ++i) {
+        if (h(i) != 0) {
+            p += h(i) * covariance.col(i);
+        }
+    }
+    const CovScalar s = h.dot(p) + variance;
+    if (!(s > 0)) {
+        return;
+    }
+    const ErrorVector k = p / s;
+
+    dx += k * (residual - h.dot(dx));
+
+    // (I - K h^T) P  (P 대칭이므로 h^T P = p^T)
+    covariance.noalias() -= k * p.transpose();
+    // ... (I - K h^T)^T + r K K^T
+    ErrorVector m = ErrorVector::Zero();
+    for (int i = 0; i < ERROR_SIZE; ++i) {
+        if (h(i) != 0) {
+            m += h(i) * covariance.col(i);
+        }
+    }
+    covariance.noalias() += (variance * k - m) * k.transpose();
+
+    // 반올림 오차로 인한 비대칭 제거
+    for (int j = 0; j < ERROR_SIZE; ++j) {
+        for (int i = j + 1; i < ERROR_SIZE; ++i) {
+            CovScalar v = CovScalar(0.5) * (covariance(i, j) + covariance(j, i));
+            covariance(i, j) = v;
+            covariance(j, i) = v;
+        }
+    }
+}
 
-    // Yaw 보정 적용 조건
-    if (fabs(yawError) > MIN_YAW_ERROR) {
-        yawError = std::clamp(yawError, -MAX_YAW_ERROR, MAX_YAW_ERROR);
-        float correctionFactor = CORRECTION_SCALE * (fabs(yawError) / MAX_YAW_ERROR);  // 동적 보정 비율
-        yawError *= correctionFactor;
+// UD 형태의 스칼라 측정 업데이트 (Bierman)
+// f = U^T h 의 첫 0이 아닌 성분 이전 열은 바뀌지 않으므로 건너뜀 (H = e_index이면 index부터)
+// 이득 K = b / alpha, U와 D를 직접 갱신하므로 D가 양수로 유지됨
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::scalarUpdateUD(const ErrorVector& h, CovScalar residual, CovScalar variance, ErrorVector& dx) {
+    if (!(variance > 0)) {
+        return;
+    }
 
-        Eigen::AngleAxisf yawCorrection(yawError, Eigen::Vector3f::UnitZ());
-        attitude = (attitude * Eigen::Quaternionf(yawCorrection)).normalized();
+    // f = U^T h (U는 단위 상삼각, 대각 위치에는 D가 저장되어 있음)
+    ErrorVector f = h;
+    int first = -1;
+    for (int j = 0; j < ERROR_SIZE; ++j) {
+        for (int i = 0; i < j; ++i) {
+            f(j) += covariance(i, j) * h(i);
+        }
+        if (first < 0 && f(j) != 0) {
+            first = j;
+        }
+    }
+    if (first < 0) {
+        return;
     }
 
+    ErrorVector b = ErrorVector::Zero();
+    CovScalar alphaPrev = variance;
+    for (int j = first; j < ERROR_SIZE; ++j) {
+        const CovScalar v = covariance(j, j) * f(j);
+        const CovScalar alpha = alphaPrev + f(j) * v;
+        const CovScalar lambda = -f(j) / alphaPrev;
+        covariance(j, j) = std::max(covariance(j, j) * (alphaPrev / alpha), MIN_UD_DIAGONAL<CovScalar>());
+        for (int i = 0; i < j; ++i) {
+            const CovScalar u = covariance(i, j);
+            covariance(i, j) = u + b(i) * lambda;
+            b(i) += u * v;
+        }
+        b(j) = v;
+        alphaPrev = alpha;
+    }
+
+    dx += b * ((residual - h.dot(dx)) / alphaPrev);
+}
+
+// 밀집 행렬 GPS 보정 (비교/검증용)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::correctWithGPSDense(const Vector3& gpsPos, const Vector3& gpsVel) {
+    Vector3 gpsVel_m = gpsVel / Scalar(1000);
+
+    Eigen::Matrix<CovScalar, 6, 1> y;
+    y.template segment<3>(0) = (gpsPos - state.template segment<3>(0)).template cast<CovScalar>();
+    y.template segment<3>(3) = (gpsVel_m - state.template segment<3>(3)).template cast<CovScalar>();
+
+    Eigen::Matrix<CovScalar, 6, ERROR_SIZE> H = Eigen::Matrix<CovScalar, 6, ERROR_SIZE>::Zero();
+    H.template block<3, 3>(0, POS) = CovMatrix3::Identity();
+    H.template block<3, 3>(3, VEL) = CovMatrix3::Identity();
+    if (!gpsAltitudeFusion) {
+        H(2, POS + 2) = 0;  // 수직 위치 행을 0으로 두면 이득 열도 0
+        y(2) = 0;
+    }
+
+    Eigen::Matrix<CovScalar, 6, 6> S = H * covariance * H.transpose() + measurementNoise;
+    Eigen::Matrix<CovScalar, ERROR_SIZE, 6> K = covariance * H.transpose() * S.inverse();
+
+    injectError(K * y);
+    covariance = (ErrorMatrix::Identity() - K * H) * covariance;
+}
+
+// 지구 자기장 모델 (NED 단위 벡터 = [cosI cosD, cosI sinD, sinI])
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::setMagneticField(Scalar declinationRad, Scalar inclinationRad, Scalar strength) {
+    magDeclination = declinationRad;
+    magStrength = strength;
+    magField = Vector3(std::cos(inclinationRad) * std::cos(declinationRad),
+                       std::cos(inclinationRad) * std::sin(declinationRad),
+                       std::sin(inclinationRad));
+}
+
+// 자기장 업데이트 (측정 시각 기준으로 MAG_MIN_INTERVAL_NS마다 한 번)
+template <typename Scalar, typename CovScalar>
+bool BasicEKF<Scalar, CovScalar>::updateWithMag(const Vector3& mag, uint64_t timeNs) {
+    if (lastMagNs != 0 && timeNs < lastMagNs + MAG_MIN_INTERVAL_NS) {
+        return false;
+    }
+
+    // 크기가 모델과 크게 다르면 주변 자성체/전류 간섭으로 보고 버림
+    Scalar norm = mag.norm();
+    if (!isValidValue(norm) || norm <= Scalar(0)) {
+        return false;
+    }
+    if (magStrength > 0 && std::fabs(norm - magStrength) > MAG_STRENGTH_TOLERANCE * magStrength) {
+        return false;
+    }
+
+    lastMagNs = timeNs;
+    correctWithMag(mag);
+
+    // 지연 GPS 재전파 시 다시 적용되도록 최신 스텝에 기록
+    if (!history.empty() && history.newestTime() <= timeNs) {
+        Snapshot& newest = history.at(history.size() - 1);
+        newest.hasMag = true;
+        newest.mag = mag;
+        saveSnapshot(newest);
+    }
+    return true;
+}
+
+// 자기장 측정 보정 (현재 상태 기준)
+// 3축: z = m / |m|, h(x) = R^T m_ned, 자세 오차에 대한 H = [R^T m_ned]x
+// 방위: 측정 자기장을 월드로 돌린 수평 방향과 편각의 차이, H = R의 3행 (월드 z축 회전)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::correctWithMag(const Vector3& mag) {
+    Quaternion attitude(state(6), state(7), state(8), state(9));
+    Matrix3 R = quaternionToRotationMatrix(attitude.normalized());
+    Vector3 measured = mag.normalized();
+
+    ErrorVector dx = ErrorVector::Zero();
+    if (magMode == MagMode::ThreeAxis) {
+        Vector3 predicted = R.transpose() * magField;
+        Matrix3 H = skewSymmetric(predicted);
+        Vector3 residual = measured - predicted;
+        for (int i = 0; i < 3; ++i) {
+            ErrorVector h = ErrorVector::Zero();
+            h.template segment<3>(ATT) = H.row(i).transpose().template cast<CovScalar>();
+            scalarUpdate(h, static_cast<CovScalar>(residual(i)), static_cast<CovScalar>(MAG_NOISE * MAG_NOISE), dx);
+        }
+    } else {
+        Vector3 world = R * measured;
+        if (world.template head<2>().norm() < Scalar(1e-3)) {
+            return;  // 자기장이 거의 수직이면 방위를 알 수 없음
+        }
+        Scalar residual = magDeclination - std::atan2(world.y(), world.x());
+        residual = std::atan2(std::sin(residual), std::cos(residual));
+        ErrorVector h = ErrorVector::Zero();
+        h.template segment<3>(ATT) = R.row(2).transpose().template cast<CovScalar>();
+        scalarUpdate(h, static_cast<CovScalar>(residual), static_cast<CovScalar>(HEADING_NOISE * HEADING_NOISE), dx);
+    }
+    injectError(dx);
+}
+
+// 기압 고도 업데이트 (첫 측정은 현재 고도와의 차이로 바이어스를 초기화)
+template <typename Scalar, typename CovScalar>
+bool BasicEKF<Scalar, CovScalar>::updateWithBaro(Scalar altitude) {
+    if (!isValidValue(altitude)) {
+        return false;
+    }
+    if (!baroInitialized) {
+        state(NOMINAL_BARO_BIAS) = altitude + state(2);
+        baroInitialized = true;
+        // 이전 스텝의 스냅샷은 바이어스 0으로 남아 있으므로 같은 값으로 맞춤
+        // (안 하면 그 스텝부터 재전파할 때 바이어스가 0으로 돌아가 기압 보정이 pD를 크게 끌어당김)
+        for (size_t i = 0; i < history.size(); ++i) {
+            history.at(i).state(NOMINAL_BARO_BIAS) = state(NOMINAL_BARO_BIAS);
+        }
+        return false;
+    }
+
+    // 잔차가 너무 크면 측정 이상으로 보고 버림
+    CovScalar residual = static_cast<CovScalar>(altitude - (state(NOMINAL_BARO_BIAS) - state(2)));
+    const ErrorMatrix P = getCovariance();
+    CovScalar predictedVar = P(POS + 2, POS + 2) + P(BARO_BIAS, BARO_BIAS) - 2 * P(POS + 2, BARO_BIAS) + baroNoise;
+    if (residual * residual > CovScalar(BARO_GATE * BARO_GATE) * predictedVar) {
+        return false;
+    }
+
+    correctWithBaro(altitude);
+
+    // 지연 GPS 재전파 시 다시 적용되도록 보정을 실제로 적용한 최신 스텝에 기록
+    if (!history.empty()) {
+        Snapshot& newest = history.at(history.size() - 1);
+        newest.hasBaro = true;
+        newest.baroAltitude = altitude;
+        saveSnapshot(newest);
+    }
+    return true;
+}
+
+// 기압 고도 보정: z = -pD + b, h = [0 0 -1 ... 1]
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::correctWithBaro(Scalar altitude) {
+    ErrorVector h = ErrorVector::Zero();
+    h(POS + 2) = CovScalar(-1);
+    h(BARO_BIAS) = CovScalar(1);
+    CovScalar residual = static_cast<CovScalar>(altitude - (state(NOMINAL_BARO_BIAS) - state(2)));
+
+    ErrorVector dx = ErrorVector::Zero();
+    scalarUpdate(h, residual, baroNoise, dx);
+    injectError(dx);
+}
+
+// 정지 구간 평균으로 바이어스/자세 초기화
+// 정지 시 비력 f = R^T [0 0 -g] 이므로 f 방향에서 roll/pitch, 크기와 g의 차이에서 중력축 가속도 바이어스를 얻음
+// (정지 상태에서 수평축 가속도 바이어스는 기울기와 구분되지 않으므로 0으로 두고 GPS/기동 중에 추정)
+// 자이로 바이어스 분산은 평균의 분산(노이즈 밀도^2 / duration)으로 줄임
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::seedAtRest(const Vector3& meanAccel, const Vector3& meanGyro, Scalar duration) {
+    if (!isValidValue(meanAccel.norm()) || !isValidValue(meanGyro.norm()) || !(duration > 0)) {
+        return;
+    }
+
+    setTilt(meanAccel);
+    Quaternion attitude(state(6), state(7), state(8), state(9));
+    Matrix3 R = quaternionToRotationMatrix(attitude);
+
+    state.template segment<3>(3).setZero();
+    state.template segment<3>(NOMINAL_GYRO_BIAS) = meanGyro;
+    state.template segment<3>(NOMINAL_ACCEL_BIAS) = meanAccel - R.transpose() * Vector3(0, 0, -Scalar(GRAVITY));
+
+    // 바이어스/자세/속도 블록의 상관을 끊고 분산 재설정
+    ErrorMatrix P = getCovariance();
+    const CovScalar yawVar = P(ATT + 2, ATT + 2);
+    const int seeded[4] = {VEL, ATT, GYRO_BIAS, ACCEL_BIAS};
+    for (int block : seeded) {
+        P.template middleRows<3>(block).setZero();
+        P.template middleCols<3>(block).setZero();
+    }
+    const CovScalar gyroBiasVar = static_cast<CovScalar>(GYRO_NOISE_DENSITY * GYRO_NOISE_DENSITY / duration);
+    const CovScalar accelBiasVar = static_cast<CovScalar>(ACCEL_NOISE_DENSITY * ACCEL_NOISE_DENSITY / duration);
+    P.template block<3, 3>(VEL, VEL) = CovMatrix3::Identity() * static_cast<CovScalar>(ZUPT_NOISE * ZUPT_NOISE);
+    // roll/pitch 오차는 수평축 가속도 바이어스(0.1m/s^2)가 기울기로 보이는 만큼 (약 0.01rad), yaw는 그대로
+    P.template block<3, 3>(ATT, ATT) = CovMatrix3::Identity() * CovScalar(1e-4);
+    P(ATT + 2, ATT + 2) = yawVar;
+    P.template block<3, 3>(GYRO_BIAS, GYRO_BIAS) = CovMatrix3::Identity() * gyroBiasVar;
+    P.template block<3, 3>(ACCEL_BIAS, ACCEL_BIAS) = CovMatrix3::Identity() * CovScalar(0.01);
+    P(ACCEL_BIAS + 2, ACCEL_BIAS + 2) = accelBiasVar;
+    covariance = (covarianceForm == CovarianceForm::UD) ? factorUD(P) : P;
+
+    history.clear();
+}
+
+// 정지 시 비력 방향으로 roll/pitch 설정 (yaw 유지)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::setTilt(const Vector3& specificForce) {
+    Quaternion attitude(state(6), state(7), state(8), state(9));
+    Matrix3 R = quaternionToRotationMatrix(attitude.normalized());
+    Scalar yaw = std::atan2(R(1, 0), R(0, 0));
+    Scalar roll = std::atan2(-specificForce.y(), -specificForce.z());
+    Scalar pitch = std::atan2(specificForce.x(), std::sqrt(specificForce.y() * specificForce.y() + specificForce.z() * specificForce.z()));
+
+    attitude = Eigen::AngleAxis<Scalar>(yaw, Vector3::UnitZ())
+             * Eigen::AngleAxis<Scalar>(pitch, Vector3::UnitY())
+             * Eigen::AngleAxis<Scalar>(roll, Vector3::UnitX());
     state(6) = attitude.w();
-    state.segment<3>(7) = attitude.vec();
+    state.template segment<3>(7) = attitude.vec();
+}
+
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::setBiases(const Vector3& gyroBias, const Vector3& accelBias) {
+    state.template segment<3>(NOMINAL_GYRO_BIAS) = gyroBias;
+    state.template segment<3>(NOMINAL_ACCEL_BIAS) = accelBias;
+    history.clear();
+}
+
+template <typename Scalar, typename CovScalar>
+typename BasicEKF<Scalar, CovScalar>::Vector3 BasicEKF<Scalar, CovScalar>::getGyroBias() const {
+    return state.template segment<3>(NOMINAL_GYRO_BIAS);
+}
+
+template <typename Scalar, typename CovScalar>
+typename BasicEKF<Scalar, CovScalar>::Vector3 BasicEKF<Scalar, CovScalar>::getAccelBias() const {
+    return state.template segment<3>(NOMINAL_ACCEL_BIAS);
+}
+
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::alignTilt(const Vector3& accel) {
+    if (!isValidValue(accel.norm())) {
+        return;
+    }
+    setTilt(accel - state.template segment<3>(NOMINAL_ACCEL_BIAS));
+    history.clear();
+}
+
+// 영속도 업데이트 (측정 시각 기준으로 ZUPT_MIN_INTERVAL_NS마다 한 번)
+template <typename Scalar, typename CovScalar>
+bool BasicEKF<Scalar, CovScalar>::updateZeroVelocity(uint64_t timeNs) {
+    if (lastZeroVelocityNs != 0 && timeNs < lastZeroVelocityNs + ZUPT_MIN_INTERVAL_NS) {
+        return false;
+    }
+    lastZeroVelocityNs = timeNs;
+    correctWithZeroVelocity();
+
+    // 지연 GPS 재전파 시 다시 적용되도록 최신 스텝에 기록
+    if (!history.empty() && history.newestTime() <= timeNs) {
+        Snapshot& newest = history.at(history.size() - 1);
+        newest.hasZeroVelocity = true;
+        saveSnapshot(newest);
+    }
+    return true;
+}
+
+// 속도 3성분을 0으로 관측 (자세/가속도 바이어스는 속도와의 상관을 통해 보정됨)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::correctWithZeroVelocity() {
+    ErrorVector dx = ErrorVector::Zero();
+    for (int i = 0; i < 3; ++i) {
+        scalarUpdate(VEL + i, static_cast<CovScalar>(-state(3 + i)), static_cast<CovScalar>(ZUPT_NOISE * ZUPT_NOISE), dx);
+    }
+    injectError(dx);
+}
+
+template <typename Scalar, typename CovScalar>
+typename BasicEKF<Scalar, CovScalar>::ErrorMatrix BasicEKF<Scalar, CovScalar>::getCovariance() const {
+    if (covarianceForm == CovarianceForm::UD) {
+        return expandUD(covariance);
+    }
+    return covariance;
+}
+
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::setGpsNoise(CovScalar positionVar, CovScalar velocityVar) {
+    measurementNoise.setZero();
+    measurementNoise.template block<3, 3>(0, 0) = CovMatrix3::Identity() * positionVar;
+    measurementNoise.template block<3, 3>(3, 3) = CovMatrix3::Identity() * velocityVar;
+}
+
+// 공분산 표현 전환 (히스토리의 스냅샷은 이전 표현이므로 비움)
+template <typename Scalar, typename CovScalar>
+void BasicEKF<Scalar, CovScalar>::setCovarianceForm(CovarianceForm form) {
+    if (form == covarianceForm) {
+        return;
+    }
+    if (form == CovarianceForm::UD) {
+        covariance = factorUD(covariance);
+    } else {
+        covariance = expandUD(covariance);
+    }
+    covarianceForm = form;
+    history.clear();
 }
 
 // 현재 상태 반환 함수
-Eigen::VectorXf EKF::getState() const {
-    Eigen::VectorXf stateOut(10);
+template <typename Scalar, typename CovScalar>
+typename BasicEKF<Scalar, CovScalar>::OutputVector BasicEKF<Scalar, CovScalar>::getState() const {
+    OutputVector stateOut(10);
 
-    stateOut.segment<3>(0) = state.segment<3>(0);
-    stateOut.segment<3>(3) = state.segment<3>(3);
+    stateOut.template segment<3>(0) = state.template segment<3>(0);
+    stateOut.template segment<3>(3) = state.template segment<3>(3);
     stateOut(6) = state(6);
-    stateOut.segment<3>(7) = state.segment<3>(7);
+    stateOut.template segment<3>(7) = state.template segment<3>(7);
 
     return stateOut;
-}
\ No newline at end of file
+}
+
+// 명시적 인스턴스화 (ekf.h의 typedef와 일치)
+template class BasicEKF<float>;
+template class BasicEKF<double>;
+template class BasicEKF<double, float>;
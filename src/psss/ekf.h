@@ -1,34 +1,188 @@
-// 쿼터니언 사용
+// 쿼터니언 사용, 오차 상태(error-state) EKF
+// 공칭 상태는 쿼터니언으로 적분하고 공분산은 16차원 오차 상태로 전파
+// 좌표계: 월드 NED, 동체 FRD (VN-100 출력 기준, 정지 시 accelZ ≈ -g)
+// Scalar: 공칭 상태/입력 정밀도, CovScalar: 공분산 정밀도 (예: double 상태 + float 공분산)
 #ifndef EKF_H
 #define EKF_H
 
 #include <Eigen/Dense>
+#include <cstdint>
+#include "sensor_history.h"
 
-class EKF {
+template <typename Scalar, typename CovScalar = Scalar>
+class BasicEKF {
 public:
-    EKF();
-    ~EKF();
+    static constexpr int STATE_SIZE = 17;       // 공칭 상태: 위치 3, 속도 3, 자세 4, 자이로 바이어스 3, 가속도 바이어스 3, 기압 바이어스 1
+    static constexpr int ERROR_SIZE = 16;       // 오차 상태: 위치 3, 속도 3, 자세 오차 3, 자이로 바이어스 3, 가속도 바이어스 3, 기압 바이어스 1
+    static constexpr size_t HISTORY_SIZE = 128; // 400Hz 기준 약 320ms의 과거 상태 보관
+    static constexpr int GPS_PER_STEP = 2;      // 예측 스텝 하나에 기록하는 GPS 측정 수 (사전 적분 묶음 안에 두 개가 들어올 수 있음)
+
+    // 오차 상태 인덱스
+    static constexpr int POS = 0;
+    static constexpr int VEL = 3;
+    static constexpr int ATT = 6;
+    static constexpr int GYRO_BIAS = 9;
+    static constexpr int ACCEL_BIAS = 12;
+    static constexpr int BARO_BIAS = 15;
+
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+    typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+    typedef Eigen::Quaternion<Scalar> Quaternion;
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> OutputVector;
+    typedef Eigen::Matrix<Scalar, STATE_SIZE, 1> StateVector;
+    typedef Eigen::Matrix<CovScalar, ERROR_SIZE, 1> ErrorVector;
+    typedef Eigen::Matrix<CovScalar, ERROR_SIZE, ERROR_SIZE> ErrorMatrix;
+
+    // 공분산 표현: P 직접 저장 또는 P = U D U^T (U 단위 상삼각, D 대각) 인수분해 저장
+    enum class CovarianceForm { Standard, UD };
+
+    // 자기장 융합 방식: 3축 벡터 또는 방위(yaw)만
+    enum class MagMode { ThreeAxis, Heading };
+
+    BasicEKF();
+    ~BasicEKF();
+
+    // timeNs를 주면 예측 결과를 히스토리에 기록하여 지연 측정 융합에 사용
+    void predict(const Vector3& accel, const Vector3& gyro, Scalar dt, uint64_t timeNs = 0);
+    // 첫 GPS 수신 시 위치/속도를 측정값으로 직접 설정 (속도 mm/s, 공분산은 초기값 유지)
+    void initializeWithGPS(const Vector3& gpsPos, const Vector3& gpsVel);
+    void updateWithGPS(const Vector3& gpsPos, const Vector3& gpsVel);
+    // 측정 시각(timeNs)의 과거 상태에 GPS를 적용하고 현재까지 재전파
+    // timeNs는 수신 시각이 아니라 항법 해 시각을 predict와 같은 CLOCK_MONOTONIC으로 옮긴 값이어야 함
+    // (pose_estimator는 GpsTimeAligner로 iTOW와 수신 시각에서 추정, 남는 가정은 수신기의 최소 출력 지연뿐)
+    // 히스토리보다 오래된 측정, 같은 스텝에 이미 GPS_PER_STEP개가 기록된 측정은 버리고 false 반환 (droppedGps로 집계)
+    bool updateWithGPS(const Vector3& gpsPos, const Vector3& gpsVel, uint64_t timeNs);
+    // 자기장 업데이트 (측정 시각 기준 최대 20Hz, 세기가 모델과 다르면 버림), 적용 시 true
+    bool updateWithMag(const Vector3& mag, uint64_t timeNs);
+    // 지구 자기장 모델 (편각/복각 rad, 세기는 센서 단위, 0이면 세기 검사 안 함)
+    void setMagneticField(Scalar declinationRad, Scalar inclinationRad, Scalar strength);
+    void setMagMode(MagMode mode) { magMode = mode; }
+    // 기압 고도 업데이트 (m, 위쪽 +). 측정 = -pD + 기압 바이어스, 첫 호출은 바이어스 초기화만 하고 false
+    // 기압 지연은 예측 주기보다 짧다고 보고 현재 상태에 적용 (최신 스텝에 기록하여 지연 GPS 재전파 시 다시 적용)
+    bool updateWithBaro(Scalar altitude);
+    // 다음 기압 측정에서 바이어스를 다시 초기화 (긴 기압 중단 뒤 현재 고도 기준으로 다시 잡을 때)
+    void resetBaroBias() { baroInitialized = false; }
+    // false이면 GPS 수직 위치를 융합하지 않음 (수평 위치/속도는 그대로 사용)
+    void setGpsAltitudeFusion(bool enabled) { gpsAltitudeFusion = enabled; }
+    void setBaroNoise(CovScalar altitudeVar) { baroNoise = altitudeVar; }
+    // 정지 구간 평균 입력(duration초)으로 자이로/가속도 바이어스와 roll/pitch를 바로 설정 (yaw 유지, 히스토리 비움)
+    void seedAtRest(const Vector3& meanAccel, const Vector3& meanGyro, Scalar duration);
+    // 저장된 캘리브레이션으로 바이어스 설정 (공분산 유지), 현재 추정 바이어스 조회
+    void setBiases(const Vector3& gyroBias, const Vector3& accelBias);
+    Vector3 getGyroBias() const;
+    Vector3 getAccelBias() const;
+    // 바이어스를 보정한 비력 한 샘플로 roll/pitch 정렬 (yaw 유지, 정지 상태 가정)
+    void alignTilt(const Vector3& accel);
+    // 정지 중 영속도 업데이트 (측정 시각 기준 최대 20Hz), 적용 시 true
+    bool updateZeroVelocity(uint64_t timeNs);
+    OutputVector getState() const;
+    ErrorMatrix getCovariance() const;  // UD 형태에서는 U D U^T로 복원한 값
+
+    // true(기본): 측정 성분별 스칼라 순차 업데이트, false: 6x6 S 역행렬을 쓰는 밀집 업데이트
+    // UD 형태에서는 항상 스칼라(Bierman) 업데이트 사용
+    void setSequentialUpdate(bool enabled) { sequentialUpdate = enabled; }
+
+    // UD: 단정밀도에서도 P의 양의 정부호성이 유지되는 인수분해 전파/업데이트 (지연 측정 히스토리는 비워짐)
+    void setCovarianceForm(CovarianceForm form);
+    CovarianceForm getCovarianceForm() const { return covarianceForm; }
+
+    // GPS 측정 노이즈 분산 (위치 m^2, 속도 (m/s)^2)
+    void setGpsNoise(CovScalar positionVar, CovScalar velocityVar);
+
+    // 마지막 지연 업데이트에서 재전파한 스텝 수 (벤치마크용)
+    size_t lastReplaySteps() const { return replaySteps; }
+    // 한 스텝에 GPS_PER_STEP개를 넘게 들어와 버린 지연 GPS 측정 수
+    uint64_t droppedGps() const { return droppedGpsCount; }
 
-    void predict(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, float dt);
-    void updateWithGPS(const Eigen::Vector3f& gpsPos, const Eigen::Vector3f& gpsVel);
-    void updateWithMag(const Eigen::Vector3f& mag);  // 자기장 업데이트 함수
-    Eigen::VectorXf getState() const;
 private:
-    Eigen::VectorXf state;  // 상태 벡터 (위치 3, 속도 3, 자세 4)
-    Eigen::MatrixXf covariance;  // 오차 공분산 행렬
-    Eigen::MatrixXf processNoise;  // 프로세스 노이즈 행렬
-    Eigen::MatrixXf measurementNoise;  // 측정 노이즈 행렬
-    Eigen::MatrixXf jacobian;  // Jacobian 행렬
+    typedef Eigen::Matrix<CovScalar, 3, 3> CovMatrix3;
+
+    // 예측 스텝 하나의 입력과 그 결과 상태
+    struct Snapshot {
+        StateVector state;
+        ErrorMatrix covariance;
+        Vector3 accel;              // 이 시점까지 전파하는 데 사용한 입력
+        Vector3 gyro;
+        Scalar dt;
+        int gpsCount;               // 이 구간 안에서 적용된 GPS 측정 수 (측정 시각 순)
+        uint64_t gpsTimeNs[GPS_PER_STEP];
+        Vector3 gpsPos[GPS_PER_STEP];
+        Vector3 gpsVel[GPS_PER_STEP];
+        bool hasMag;                // 이 스텝 끝에 적용된 자기장 측정
+        Vector3 mag;
+        bool hasBaro;               // 이 스텝 끝에 적용된 기압 고도 측정
+        Scalar baroAltitude;
+        bool hasZeroVelocity;       // 이 스텝 끝에 적용된 영속도 측정
+    };
+
+    // 상태 천이 행렬 F에서 단위/0이 아닌 블록
+    //     | I  I*dt  0     0     0     0 |
+    //     | 0  I     Fva   0     Fvb   0 |
+    // F = | 0  0     Faa   -I*dt 0     0 |
+    //     | 0  0     0     I     0     0 |
+    //     | 0  0     0     0     I     0 |
+    //     | 0  0     0     0     0     1 |
+    struct TransitionBlocks {
+        CovScalar dt;
+        CovMatrix3 velAtt;   // Fva = -R [a]x dt
+        CovMatrix3 velBias;  // Fvb = -R dt
+        CovMatrix3 attAtt;   // Faa = exp(-[w]x dt)
+    };
 
-    Eigen::Vector3f accelLast;  // 마지막 가속도 값
-    Eigen::Vector3f gyroLast;   // 마지막 자이로 값 (저주파 필터에 사용)
+    StateVector state;  // 공칭 상태 벡터
+    ErrorMatrix covariance;  // 오차 상태 공분산 행렬 (UD 형태: 대각 = D, 상삼각 = U)
+    Eigen::Matrix<CovScalar, 6, 6> measurementNoise;  // 측정 노이즈 행렬
+    TransitionBlocks jacobian;  // 블록 희소 Jacobian
 
-    Eigen::Matrix3f quaternionToRotationMatrix(const Eigen::Quaternionf& q) const;
-    void computeJacobian(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, float dt);  
-    void predictState(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, float dt);
-    Eigen::Matrix3f skewSymmetric(const Eigen::Vector3f& v);
+    SensorHistory<Snapshot, HISTORY_SIZE> history;  // 고정 크기, 동적 할당 없음
+    size_t replaySteps = 0;
+    uint64_t droppedGpsCount = 0;
+    bool sequentialUpdate = true;
+    CovarianceForm covarianceForm = CovarianceForm::Standard;
 
-    Eigen::Vector3f lowPassFilter(const Eigen::Vector3f& input, const Eigen::Vector3f& last, float alpha);
+    Vector3 magField;           // NED 단위 벡터
+    Scalar magDeclination;
+    Scalar magStrength;
+    MagMode magMode = MagMode::ThreeAxis;
+    uint64_t lastMagNs = 0;
+
+    bool baroInitialized = false;
+    bool gpsAltitudeFusion = true;
+    CovScalar baroNoise;        // 기압 고도 측정 분산 (m^2)
+    uint64_t lastZeroVelocityNs = 0;
+
+    Matrix3 quaternionToRotationMatrix(const Quaternion& q) const;
+    void propagate(const Vector3& accel, const Vector3& gyro, Scalar dt);
+    void computeJacobian(const Vector3& accel, const Vector3& gyro, Scalar dt);
+    void predictState(const Vector3& accel, const Vector3& gyro, Scalar dt);
+    void propagateCovariance(Scalar dt);
+    void propagateUD(Scalar dt);
+    ErrorVector processNoise(Scalar dt) const;
+    void applyTransition(ErrorMatrix& m) const;
+    void injectError(const ErrorVector& dx);
+    void correctWithGPS(const Vector3& gpsPos, const Vector3& gpsVel);
+    void correctWithGPSDense(const Vector3& gpsPos, const Vector3& gpsVel);
+    void correctWithMag(const Vector3& mag);
+    void correctWithBaro(Scalar altitude);
+    void correctWithZeroVelocity();
+    void setTilt(const Vector3& specificForce);
+    void scalarUpdate(int index, CovScalar residual, CovScalar variance, ErrorVector& dx);
+    void scalarUpdate(const ErrorVector& h, CovScalar residual, CovScalar variance, ErrorVector& dx);
+    void scalarUpdateUD(const ErrorVector& h, CovScalar residual, CovScalar variance, ErrorVector& dx);
+    bool recordGps(Snapshot& step, uint64_t timeNs, const Vector3& gpsPos, const Vector3& gpsVel);
+    void replayStep(uint64_t startNs, const Snapshot& step);
+    void saveSnapshot(Snapshot& snap) const;
+    void restoreSnapshot(const Snapshot& snap);
+    Matrix3 skewSymmetric(const Vector3& v) const;
 };
 
-#endif
\ No newline at end of file
+// 정의는 ekf.cpp, 아래 조합만 명시적 인스턴스화
+extern template class BasicEKF<float>;
+extern template class BasicEKF<double>;
+extern template class BasicEKF<double, float>;
+
+typedef BasicEKF<float> EKF;                 // 기본 (기존 float 필터)
+typedef BasicEKF<double> EKFd;               // 전체 double
+typedef BasicEKF<double, float> EKFMixed;    // double 상태 + float 공분산
+
+#endif
@@ -2,6 +2,7 @@
 #include "../ioss/rc_input.h"
 #include "../ioss/gps_sensor.h"
 #include "../ioss/imu_sensor.h"
+#include "../ioss/barometer_sensor.h"
 #include <iostream>
 #include <termios.h>
 
@@ -9,15 +10,19 @@
 void flight_control_init() {
     // RC 초기화
     std::cout << "Initializing RC input..." << std::endl;
-    initRC("/dev/ttyAMA0", B115200);
+    initRC(RC_PORT, B115200);
 
     // GPS 초기화
     std::cout << "Initializing GPS..." << std::endl;
-    initGPS("/dev/ttyUSB1", B115200);  // GPS 포트 및 보드레이트 설정
+    initGPS(GPS_PORT, B115200);  // GPS 포트 및 보드레이트 설정
 
     // IMU 초기화
     std::cout << "Initializing IMU..." << std::endl;
-    initIMU("/dev/ttyUSB0", B115200);  // IMU 포트 및 보드레이트 설정
+    initIMU(IMU_PORT, B115200);  // IMU 포트 및 보드레이트 설정
+
+    // 기압 센서 초기화
+    std::cout << "Initializing barometer..." << std::endl;
+    initBarometer(BARO_PORT, B9600);  // GY-39 기본 보드레이트
 
     std::cout << "Flight control system initialized." << std::endl;
 }
@@ -1,6 +1,12 @@
 #ifndef FLIGHT_CONTROL_H
 #define FLIGHT_CONTROL_H
 
+// 장치 포트 (모의 전송 모드에서는 같은 이름의 pty)
+const char* const RC_PORT = "/dev/ttyAMA0";
+const char* const GPS_PORT = "/dev/ttyUSB1";
+const char* const IMU_PORT = "/dev/ttyUSB0";
+const char* const BARO_PORT = "/dev/ttyAMA1";   // RC가 ttyAMA0을 사용하므로 두 번째 UART
+
 // 모든 장치를 초기화하는 함수
 void flight_control_init();
 
@@ -0,0 +1,60 @@
+#include "geodetic.h"
+#include <cmath>
+
+// WGS-84 타원체
+const double WGS84_A = 6378137.0;                 // 장반경 (m)
+const double WGS84_F = 1.0 / 298.257223563;       // 편평률
+const double WGS84_E2 = WGS84_F * (2.0 - WGS84_F); // 이심률 제곱
+const double DEG_TO_RAD = M_PI / 180.0;
+
+Eigen::Vector3d geodeticToEcef(double latRad, double lonRad, double altM) {
+    double sinLat = std::sin(latRad);
+    double cosLat = std::cos(latRad);
+    double n = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sinLat * sinLat);
+    return Eigen::Vector3d((n + altM) * cosLat * std::cos(lonRad),
+                           (n + altM) * cosLat * std::sin(lonRad),
+                           (n * (1.0 - WGS84_E2) + altM) * sinLat);
+}
+
+// 원점의 곡률 반경과 ECEF → NED 회전 행렬을 미리 계산
+void LocalFrame::setOrigin(double latDeg, double lonDeg, double altM) {
+    lat0 = latDeg * DEG_TO_RAD;
+    lon0 = lonDeg * DEG_TO_RAD;
+    alt0 = altM;
+    sinLat0 = std::sin(lat0);
+    cosLat0 = std::cos(lat0);
+
+    double w = 1.0 - WGS84_E2 * sinLat0 * sinLat0;
+    double n = WGS84_A / std::sqrt(w);
+    double m = WGS84_A * (1.0 - WGS84_E2) / (w * std::sqrt(w));
+    northRadius = m + altM;
+    eastRadius = n + altM;
+
+    double sinLon0 = std::sin(lon0);
+    double cosLon0 = std::cos(lon0);
+    originEcef = geodeticToEcef(lat0, lon0, altM);
+    ecefToNed << -sinLat0 * cosLon0, -sinLat0 * sinLon0,  cosLat0,
+                 -sinLon0,            cosLon0,            0.0,
+                 -cosLat0 * cosLon0, -cosLat0 * sinLon0, -sinLat0;
+    originSet = true;
+}
+
+// 원점 주변 2차 근사
+//   북: 자오선 호 길이 + 경도 차에 의한 수렴 항
+//   동: 원점 위도의 평행권 호 길이 - 위도 변화에 따른 평행권 반경 감소
+//   하: 고도 차 + 지구 곡률에 의한 접평면 이탈 (d^2 / 2R)
+// 고도 차에 의한 반경 변화(dh)는 1차 항만 반영
+Eigen::Vector3d LocalFrame::toNEDd(double latDeg, double lonDeg, double altM) const {
+    double dLat = latDeg * DEG_TO_RAD - lat0;
+    double dLon = lonDeg * DEG_TO_RAD - lon0;
+    double dAlt = altM - alt0;
+
+    double north = dLat * (northRadius + dAlt) + 0.5 * dLon * dLon * eastRadius * sinLat0 * cosLat0;
+    double east = dLon * (eastRadius + dAlt) * cosLat0 - dLon * dLat * eastRadius * sinLat0;
+    double down = -dAlt + 0.5 * (north * north / northRadius + east * east / eastRadius);
+    return Eigen::Vector3d(north, east, down);
+}
+
+Eigen::Vector3d LocalFrame::toNEDExact(double latDeg, double lonDeg, double altM) const {
+    return ecefToNed * (geodeticToEcef(latDeg * DEG_TO_RAD, lonDeg * DEG_TO_RAD, altM) - originEcef);
+}
@@ -0,0 +1,37 @@
+// WGS-84 측지 좌표(위도/경도/타원체고) → 홈 원점 기준 로컬 NED 변환
+// 원점의 곡률 반경과 삼각함수 값을 미리 계산해 두고 GPS 수신마다 O(1) 근사 변환 (삼각함수 호출 없음)
+// 내부 계산은 double (1e-7도 = 약 1cm 이므로 float로는 위도/경도 차이를 표현할 수 없음), 출력은 EKF용 float
+#ifndef GEODETIC_H
+#define GEODETIC_H
+
+#include <Eigen/Dense>
+
+class LocalFrame {
+public:
+    // 홈 원점 설정 (도, 도, m)
+    void setOrigin(double latDeg, double lonDeg, double altM);
+    bool hasOrigin() const { return originSet; }
+
+    // 빠른 변환: 원점 주변 2차 근사 (수 km 이내 cm 수준, 벤치마크 참고)
+    Eigen::Vector3d toNEDd(double latDeg, double lonDeg, double altM) const;
+    Eigen::Vector3f toNED(double latDeg, double lonDeg, double altM) const {
+        return toNEDd(latDeg, lonDeg, altM).cast<float>();
+    }
+
+    // 기준 변환: LLA → ECEF → 원점 기준 NED 회전 (검증/비교용)
+    Eigen::Vector3d toNEDExact(double latDeg, double lonDeg, double altM) const;
+
+private:
+    bool originSet = false;
+    double lat0 = 0, lon0 = 0, alt0 = 0;  // rad, rad, m
+    double sinLat0 = 0, cosLat0 = 1;
+    double northRadius = 0;   // (M + h0), 자오선 곡률 반경 + 원점 고도
+    double eastRadius = 0;    // (N + h0), 묘유선 곡률 반경 + 원점 고도
+    Eigen::Vector3d originEcef = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d ecefToNed = Eigen::Matrix3d::Identity();
+};
+
+// WGS-84 위도/경도/타원체고 → ECEF (rad, rad, m)
+Eigen::Vector3d geodeticToEcef(double latRad, double lonRad, double altM);
+
+#endif
@@ -0,0 +1,55 @@
+// GPS 측정 시각 추정
+// NAV-PVT의 iTOW는 항법 해의 시각(GPS 시계), 수신 시각은 CLOCK_MONOTONIC
+// 수신 시각 - iTOW = 두 시계의 차이 + 출력 지연 이므로, 최근 창의 최솟값을 가장 빨리 온 메시지(최소 지연)로 보고
+//   측정 시각 = iTOW + (최솟값 - 최소 출력 지연)
+// 지연의 변동(항법 주기, 수신기 부하)은 iTOW로 따라가고, 가정하는 값은 수신기의 최소 출력 지연 하나뿐
+// 주 넘김(iTOW가 0으로 돌아감)이나 시계 점프로 차이가 크게 바뀌면 창을 비우고 다시 시작
+#ifndef GPS_TIME_ALIGNER_H
+#define GPS_TIME_ALIGNER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class GpsTimeAligner {
+public:
+    static constexpr size_t WINDOW = 32;                        // 10Hz 기준 3.2초 (시계 드리프트는 무시할 수 있는 길이)
+    static constexpr int64_t RESET_JUMP_NS = 1000000000LL;      // 이보다 크게 바뀌면 새 기준으로 다시 시작
+
+    // minDelayNs: 수신기의 최소 출력 지연 (항법 해 시각 → 메시지 마지막 바이트 수신), 수신기/항법 주기마다 설정
+    explicit GpsTimeAligner(uint64_t minDelayNs) : minDelay(static_cast<int64_t>(minDelayNs)) {}
+
+    void setMinDelay(uint64_t minDelayNs) { minDelay = static_cast<int64_t>(minDelayNs); }
+
+    // 수신 시각(ns)과 iTOW(ms)로 측정 시각(CLOCK_MONOTONIC ns)을 추정, 수신 시각을 넘지 않음
+    uint64_t measurementTime(uint64_t receiveNs, uint32_t iTOW) {
+        int64_t gpsNs = static_cast<int64_t>(iTOW) * 1000000LL;
+        int64_t offset = static_cast<int64_t>(receiveNs) - gpsNs;
+        if (count > 0 && (offset - minOffset > RESET_JUMP_NS || minOffset - offset > RESET_JUMP_NS)) {
+            count = 0;
+            next = 0;
+        }
+        offsets[next] = offset;
+        next = (next + 1) % WINDOW;
+        count = count < WINDOW ? count + 1 : WINDOW;
+
+        minOffset = offset;
+        for (size_t i = 0; i < count; ++i) {
+            minOffset = offsets[i] < minOffset ? offsets[i] : minOffset;
+        }
+        int64_t measured = gpsNs + minOffset - minDelay;
+        if (measured < 0 || measured > static_cast<int64_t>(receiveNs)) {
+            return receiveNs;
+        }
+        return static_cast<uint64_t>(measured);
+    }
+
+private:
+    std::array<int64_t, WINDOW> offsets{};
+    size_t next = 0;
+    size_t count = 0;
+    int64_t minOffset = 0;
+    int64_t minDelay;
+};
+
+#endif
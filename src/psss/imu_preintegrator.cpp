@@ -0,0 +1,48 @@
+#include "imu_preintegrator.h"
+
+void ImuPreintegrator::reset() {
+    alpha.setZero();
+    beta.setZero();
+    velocity.setZero();
+    sculling.setZero();
+    lastAlpha.setZero();
+    lastVelocity.setZero();
+    lastMag.setZero();
+    totalDt = 0.0f;
+    samples = 0;
+}
+
+// 이번 샘플 증분 da = w dt, dv = a dt 에 대해
+//   coning:   beta += 1/2 (alpha + da_prev / 6) x da
+//   sculling: s    += 1/2 ((alpha + da_prev / 6) x dv + (v + dv_prev / 6) x da)
+// alpha, v 는 이번 샘플 이전까지의 누적값
+void ImuPreintegrator::add(const ImuSample& sample, float dt) {
+    if (!(dt > 0.0f)) {
+        return;
+    }
+    Eigen::Vector3f da = sample.gyro * dt;
+    Eigen::Vector3f dv = sample.accel * dt;
+
+    Eigen::Vector3f angle = alpha + lastAlpha * (1.0f / 6.0f);
+    beta += 0.5f * angle.cross(da);
+    sculling += 0.5f * (angle.cross(dv) + (velocity + lastVelocity * (1.0f / 6.0f)).cross(da));
+
+    alpha += da;
+    velocity += dv;
+    lastAlpha = da;
+    lastVelocity = dv;
+    lastMag = sample.mag;
+    totalDt += dt;
+    ++samples;
+}
+
+bool ImuPreintegrator::average(ImuSample& out) const {
+    if (samples == 0) {
+        return false;
+    }
+    float inv = 1.0f / totalDt;
+    out.gyro = deltaAngle() * inv;
+    out.accel = deltaVelocity() * inv;
+    out.mag = lastMag;
+    return true;
+}
@@ -0,0 +1,43 @@
+// IMU 사전 적분
+// 추정 스텝 사이에 들어온 샘플을 배치 시작 동체 좌표 기준 각도 증분/속도 증분 하나로 합침
+// 각 샘플은 dt 동안 일정하다고 보고 coning(자세)과 sculling(속도) 보정을 재귀식으로 누적 (Ignagni, Savage)
+// 결과는 평균 입력(증분 / 구간 길이)으로 바꾸어 EKF::predict 한 번으로 전파
+//   predictState가 exp(gyro dt)로 회전하고 시작 자세로 속도를 적분하므로 증분이 그대로 재현됨
+#ifndef IMU_PREINTEGRATOR_H
+#define IMU_PREINTEGRATOR_H
+
+#include <Eigen/Dense>
+#include "sensor_history.h"
+
+class ImuPreintegrator {
+public:
+    ImuPreintegrator() { reset(); }
+
+    // 샘플 하나 누적 (dt: 이전 샘플부터 이 샘플까지 초)
+    void add(const ImuSample& sample, float dt);
+    void reset();
+
+    int count() const { return samples; }
+    float duration() const { return totalDt; }
+
+    // 배치 시작 동체 좌표 기준 회전 벡터 (coning 보정 포함)
+    Eigen::Vector3f deltaAngle() const { return alpha + beta; }
+    // 배치 시작 동체 좌표 기준 속도 증분 (회전 보정 + sculling 보정 포함, 중력 제외)
+    Eigen::Vector3f deltaVelocity() const { return velocity + 0.5f * alpha.cross(velocity) + sculling; }
+
+    // 증분을 같은 효과의 평균 입력으로 변환 (자기장은 마지막 샘플), 샘플이 없으면 false
+    bool average(ImuSample& out) const;
+
+private:
+    Eigen::Vector3f alpha;       // 각속도 적분
+    Eigen::Vector3f beta;        // coning 보정 누적
+    Eigen::Vector3f velocity;    // 비력 적분
+    Eigen::Vector3f sculling;    // sculling 보정 누적
+    Eigen::Vector3f lastAlpha;   // 직전 샘플 증분
+    Eigen::Vector3f lastVelocity;
+    Eigen::Vector3f lastMag;
+    float totalDt;
+    int samples;
+};
+
+#endif
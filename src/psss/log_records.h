@@ -0,0 +1,171 @@
+// 바이너리 로그 레코드 종류와 payload (../oss/binary_logger.h)
+// payload는 LogRecord::PAYLOAD_SIZE(48바이트) 이하의 고정 크기 구조체
+// 종류를 추가하면 LOG_SCHEMAS에도 필드를 적어야 변환 도구(log_convert)가 읽을 수 있음
+#ifndef LOG_RECORDS_H
+#define LOG_RECORDS_H
+
+#include "../oss/binary_logger.h"
+#include "../oss/perf_counters.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+enum LogType : uint16_t {
+    LOG_POSE = 1,       // PoseLog
+    LOG_LATENCY = 2,    // LatencyLog
+    LOG_MOTOR = 3,      // MotorLog
+    LOG_IMU = 4,        // ImuLog
+    LOG_GPS = 5,        // GpsLog
+    LOG_LOOP = 6,       // LoopLog
+    LOG_PERF = 7,       // PerfLog
+};
+
+// 추정 자세 (main 루프)
+struct PoseLog {
+    float position[3];      // NED (m)
+    float velocity[3];      // NED (m/s)
+    float euler[3];         // roll, pitch, yaw (deg)
+    uint32_t ready;         // PoseEstimator::isReady()
+    uint32_t faults;        // PoseEstimator::getFaults() (PoseFault 비트)
+};
+
+// 단계별 지연 (평균/최대 ms)
+struct LatencyLog {
+    float meanMs[5];        // imuIngest, imuFusion, gpsFusion, baroFusion, poseOutput
+    float maxMs[5];
+};
+
+// 모터 출력 (motor_control 테스트 루프)
+struct MotorLog {
+    int32_t throttle;
+    int32_t motor[4];
+};
+
+// IMU 샘플 (추정기 입력, 온도 보정 후)
+struct ImuLog {
+    uint64_t rxTimeNs;      // 수신 시각 (레코드 시각은 기록 시각)
+    float accel[3];         // m/s^2
+    float gyro[3];          // rad/s
+    float mag[3];           // gauss
+};
+
+// GPS NAV-PVT
+struct GpsLog {
+    uint64_t rxTimeNs;
+    int32_t latitude;       // 1e-7 deg
+    int32_t longitude;      // 1e-7 deg
+    int32_t altitude;       // mm
+    int32_t velocity[3];    // NED mm/s
+    uint32_t iTOW;          // ms
+    uint32_t numSV;
+};
+
+// 주기 태스크 타이밍 (main 루프가 5초마다 루프별로 기록, 누적값)
+struct LoopLog {
+    char name[12];
+    uint32_t overruns;
+    uint64_t iterations;
+    float periodMeanMs;
+    float periodP99Ms;
+    float periodMaxMs;
+    float execMeanMs;
+    float execP99Ms;
+    float execMaxMs;
+};
+
+// 성능 카운터 구간 (--perf일 때 5초마다 구간별로 기록, 누적 측정당 평균)
+struct PerfLog {
+    char name[12];
+    uint32_t available;     // 열린 카운터 (PerfCounter 비트, 없는 카운터의 값은 0)
+    uint64_t samples;
+    float cycles;
+    float instructions;
+    float cacheMisses;
+    float branchMisses;
+    float contextSwitches;
+};
+
+inline PerfLog makePerfLog(const PerfRegionSnapshot& region) {
+    PerfLog log = {};
+    std::memcpy(log.name, region.name, sizeof(log.name));
+    log.available = perfCountersAvailable();
+    log.samples = region.samples;
+    log.cycles = static_cast<float>(region.mean(PERF_CYCLES));
+    log.instructions = static_cast<float>(region.mean(PERF_INSTRUCTIONS));
+    log.cacheMisses = static_cast<float>(region.mean(PERF_CACHE_MISSES));
+    log.branchMisses = static_cast<float>(region.mean(PERF_BRANCH_MISSES));
+    log.contextSwitches = static_cast<float>(region.mean(PERF_CONTEXT_SWITCHES));
+    return log;
+}
+
+inline const LogField POSE_LOG_FIELDS[] = {
+    {"position", LOG_F32, 3, offsetof(PoseLog, position)},
+    {"velocity", LOG_F32, 3, offsetof(PoseLog, velocity)},
+    {"euler", LOG_F32, 3, offsetof(PoseLog, euler)},
+    {"ready", LOG_U32, 1, offsetof(PoseLog, ready)},
+    {"faults", LOG_U32, 1, offsetof(PoseLog, faults)},
+};
+
+inline const LogField LATENCY_LOG_FIELDS[] = {
+    {"meanMs", LOG_F32, 5, offsetof(LatencyLog, meanMs)},
+    {"maxMs", LOG_F32, 5, offsetof(LatencyLog, maxMs)},
+};
+
+inline const LogField MOTOR_LOG_FIELDS[] = {
+    {"throttle", LOG_I32, 1, offsetof(MotorLog, throttle)},
+    {"motor", LOG_I32, 4, offsetof(MotorLog, motor)},
+};
+
+inline const LogField IMU_LOG_FIELDS[] = {
+    {"rxTimeNs", LOG_U64, 1, offsetof(ImuLog, rxTimeNs)},
+    {"accel", LOG_F32, 3, offsetof(ImuLog, accel)},
+    {"gyro", LOG_F32, 3, offsetof(ImuLog, gyro)},
+    {"mag", LOG_F32, 3, offsetof(ImuLog, mag)},
+};
+
+inline const LogField GPS_LOG_FIELDS[] = {
+    {"rxTimeNs", LOG_U64, 1, offsetof(GpsLog, rxTimeNs)},
+    {"latitude", LOG_I32, 1, offsetof(GpsLog, latitude)},
+    {"longitude", LOG_I32, 1, offsetof(GpsLog, longitude)},
+    {"altitude", LOG_I32, 1, offsetof(GpsLog, altitude)},
+    {"velocity", LOG_I32, 3, offsetof(GpsLog, velocity)},
+    {"iTOW", LOG_U32, 1, offsetof(GpsLog, iTOW)},
+    {"numSV", LOG_U32, 1, offsetof(GpsLog, numSV)},
+};
+
+inline const LogField LOOP_LOG_FIELDS[] = {
+    {"name", LOG_CHAR, 12, offsetof(LoopLog, name)},
+    {"overruns", LOG_U32, 1, offsetof(LoopLog, overruns)},
+    {"iterations", LOG_U64, 1, offsetof(LoopLog, iterations)},
+    {"periodMeanMs", LOG_F32, 1, offsetof(LoopLog, periodMeanMs)},
+    {"periodP99Ms", LOG_F32, 1, offsetof(LoopLog, periodP99Ms)},
+    {"periodMaxMs", LOG_F32, 1, offsetof(LoopLog, periodMaxMs)},
+    {"execMeanMs", LOG_F32, 1, offsetof(LoopLog, execMeanMs)},
+    {"execP99Ms", LOG_F32, 1, offsetof(LoopLog, execP99Ms)},
+    {"execMaxMs", LOG_F32, 1, offsetof(LoopLog, execMaxMs)},
+};
+
+inline const LogField PERF_LOG_FIELDS[] = {
+    {"name", LOG_CHAR, 12, offsetof(PerfLog, name)},
+    {"available", LOG_U32, 1, offsetof(PerfLog, available)},
+    {"samples", LOG_U64, 1, offsetof(PerfLog, samples)},
+    {"cycles", LOG_F32, 1, offsetof(PerfLog, cycles)},
+    {"instructions", LOG_F32, 1, offsetof(PerfLog, instructions)},
+    {"cacheMisses", LOG_F32, 1, offsetof(PerfLog, cacheMisses)},
+    {"branchMisses", LOG_F32, 1, offsetof(PerfLog, branchMisses)},
+    {"contextSwitches", LOG_F32, 1, offsetof(PerfLog, contextSwitches)},
+};
+
+// startLogger에 전달하여 파일에 포함
+inline const LogSchema LOG_SCHEMAS[] = {
+    makeLogSchema(LOG_POSE, "PoseLog", sizeof(PoseLog), POSE_LOG_FIELDS),
+    makeLogSchema(LOG_LATENCY, "LatencyLog", sizeof(LatencyLog), LATENCY_LOG_FIELDS),
+    makeLogSchema(LOG_MOTOR, "MotorLog", sizeof(MotorLog), MOTOR_LOG_FIELDS),
+    makeLogSchema(LOG_IMU, "ImuLog", sizeof(ImuLog), IMU_LOG_FIELDS),
+    makeLogSchema(LOG_GPS, "GpsLog", sizeof(GpsLog), GPS_LOG_FIELDS),
+    makeLogSchema(LOG_LOOP, "LoopLog", sizeof(LoopLog), LOOP_LOG_FIELDS),
+    makeLogSchema(LOG_PERF, "PerfLog", sizeof(PerfLog), PERF_LOG_FIELDS),
+};
+const size_t LOG_SCHEMA_COUNT = sizeof(LOG_SCHEMAS) / sizeof(LOG_SCHEMAS[0]);
+
+#endif
@@ -0,0 +1,151 @@
+#include "mag_calibrator.h"
+#include <cmath>
+#include <algorithm>
+
+// 적합 결과 품질 기준
+const double MAX_RESIDUAL_RMS = 0.05;   // 보정 후 세기 오차 RMS 비율
+const double MAX_AXIS_RATIO = 3.0;      // soft-iron 축 길이 최대/최소 비
+
+int MagCalibrator::cellIndex(const Eigen::Vector3f& direction) const {
+    int band = static_cast<int>((direction.z() + 1.0f) * 0.5f * ELEVATION_BANDS);
+    band = std::min(std::max(band, 0), ELEVATION_BANDS - 1);
+    float azimuth = std::atan2(direction.y(), direction.x());  // -pi ~ pi
+    int bin = static_cast<int>((azimuth + float(M_PI)) * (AZIMUTH_BINS / (2.0f * float(M_PI))));
+    bin = std::min(std::max(bin, 0), AZIMUTH_BINS - 1);
+    return band * AZIMUTH_BINS + bin;
+}
+
+void MagCalibrator::addSample(const Eigen::Vector3f& raw) {
+    if (raw.hasNaN()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(gridMutex);
+    minSample = minSample.cwiseMin(raw);
+    maxSample = maxSample.cwiseMax(raw);
+    if (!centerFromFit) {
+        center = 0.5f * (minSample + maxSample);
+    }
+
+    Eigen::Vector3f d = raw - center;
+    float norm = d.norm();
+    if (norm < 1e-6f) {
+        return;
+    }
+    Cell& cell = grid[cellIndex(d / norm)];
+    cell.sample = raw;
+    cell.used = true;
+}
+
+int MagCalibrator::coveredCells() const {
+    std::lock_guard<std::mutex> lock(gridMutex);
+    int count = 0;
+    for (const Cell& cell : grid) {
+        count += cell.used;
+    }
+    return count;
+}
+
+// 일반 타원체 x^T A x + 2 v^T x = 1 의 9개 계수를 정규방정식(9x9, LDLT)으로 적합
+// 조건수를 줄이기 위해 최소/최대 중점으로 옮기고 반 범위로 나눈 좌표에서 적합한 뒤 되돌림
+// 중심 b = -A^-1 v, 타원체 (x-b)^T (A/k) (x-b) = 1 (k = 1 + b^T A b)
+// soft-iron M = strength * sqrt(A/k) (대칭 제곱근) 이면 |M (x - b)| = strength
+bool MagCalibrator::solve() {
+    std::array<Eigen::Vector3d, CELLS> samples;
+    int count = 0;
+    Eigen::Vector3d shift, scale;
+    {
+        std::lock_guard<std::mutex> lock(gridMutex);
+        for (const Cell& cell : grid) {
+            if (cell.used) {
+                samples[count++] = cell.sample.cast<double>();
+            }
+        }
+        shift = (0.5f * (minSample + maxSample)).cast<double>();
+        scale = (0.5f * (maxSample - minSample)).cast<double>();
+    }
+    if (count < MIN_COVERED_CELLS) {
+        return false;
+    }
+    double s = scale.maxCoeff();
+    if (!(s > 0)) {
+        return false;
+    }
+
+    typedef Eigen::Matrix<double, 9, 1> Row;
+    Eigen::Matrix<double, 9, 9> normal = Eigen::Matrix<double, 9, 9>::Zero();
+    Row rhs = Row::Zero();
+    for (int i = 0; i < count; ++i) {
+        Eigen::Vector3d p = (samples[i] - shift) / s;
+        Row row;
+        row << p.x() * p.x(), p.y() * p.y(), p.z() * p.z(),
+               2 * p.x() * p.y(), 2 * p.x() * p.z(), 2 * p.y() * p.z(),
+               2 * p.x(), 2 * p.y(), 2 * p.z();
+        normal.selfadjointView<Eigen::Lower>().rankUpdate(row);
+        rhs += row;
+    }
+    Row coeff = normal.selfadjointView<Eigen::Lower>().ldlt().solve(rhs);
+
+    Eigen::Matrix3d A;
+    A << coeff(0), coeff(3), coeff(4),
+         coeff(3), coeff(1), coeff(5),
+         coeff(4), coeff(5), coeff(2);
+    Eigen::Vector3d v(coeff(6), coeff(7), coeff(8));
+
+    Eigen::Vector3d b = -A.ldlt().solve(v);
+    double k = 1.0 + b.dot(A * b);
+    if (!(k > 0)) {
+        return false;
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eig(A / k);
+    Eigen::Vector3d lambda = eig.eigenvalues();
+    if (!(lambda.minCoeff() > 0)) {
+        return false;  // 타원체가 아님 (커버리지 부족 등)
+    }
+    Eigen::Vector3d axis = lambda.cwiseSqrt();
+    if (axis.maxCoeff() / axis.minCoeff() > MAX_AXIS_RATIO) {
+        return false;
+    }
+
+    // 원래 좌표로 복원: x = shift + s p
+    Eigen::Matrix3d W = eig.eigenvectors() * axis.asDiagonal() * eig.eigenvectors().transpose() / s;
+    Eigen::Vector3d hardIron = shift + s * b;
+
+    MagCalibration fit;
+    fit.softIron = (strength * W).cast<float>();
+    fit.offset = (-strength * W * hardIron).cast<float>();
+
+    double sq = 0;
+    for (int i = 0; i < count; ++i) {
+        double r = fit.apply(samples[i].cast<float>()).norm() / strength - 1.0;
+        sq += r * r;
+    }
+    fit.residualRms = static_cast<float>(std::sqrt(sq / count));
+    if (fit.residualRms > MAX_RESIDUAL_RMS) {
+        return false;
+    }
+    fit.valid = true;
+
+    {
+        std::lock_guard<std::mutex> lock(gridMutex);
+        center = hardIron.cast<float>();
+        centerFromFit = true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result = fit;
+    }
+    resultVersion.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool MagCalibrator::latest(MagCalibration& out, uint32_t& version) const {
+    uint32_t current = resultVersion.load(std::memory_order_acquire);
+    if (current == version) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(resultMutex);
+    out = result;
+    version = resultVersion.load(std::memory_order_relaxed);
+    return true;
+}
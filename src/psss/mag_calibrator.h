@@ -0,0 +1,65 @@
+// 자기장 hard/soft-iron 타원체 보정
+// 샘플은 방향별 고정 격자(커버리지 격자)에 하나씩 보관하고 (같은 방향은 최신 값으로 덮어씀)
+// 백그라운드 스레드에서 격자 샘플로 타원체를 최소제곱 적합하여 보정값 m = M raw + c 를 갱신
+#ifndef MAG_CALIBRATOR_H
+#define MAG_CALIBRATOR_H
+
+#include <Eigen/Dense>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// 보정 결과 (적용은 3x3 곱셈-덧셈 한 번)
+struct MagCalibration {
+    Eigen::Matrix3f softIron = Eigen::Matrix3f::Identity();  // M
+    Eigen::Vector3f offset = Eigen::Vector3f::Zero();         // c = -M b (b: hard-iron)
+    float residualRms = 0.0f;   // 보정 후 |m| 의 기대 세기 대비 RMS 오차 비율
+    bool valid = false;
+
+    Eigen::Vector3f apply(const Eigen::Vector3f& raw) const { return softIron * raw + offset; }
+};
+
+class MagCalibrator {
+public:
+    static constexpr int ELEVATION_BANDS = 6;   // z 성분 기준 등면적 구간
+    static constexpr int AZIMUTH_BINS = 12;
+    static constexpr int CELLS = ELEVATION_BANDS * AZIMUTH_BINS;
+    static constexpr int MIN_COVERED_CELLS = 36;  // 적합에 필요한 최소 칸 수 (절반)
+
+    // fieldStrength: 보정 후 자기장 세기 (센서 단위, 지역 모델 값)
+    explicit MagCalibrator(float fieldStrength = 1.0f) : strength(fieldStrength) {}
+
+    // 원시 샘플 추가 (추정 스레드, O(1))
+    void addSample(const Eigen::Vector3f& raw);
+
+    // 격자 샘플로 타원체 적합 (백그라운드 스레드), 품질 검사를 통과하면 결과를 갱신하고 true
+    bool solve();
+
+    // 결과가 바뀌었으면 out을 갱신하고 true (버전 비교만 하므로 매 샘플 호출 가능)
+    bool latest(MagCalibration& out, uint32_t& version) const;
+
+    int coveredCells() const;
+
+private:
+    struct Cell {
+        Eigen::Vector3f sample;
+        bool used = false;
+    };
+
+    float strength;
+    mutable std::mutex gridMutex;
+    std::array<Cell, CELLS> grid;
+    Eigen::Vector3f minSample = Eigen::Vector3f::Constant(1e9f);
+    Eigen::Vector3f maxSample = Eigen::Vector3f::Constant(-1e9f);
+    Eigen::Vector3f center = Eigen::Vector3f::Zero();  // 방향 계산 기준 (적합 결과 또는 최소/최대 중점)
+    bool centerFromFit = false;
+
+    mutable std::mutex resultMutex;
+    MagCalibration result;
+    std::atomic<uint32_t> resultVersion{0};
+
+    int cellIndex(const Eigen::Vector3f& direction) const;
+};
+
+#endif
@@ -1,54 +1,226 @@
 #include "pose_estimator.h"
 #include "flight_mode.h"
 #include "flight_control.h"
+#include "log_records.h"
+#include "../oss/binary_logger.h"
+#include "../oss/blackbox.h"
+#include "../oss/trace.h"
+#include "../oss/loop_stats.h"
+#include "../oss/watchdog.h"
+#include "../oss/perf_counters.h"
+#include "../oss/transport.h"
+#include "../oss/serial_feed.h"
 #include <thread>
 #include <iostream>
-#include <fstream>
 #include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+
+// Ctrl-C/SIGTERM: 메인 루프를 끝내고 종료 경로(로그/블랙박스 남은 데이터와 꼬리말 쓰기)를 거치게 함
+// 핸들러에서는 플래그만 세움 (async-signal-safe)
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int) {
+    stopRequested = 1;
+}
+
+int main(int argc, char** argv) {
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    uint64_t processStartNs = monotonicNs();  // 시작부터 첫 유효 자세 출력까지 시간 측정
+    bool firstValidPose = false;
 
-int main() {
     // 루프 실행 주기 설정 (100ms)
     const std::chrono::milliseconds loopDuration(100);
 
+    // --blackbox: 센서 원시 바이트를 모두 기록 (재현/재생용, 드라이버 초기화 전에 시작)
+    bool blackbox = argc > 1 && std::strcmp(argv[1], "--blackbox") == 0;
+    if (blackbox && !startBlackbox("blackbox.bin")) {
+        std::cerr << "블랙박스 파일을 열 수 없습니다." << std::endl;
+        return 1;
+    }
+
+    // --replay <파일> [배속]: 센서 포트 대신 기록을 재생 (1 = 기록 당시 속도, 0 = 최대 속도), 기록이 끝나면 종료
+    bool replaying = argc > 2 && std::strcmp(argv[1], "--replay") == 0;
+    if (replaying && !startReplay(argv[2], argc > 3 && argv[3][0] != '-' ? std::atof(argv[3]) : 1.0)) {
+        return 1;
+    }
+
+    // --sim <파일> [배속]: 센서 포트를 pty로 열고 기록의 바이트를 기록 당시 간격으로 포트에 써 넣음 (기록이 끝나면 종료)
+    // 재생과 달리 드라이버의 실제 읽기 경로와 실시간 스케줄링을 그대로 거치므로 하드웨어 없는 부하 시험에 사용
+    bool simulating = argc > 2 && std::strcmp(argv[1], "--sim") == 0;
+    useSimulatedTransports(simulating);
+
+    // --trace: 처음 10초(재생은 끝까지) 동안 수신 → 파싱 → 추정 → 제어 단계별 지연을 추적하여 trace.json으로 저장
+    const uint64_t TRACE_DURATION_NS = 10000000000ULL;
+    // --perf: EKF 예측/GPS 업데이트와 센서 파싱 구간의 하드웨어 카운터를 5초마다 기록하고 표로 출력
+    bool tracing = false;
+    bool perf = false;
+    for (int i = 1; i < argc; ++i) {
+        tracing = tracing || std::strcmp(argv[i], "--trace") == 0;
+        perf = perf || std::strcmp(argv[i], "--perf") == 0;
+    }
+    if (tracing) {
+        startTracing();
+    }
+    if (perf) {
+        startPerfCounters();
+    }
+
+    // 바이너리 로그 시작 (기록은 링에 복사만 하고 파일 쓰기는 로거 스레드가 담당)
+    // 추정기 생성 전에 시작하여 시작/정렬 구간의 센서 기록도 남김
+    if (!startLogger("flight.log", LOG_SCHEMAS, LOG_SCHEMA_COUNT)) {
+        std::cerr << "로그 파일을 열 수 없습니다." << std::endl;
+        return 1;  // 파일 열기 실패 시 프로그램 종료
+    }
+
         // 비행 제어 시스템 초기화 (RC, GPS, IMU 등)
     flight_control_init();
+    if (simulating) {
+        const char* const ports[BLACKBOX_DEVICES] = {IMU_PORT, GPS_PORT, RC_PORT, BARO_PORT};  // BlackboxDevice 순서
+        if (!startSerialFeed(argv[2], argc > 3 && argv[3][0] != '-' ? std::atof(argv[3]) : 1.0, ports)) {
+            stopLogger();
+            return 1;
+        }
+    }
 
-    // EKF 기반 자세 추정 클래스 생성
+    // EKF 기반 자세 추정 클래스 생성 (센서 스레드가 바로 LOG_IMU/LOG_GPS를 기록하므로 로거가 먼저 켜져 있어야 함)
     PoseEstimator poseEstimator;
     std::this_thread::sleep_for(loopDuration);
-    
 
-    // CSV 파일 열기
-    std::ofstream csvFile("current_pose.csv");
-    if (!csvFile.is_open()) {
-        std::cerr << "CSV 파일을 열 수 없습니다." << std::endl;
-        return 1;  // 파일 열기 실패 시 프로그램 종료
+    // 스레드 생존 감시 (재생은 데이터 시각으로 진행하므로 감시하지 않음)
+    Heartbeat& mainHeartbeat = watchdogRegister("main", 500000000ULL);
+    if (!replaying) {
+        startWatchdog();
     }
 
-    // CSV 파일 헤더 작성
-    csvFile << "X,Y,Z,Roll,Pitch,Yaw" << std::endl;
-
     // 메인 루프
-    while (true) {
+    int loopCount = 0;
+    LoopStats& loopStats = registerLoop("main", 100000000ULL);
+    Eigen::VectorXf lastGoodState = Eigen::VectorXf::Zero(9);
+    uint32_t reportedFaults = 0;
+    while (!stopRequested && (!replaying || !replayFinished()) && (!simulating || !serialFeedFinished())) {
+        loopStats.begin();
+        mainHeartbeat.kick();
+
         // 100ms 주기로 상태 값을 가져옴
-        Eigen::VectorXf state = poseEstimator.getPose();
+        // IMU/추정 스레드가 멈추면 마지막 정상 추정값을 유지 (추정 스레드가 잠금을 잡은 채 멈췄을 수 있어 getPose를 부르지 않음)
+        uint32_t faults = poseEstimator.getFaults();
+        uint64_t poseSampleNs = 0;
+        Eigen::VectorXf state = lastGoodState;
+        if (!(faults & (POSE_FAULT_IMU | POSE_FAULT_ESTIMATOR))) {
+            state = poseEstimator.getPose(poseSampleNs);
+            lastGoodState = state;
+        }
+        if (faults != reportedFaults) {
+            std::cerr << "Pose faults 0x" << std::hex << faults << std::dec
+                      << ((faults & (POSE_FAULT_IMU | POSE_FAULT_ESTIMATOR)) ? ", holding last good pose" : "") << std::endl;
+            reportedFaults = faults;
+        }
+        trace(TRACE_CONTROLLER, poseSampleNs);
+        if (tracing && !replaying && monotonicNs() - processStartNs > TRACE_DURATION_NS) {
+            writeTraceReport("trace.json");
+            tracing = false;
+        }
+        if (!firstValidPose && poseEstimator.isReady()) {
+            firstValidPose = true;
+            std::cout << "First valid pose " << (monotonicNs() - processStartNs) / 1000000ULL << " ms after start" << std::endl;
+        }
+
+        // 자세 추정값 기록 (위치, 속도, roll/pitch/yaw)
+        PoseLog poseLog;
+        for (int i = 0; i < 3; ++i) {
+            poseLog.position[i] = state(i);
+            poseLog.velocity[i] = state(3 + i);
+            poseLog.euler[i] = state(6 + i);
+        }
+        poseLog.ready = poseEstimator.isReady();
+        poseLog.faults = faults;
+        logWrite(LOG_POSE, poseLog);
 
-        // 자세 추정값 출력 (x, y, z 위치와 roll, pitch, yaw만 출력)
-        std::cout << std::fixed << std::setprecision(7); // 소수점 7자리까지 표시
-        std::cout << "Current Pose: "
-                  << state(0) << " "
-                  << state(1) << " "
-                  << state(2) << " "
-                  << state(6) << " "
-                  << state(7) << " "
-                  << state(8) << std::endl;
+        // 5초마다 단계별 샘플 지연(평균/최대, ms)을 기록하고 화면에는 요약만 출력
+        if (++loopCount % 50 == 0) {
+            LatencyReport report = (faults & POSE_FAULT_ESTIMATOR) ? LatencyReport{} : poseEstimator.getLatencyReport();
+            const LatencyStat* stats[5] = {&report.imuIngest, &report.imuFusion, &report.gpsFusion,
+                                           &report.baroFusion, &report.poseOutput};
+            LatencyLog latencyLog;
+            for (int i = 0; i < 5; ++i) {
+                latencyLog.meanMs[i] = static_cast<float>(stats[i]->meanMs());
+                latencyLog.maxMs[i] = static_cast<float>(stats[i]->maxNs * 1e-6);
+            }
+            logWrite(LOG_LATENCY, latencyLog);
+
+            // 모든 주기 태스크의 주기/실행 시간 (스냅샷은 태스크를 멈추지 않음)
+            for (const LoopStatsSnapshot& loop : loopStatsSnapshots()) {
+                LoopLog loopLog = {};
+                std::memcpy(loopLog.name, loop.name, sizeof(loopLog.name));
+                loopLog.overruns = static_cast<uint32_t>(loop.overruns);
+                loopLog.iterations = loop.iterations;
+                loopLog.periodMeanMs = static_cast<float>(loop.period.meanNs * 1e-6);
+                loopLog.periodP99Ms = static_cast<float>(loop.period.p99Ns * 1e-6);
+                loopLog.periodMaxMs = static_cast<float>(loop.period.maxNs * 1e-6);
+                loopLog.execMeanMs = static_cast<float>(loop.execution.meanNs * 1e-6);
+                loopLog.execP99Ms = static_cast<float>(loop.execution.p99Ns * 1e-6);
+                loopLog.execMaxMs = static_cast<float>(loop.execution.maxNs * 1e-6);
+                logWrite(LOG_LOOP, loopLog);
+            }
+            if (perf) {
+                for (const PerfRegionSnapshot& region : perfRegionSnapshots()) {
+                    logWrite(LOG_PERF, makePerfLog(region));
+                }
+                printPerfCounters(stdout);
+            }
+
+            LoggerStats logStats = loggerStats();
+            std::cout << std::fixed << std::setprecision(3)
+                      << "Pose " << state(0) << " " << state(1) << " " << state(2) << " "
+                      << state(6) << " " << state(7) << " " << state(8)
+                      << " | imuFusion " << latencyLog.meanMs[1] << "/" << latencyLog.maxMs[1] << " ms"
+                      << " | log " << logStats.records << " records, " << logStats.dropped << " dropped";
+            if (blackbox) {
+                BlackboxStats blackboxInfo = blackboxStats();
+                std::cout << " | blackbox " << blackboxInfo.rawBytes / 1024 << " KB, " << blackboxInfo.dropped << " dropped";
+            }
+            std::cout << std::endl;
+        }
 
         // 100ms 동안 대기
+        loopStats.end();
         std::this_thread::sleep_for(loopDuration);
     }
 
-    // CSV 파일 닫기
-    csvFile.close();
+    if (stopRequested) {
+        std::cout << "Stop requested, flushing logs" << std::endl;
+    }
 
-    return 0;
+    // 남은 로그를 쓰고 닫기
+    stopSerialFeed();
+    stopWatchdog();
+    stopLogger();
+    stopBlackbox();
+    if (tracing) {
+        writeTraceReport("trace.json");
+    }
+
+    if (replaying || simulating) {
+        Eigen::VectorXf state = poseEstimator.getPose();
+        std::cout << std::fixed << std::setprecision(6) << (replaying ? "Replay" : "Simulation") << " finished, final pose";
+        for (int i = 0; i < 9; ++i) {
+            std::cout << " " << state(i);
+        }
+        std::cout << std::endl;
+        if (simulating) {
+            SerialFeedStats feed = serialFeedStats();
+            std::cout << "Serial feed " << feed.chunks << " chunks, " << feed.bytes << " bytes, " << feed.overruns
+                      << " overrun bytes, max late " << feed.maxLateNs / 1000 << " us" << std::endl;
+        }
+        printLoopStats(stdout);
+        if (perf) {
+            printPerfCounters(stdout);
+        }
+    }
+    fflush(stdout);
+    std::quick_exit(0);  // 센서 스레드는 드라이버 읽기 루프 안에 있으므로 기다리지 않고 종료 (로그는 위에서 닫음)
 }
@@ -1,169 +1,92 @@
 #include <iostream>
-#include <fcntl.h>
 #include <unistd.h>
-#include <sys/ioctl.h>
-#include <linux/i2c-dev.h>
 #include <cstdint>
 #include "../ioss/rc_input.h"
 #include "motor_control.h"
+#include "motor_output.h"
+#include "pca9685.h"
+#include "flight_control.h"
+#include "log_records.h"
+#include "../oss/binary_logger.h"
+#include "../oss/trace.h"
+#include "../oss/timer.h"
+#include "../oss/loop_stats.h"
+#include "../oss/watchdog.h"
+#include "../oss/perf_counters.h"
+#include "../oss/transport.h"
+#include "../oss/serial_feed.h"
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
 #include <termios.h>
 
-#define PCA9685_ADDR 0x40  // PCA9685 I2C 주소
-#define MODE1 0x00         // 모드1 레지스터
-#define PRESCALE 0xFE      // 프리스케일 레지스터
-#define LED0_ON_L 0x06     // 첫 번째 채널 ON 낮은 바이트 레지스터
-#define LED0_OFF_L 0x08    // 첫 번째 채널 OFF 낮은 바이트 레지스터
-
-const int RC_MIN = 172;
-const int RC_MAX = 1811;
-const int RC_MID = 991;
-const int PWM_MIN = 210;
-const int PWM_MAX = 405;
-const int MAX_ADJUSTMENT = 25; // 각 제어 입력의 최대 PWM 조정 값
-const int I2C_RETRY_LIMIT = 3; // I2C 오류 시 재시도 횟수
-const int SAFE_PWM = PWM_MIN; // 초기화 및 안전한 PWM 값
 const int LOOP_DELAY_US = 10000; // 주기적인 대기 시간 (10ms)
 
-class PCA9685 {
-public:
-    PCA9685(int address = PCA9685_ADDR) {
-        char filename[20];
-        snprintf(filename, 19, "/dev/i2c-1");
-        fd = open(filename, O_RDWR);
-        if (fd < 0) {
-            std::cerr << "Failed to open the i2c bus" << std::endl;
-            exit(1);
-        }
-        if (ioctl(fd, I2C_SLAVE, address) < 0) {
-            std::cerr << "Failed to acquire bus access and/or talk to slave" << std::endl;
-            exit(1);
-        }
-        reset();
-        setPWMFreq(50);  // Set frequency to 50Hz for motor control
-        initializeMotors(); // 모든 모터를 초기 안전 PWM 값으로 설정
-    }
-
-    ~PCA9685() {
-        stopAllMotors(); // 종료 시 모든 모터를 정지
-        if (fd >= 0) {
-            close(fd);
-        }
-    }
-
-    void setPWM(int channel, int on, int off) {
-        writeRegister(LED0_ON_L + 4 * channel, on & 0xFF);
-        writeRegister(LED0_ON_L + 4 * channel + 1, on >> 8);
-        writeRegister(LED0_OFF_L + 4 * channel, off & 0xFF);
-        writeRegister(LED0_OFF_L + 4 * channel + 1, off >> 8);
-    }
-
-    void setMotorSpeed(int channel, int pwm_value) {
-        if (pwm_value < PWM_MIN || pwm_value > PWM_MAX) {
-            std::cerr << "PWM value out of range (" << PWM_MIN << "-" << PWM_MAX << ")" << std::endl;
-            return;
-        }
-        setPWM(channel, 0, pwm_value);
-    }
+// SIGINT/SIGTERM이면 루프를 빠져나와 로그를 닫고 PCA9685 소멸자가 안전 값을 씀
+volatile std::sig_atomic_t stopRequested = 0;
 
-private:
-    int fd;
+void requestStop(int) {
+    stopRequested = 1;
+}
 
-    void reset() {
-        writeRegister(MODE1, 0x00);
-    }
+int main(int argc, char** argv) {
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
 
-    void setPWMFreq(int freq) {
-        uint8_t prescale = static_cast<uint8_t>(25000000.0 / (4096.0 * freq) - 1.0);
-        uint8_t oldmode = readRegister(MODE1);
-        uint8_t newmode = (oldmode & 0x7F) | 0x10;
-        writeRegister(MODE1, newmode);
-        writeRegister(PRESCALE, prescale);
-        writeRegister(MODE1, oldmode);
-        usleep(5000);
-        writeRegister(MODE1, oldmode | 0xA1);
-    }
+    // --sim <파일> [배속]: PCA9685는 메모리 레지스터 파일, RC 포트는 pty로 열고 기록의 RC 바이트를 실시간으로 써 넣음 (기록이 끝나면 종료)
+    bool simulating = argc > 2 && std::strcmp(argv[1], "--sim") == 0;
+    useSimulatedTransports(simulating);
 
-    void writeRegister(uint8_t reg, uint8_t value) {
-        uint8_t buffer[2] = {reg, value};
-        int retries = 0;
-        while (write(fd, buffer, 2) != 2) {
-            if (++retries >= I2C_RETRY_LIMIT) {
-                std::cerr << "Failed to write to the i2c bus after retries" << std::endl;
-                exit(1);
-            }
-            usleep(1000); // 1ms 대기 후 재시도
+    PCA9685 pca9685;
+    initRC(RC_PORT, B115200);  // RC 입력 초기화
+    if (simulating) {
+        const char* const ports[BLACKBOX_DEVICES] = {nullptr, nullptr, RC_PORT, nullptr};
+        if (!startSerialFeed(argv[2], argc > 3 && argv[3][0] != '-' ? std::atof(argv[3]) : 1.0, ports)) {
+            return 1;
         }
     }
-
-    uint8_t readRegister(uint8_t reg) {
-        int retries = 0;
-        while (write(fd, &reg, 1) != 1) {
-            if (++retries >= I2C_RETRY_LIMIT) {
-                std::cerr << "Failed to write to the i2c bus after retries" << std::endl;
-                exit(1);
-            }
-            usleep(1000);
-        }
-        uint8_t value;
-        if (read(fd, &value, 1) != 1) {
-            std::cerr << "Failed to read from the i2c bus" << std::endl;
-            exit(1);
-        }
-        return value;
+    if (!startLogger("motor_test.log", LOG_SCHEMAS, LOG_SCHEMA_COUNT)) {    // 매 주기 출력은 로그로, 화면은 1초마다 갱신
+        std::cerr << "Cannot open motor_test.log" << std::endl;
+        stopSerialFeed();
+        return 1;   // PCA9685 소멸자가 안전 값을 씀
     }
 
-    void initializeMotors() {
-        for (int i = 0; i < 4; ++i) {
-            setMotorSpeed(i, SAFE_PWM);
-        }
+    // --trace: 처음 10초 동안 RC 수신 → 파싱 → 제어 → 믹서 → I2C 쓰기 지연을 추적하여 motor_trace.json으로 저장
+    const uint64_t TRACE_DURATION_NS = 10000000000ULL;
+    // --perf: 믹서/SBUS 파싱 구간의 성능 카운터를 5초마다 로그에 기록
+    bool tracing = false;
+    bool perf = false;
+    for (int i = 1; i < argc; ++i) {
+        tracing = tracing || std::strcmp(argv[i], "--trace") == 0;
+        perf = perf || std::strcmp(argv[i], "--perf") == 0;
     }
-
-    void stopAllMotors() {
-        for (int i = 0; i < 4; ++i) {
-            setMotorSpeed(i, SAFE_PWM);
-        }
-        std::cout << "All motors stopped safely." << std::endl;
+    uint64_t traceStartNs = monotonicNs();
+    if (tracing) {
+        startTracing();
     }
-};
-
-// 스로틀 값을 0.0 ~ 1.0 범위로 매핑하는 함수
-double mapThrottle(int value) {
-    if (value <= RC_MIN) return 0.0;
-    if (value >= RC_MAX) return 1.0;
-    return static_cast<double>(value - RC_MIN) / (RC_MAX - RC_MIN);
-}
-
-// 제어 입력(에일러론, 엘리베이터, 러더)을 -1.0 ~ 1.0 범위로 매핑하는 함수
-double mapControlInput(int value) {
-    if (value < RC_MIN || value > RC_MAX) {
-        std::cerr << "Control input out of range: " << value << std::endl;
-        return 0.0;
+    PerfRegion& mixerRegion = perfRegion("mixer");
+    if (perf) {
+        startPerfCounters();
     }
-    if (value < RC_MID) return static_cast<double>(value - RC_MID) / (RC_MID - RC_MIN);
-    if (value > RC_MID) return static_cast<double>(value - RC_MID) / (RC_MAX - RC_MID);
-    return 0.0;
-}
-
-// 스로틀 PWM 계산 함수
-int computeThrottlePWM(double throttle_normalized) {
-    return static_cast<int>(PWM_MIN + throttle_normalized * (PWM_MAX - PWM_MIN));
-}
-
-// 에일러론, 엘리베이터, 러더 조정 값 계산 함수
-int computeAdjustment(double control_normalized) {
-    return static_cast<int>(control_normalized * MAX_ADJUSTMENT);
-}
-
-// 값이 특정 범위 내에 있도록 제한하는 함수
-int clamp(int value,  int min_value, int max_value) {
-    return value < min_value ? min_value : (value > max_value ? max_value : value);
-}
 
-int main() {
-    PCA9685 pca9685;
-    initRC("/dev/ttyAMA0", B115200);  // RC 입력 초기화
-
-    while (true) {
+    // 워치독: 제어 루프가 멈추거나 I2C 쓰기가 계속 실패하면 모터를 안전 값으로,
+    // RC 프레임이 끊기면 루프가 안전 값을 출력 (새 프레임이 오면 복귀)
+    std::atomic<bool> rcLost{false};
+    Heartbeat& motorHeartbeat = watchdogRegister("motor", 50000000ULL, [&pca9685] {
+        if (!pca9685.trySafeStop()) {
+            std::cerr << "Watchdog: i2c bus busy, safe PWM not written" << std::endl;
+        }
+    });
+    Heartbeat& rcHeartbeat = watchdogRegister("rc", 200000000ULL, [&rcLost] { rcLost = true; }, [&rcLost] { rcLost = false; });
+    startWatchdog();
+    uint64_t lastRcSampleNs = 0;
+
+    int loopCount = 0;
+    LoopStats& loopStats = registerLoop("motor", LOOP_DELAY_US * 1000ULL);
+    while (!stopRequested && (!simulating || !serialFeedFinished())) {
+        loopStats.begin();
         int throttle_value = readRCChannel(3); // 채널 3에서 스로틀 값 읽기
         int aileron_value = readRCChannel(1);  // 채널 1에서 에일러론 값 읽기
         int elevator_value = readRCChannel(2); // 채널 2에서 엘리베이터 값 읽기
@@ -179,43 +102,63 @@ int main() {
         int aileron_adj = computeAdjustment(aileron_normalized);
         int elevator_adj = computeAdjustment(elevator_normalized);
         int rudder_adj = computeAdjustment(rudder_normalized);
+        uint64_t rcSampleNs = getRCTimestampNs();  // 이번 주기가 반영하는 RC 프레임
+        trace(TRACE_CONTROLLER, rcSampleNs);
+        if (rcSampleNs != lastRcSampleNs) {
+            rcHeartbeat.kick();
+            lastRcSampleNs = rcSampleNs;
+        }
 
         // 각 모터별로 스로틀과 조정 값을 계산하여 PWM 설정
-        int motor1_PWM = throttle_PWM - aileron_adj - elevator_adj - rudder_adj;
-        int motor2_PWM = throttle_PWM + aileron_adj - elevator_adj + rudder_adj;
-        int motor3_PWM = throttle_PWM - aileron_adj + elevator_adj + rudder_adj;
-        int motor4_PWM = throttle_PWM + aileron_adj + elevator_adj - rudder_adj;
-
-        // PWM 값이 최소 값을 유지하도록 조정
-        int min_motor_PWM = std::min(std::min(motor1_PWM, motor2_PWM), std::min(motor3_PWM, motor4_PWM));
-        if (min_motor_PWM < PWM_MIN) {
-            int adjustment = PWM_MIN - min_motor_PWM;
-            motor1_PWM += adjustment;
-            motor2_PWM += adjustment;
-            motor3_PWM += adjustment;
-            motor4_PWM += adjustment;
+        int motor_PWM[MOTOR_COUNT];
+        {
+            PerfScope mixerScope(mixerRegion);
+            mixMotors(throttle_PWM, aileron_adj, elevator_adj, rudder_adj, motor_PWM);
         }
+        if (rcLost) {
+            std::fill(motor_PWM, motor_PWM + MOTOR_COUNT, SAFE_PWM);  // RC 실패 안전
+        }
+        trace(TRACE_MIXER, rcSampleNs);
 
-        // PWM 값이 범위 내에 있도록 제한
-        motor1_PWM = clamp(motor1_PWM, PWM_MIN, PWM_MAX);
-        motor2_PWM = clamp(motor2_PWM, PWM_MIN, PWM_MAX);
-        motor3_PWM = clamp(motor3_PWM, PWM_MIN, PWM_MAX);
-        motor4_PWM = clamp(motor4_PWM, PWM_MIN, PWM_MAX);
-
-        // 각 모터에 계산된 PWM 값 적용
-        pca9685.setMotorSpeed(0, motor1_PWM);
-        pca9685.setMotorSpeed(1, motor2_PWM);
-        pca9685.setMotorSpeed(2, motor3_PWM);
-        pca9685.setMotorSpeed(3, motor4_PWM);
+        // 각 모터에 계산된 PWM 값 적용 (네 채널을 한 번에)
+        // 써졌을 때만 생존 신호 (I2C 오류가 이어지면 워치독이 안전 값을 시도)
+        if (pca9685.setMotorSpeeds(motor_PWM)) {
+            motorHeartbeat.kick();
+        }
+        trace(TRACE_I2C_WRITE, rcSampleNs);
+        if (tracing && monotonicNs() - traceStartNs > TRACE_DURATION_NS) {
+            writeTraceReport("motor_trace.json");
+            tracing = false;
+        }
 
-        std::cout << "\rThrottle PWM: " << throttle_PWM
-                  << " Motor1: " << motor1_PWM
-                  << " Motor2: " << motor2_PWM
-                  << " Motor3: " << motor3_PWM
-                  << " Motor4: " << motor4_PWM << std::flush;
+        MotorLog motorLog = {throttle_PWM, {motor_PWM[0], motor_PWM[1], motor_PWM[2], motor_PWM[3]}};
+        logWrite(LOG_MOTOR, motorLog);
+        if (perf && loopCount % 500 == 0) {
+            for (const PerfRegionSnapshot& region : perfRegionSnapshots()) {
+                logWrite(LOG_PERF, makePerfLog(region));   // 링에 복사만 (표 출력은 제어 루프 밖에서 log_convert로)
+            }
+        }
+        if (++loopCount % 100 == 0) {
+            LoopStatsSnapshot timing;
+            loopStats.snapshot(timing);
+            std::cout << "\rThrottle PWM: " << throttle_PWM
+                      << " Motor1: " << motor_PWM[0]
+                      << " Motor2: " << motor_PWM[1]
+                      << " Motor3: " << motor_PWM[2]
+                      << " Motor4: " << motor_PWM[3]
+                      << " | period p99 " << timing.period.p99Ns / 1000 << " us, overruns " << timing.overruns
+                      << " | i2c errors " << pca9685.errorCount() << (rcLost ? " | RC LOST" : "") << std::flush;
+        }
 
+        loopStats.end();
         usleep(10000); // 10ms 대기
     }
 
+    // 종료 (모의 실행 끝 또는 신호): 남은 로그를 쓰고 주기 통계 출력 (모터 안전 값은 PCA9685 소멸자가 씀)
+    stopSerialFeed();
+    stopWatchdog();
+    stopLogger();
+    std::cout << std::endl;
+    printLoopStats(stdout);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "motor_output.h"
+#include "motor_control.h"
+#include <algorithm>
+#include <iostream>
+
+double mapThrottle(int value) {
+    if (value <= RC_MIN) return 0.0;
+    if (value >= RC_MAX) return 1.0;
+    return static_cast<double>(value - RC_MIN) / (RC_MAX - RC_MIN);
+}
+
+double mapControlInput(int value) {
+    if (value < RC_MIN || value > RC_MAX) {
+        std::cerr << "Control input out of range: " << value << std::endl;
+        return 0.0;
+    }
+    if (value < RC_MID) return static_cast<double>(value - RC_MID) / (RC_MID - RC_MIN);
+    if (value > RC_MID) return static_cast<double>(value - RC_MID) / (RC_MAX - RC_MID);
+    return 0.0;
+}
+
+int computeThrottlePWM(double throttle_normalized) {
+    return static_cast<int>(PWM_MIN + throttle_normalized * (PWM_MAX - PWM_MIN));
+}
+
+int computeAdjustment(double control_normalized) {
+    return static_cast<int>(control_normalized * MAX_ADJUSTMENT);
+}
+
+int clamp(int value,  int min_value, int max_value) {
+    return value < min_value ? min_value : (value > max_value ? max_value : value);
+}
+
+void mixMotors(int throttle_PWM, int aileron_adj, int elevator_adj, int rudder_adj, int (&motor_PWM)[MOTOR_COUNT]) {
+    motor_PWM[0] = throttle_PWM - aileron_adj - elevator_adj - rudder_adj;
+    motor_PWM[1] = throttle_PWM + aileron_adj - elevator_adj + rudder_adj;
+    motor_PWM[2] = throttle_PWM - aileron_adj + elevator_adj + rudder_adj;
+    motor_PWM[3] = throttle_PWM + aileron_adj + elevator_adj - rudder_adj;
+
+    // PWM 값이 최소 값을 유지하도록 조정
+    int min_motor_PWM = std::min(std::min(motor_PWM[0], motor_PWM[1]), std::min(motor_PWM[2], motor_PWM[3]));
+    if (min_motor_PWM < PWM_MIN) {
+        int adjustment = PWM_MIN - min_motor_PWM;
+        for (int& pwm : motor_PWM) {
+            pwm += adjustment;
+        }
+    }
+
+    // PWM 값이 범위 내에 있도록 제한
+    for (int& pwm : motor_PWM) {
+        pwm = clamp(pwm, PWM_MIN, PWM_MAX);
+    }
+}
+
+size_t buildPCA9685Frame(int firstChannel, const int* pwm, int count, uint8_t* frame) {
+    frame[0] = static_cast<uint8_t>(LED0_ON_L + 4 * firstChannel);
+    uint8_t* p = frame + 1;
+    for (int i = 0; i < count; ++i) {
+        p[0] = 0;                                       // ON_L
+        p[1] = 0;                                       // ON_H
+        p[2] = static_cast<uint8_t>(pwm[i] & 0xFF);     // OFF_L
+        p[3] = static_cast<uint8_t>(pwm[i] >> 8);       // OFF_H
+        p += 4;
+    }
+    return 1 + 4 * static_cast<size_t>(count);
+}
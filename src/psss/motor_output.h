@@ -0,0 +1,37 @@
+// RC 입력 → 모터 PWM 계산 (쿼드 X 믹서)과 PCA9685 레지스터 프레임 구성
+// 하드웨어 없이 계산만 하므로 motor_control과 벤치마크가 함께 사용
+#ifndef MOTOR_OUTPUT_H
+#define MOTOR_OUTPUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+const int RC_MIN = 172;
+const int RC_MAX = 1811;
+const int RC_MID = 991;
+const int PWM_MIN = 210;
+const int PWM_MAX = 405;
+const int MAX_ADJUSTMENT = 25; // 각 제어 입력의 최대 PWM 조정 값
+const int SAFE_PWM = PWM_MIN; // 초기화 및 안전한 PWM 값
+const int MOTOR_COUNT = 4;
+
+// 스로틀 값을 0.0 ~ 1.0 범위로 매핑하는 함수
+double mapThrottle(int value);
+// 제어 입력(에일러론, 엘리베이터, 러더)을 -1.0 ~ 1.0 범위로 매핑하는 함수
+double mapControlInput(int value);
+// 스로틀 PWM 계산 함수
+int computeThrottlePWM(double throttle_normalized);
+// 에일러론, 엘리베이터, 러더 조정 값 계산 함수
+int computeAdjustment(double control_normalized);
+// 값이 특정 범위 내에 있도록 제한하는 함수
+int clamp(int value, int min_value, int max_value);
+
+// 스로틀과 조정 값으로 모터별 PWM 계산 (가장 낮은 모터를 PWM_MIN으로 올린 뒤 범위 제한)
+void mixMotors(int throttle_PWM, int aileron_adj, int elevator_adj, int rudder_adj, int (&motor_PWM)[MOTOR_COUNT]);
+
+// firstChannel부터 연속 count개 채널의 LEDn_ON_L..LEDn_OFF_H를 한 번에 쓰는 I2C 프레임 (ON = 0, OFF = pwm)
+// [시작 레지스터, 채널마다 4바이트], MODE1 자동 증가(AI)가 켜져 있어야 함. 프레임 길이 반환
+const size_t PCA9685_FRAME_MAX = 1 + 4 * 16;
+size_t buildPCA9685Frame(int firstChannel, const int* pwm, int count, uint8_t* frame);
+
+#endif
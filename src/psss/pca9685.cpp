@@ -0,0 +1,233 @@
+#include "pca9685.h"
+#include <iostream>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+const int I2C_RETRY_LIMIT = 3; // I2C 오류 시 재시도 횟수
+
+#define MODE1_AI 0x20       // 자동 증가
+#define MODE1_SLEEP 0x10    // 저전력 (발진기 꺼짐)
+#define MODE1_RESTART 0x80
+#define ALL_LED_ON_L 0xFA
+#define LAST_LED_REGISTER 0x45
+
+std::unique_ptr<I2CTransport> openPCA9685Bus(int address) {
+    if (simulatedTransports()) {
+        return std::unique_ptr<I2CTransport>(new SimulatedPCA9685());
+    }
+    return std::unique_ptr<I2CTransport>(new I2CDevTransport("/dev/i2c-1", address));
+}
+
+PCA9685::PCA9685(std::unique_ptr<I2CTransport> transport) : bus(std::move(transport)) {
+    if (!reset() || !setPWMFreq(50)) {  // Set frequency to 50Hz for motor control
+        throw std::runtime_error("Failed to configure PCA9685");
+    }
+    safeStop(); // 모든 모터를 초기 안전 PWM 값으로 설정
+}
+
+PCA9685::~PCA9685() {
+    // 종료 시 모든 모터를 정지
+    if (safeStop()) {
+        std::cout << "All motors stopped safely." << std::endl;
+    } else {
+        std::cerr << "Failed to set safe PWM on all motors" << std::endl;
+    }
+}
+
+bool PCA9685::setPWM(int channel, int on, int off) {
+    std::lock_guard<std::mutex> lock(busMutex);
+    return writePWM(channel, on, off);
+}
+
+bool PCA9685::setMotorSpeed(int channel, int pwm_value) {
+    if (pwm_value < PWM_MIN || pwm_value > PWM_MAX) {
+        std::cerr << "PWM value out of range (" << PWM_MIN << "-" << PWM_MAX << ")" << std::endl;
+        return false;
+    }
+    return setPWM(channel, 0, pwm_value);
+}
+
+bool PCA9685::setMotorSpeeds(const int (&pwm)[MOTOR_COUNT]) {
+    for (int value : pwm) {
+        if (value < PWM_MIN || value > PWM_MAX) {
+            std::cerr << "PWM value out of range (" << PWM_MIN << "-" << PWM_MAX << ")" << std::endl;
+            return false;
+        }
+    }
+    uint8_t frame[PCA9685_FRAME_MAX];
+    size_t length = buildPCA9685Frame(0, pwm, MOTOR_COUNT, frame);
+    std::lock_guard<std::mutex> lock(busMutex);
+    return writeFrame(frame, length);
+}
+
+bool PCA9685::safeStop() {
+    std::lock_guard<std::mutex> lock(busMutex);
+    return writeSafe();
+}
+
+bool PCA9685::trySafeStop() {
+    std::unique_lock<std::mutex> lock(busMutex, std::try_to_lock);
+    return lock.owns_lock() && writeSafe();
+}
+
+bool PCA9685::reset() {
+    return writeRegister(MODE1, 0x00);
+}
+
+bool PCA9685::writePWM(int channel, int on, int off) {
+    return writeRegister(LED0_ON_L + 4 * channel, on & 0xFF) &&
+           writeRegister(LED0_ON_L + 4 * channel + 1, on >> 8) &&
+           writeRegister(LED0_OFF_L + 4 * channel, off & 0xFF) &&
+           writeRegister(LED0_OFF_L + 4 * channel + 1, off >> 8);
+}
+
+bool PCA9685::writeSafe() {
+    const int safe[MOTOR_COUNT] = {SAFE_PWM, SAFE_PWM, SAFE_PWM, SAFE_PWM};
+    uint8_t frame[PCA9685_FRAME_MAX];
+    size_t length = buildPCA9685Frame(0, safe, MOTOR_COUNT, frame);
+    return writeFrame(frame, length);
+}
+
+bool PCA9685::setPWMFreq(int freq) {
+    uint8_t prescale = static_cast<uint8_t>(25000000.0 / (4096.0 * freq) - 1.0);
+    uint8_t oldmode;
+    if (!readRegister(MODE1, oldmode)) {
+        return false;
+    }
+    uint8_t newmode = (oldmode & 0x7F) | 0x10;
+    if (!writeRegister(MODE1, newmode) || !writeRegister(PRESCALE, prescale) || !writeRegister(MODE1, oldmode)) {
+        return false;
+    }
+    usleep(5000);
+    return writeRegister(MODE1, oldmode | 0xA1);
+}
+
+bool PCA9685::writeRegister(uint8_t reg, uint8_t value) {
+    uint8_t buffer[2] = {reg, value};
+    return writeFrame(buffer, 2);
+}
+
+// [시작 레지스터, 값...] 한 번에 쓰기 (여러 레지스터는 MODE1 AI 비트가 켜져 있어야 함, setPWMFreq가 켬)
+bool PCA9685::writeFrame(const uint8_t* frame, size_t length) {
+    int retries = 0;
+    while (!bus->write(frame, length)) {
+        if (++retries >= I2C_RETRY_LIMIT) {
+            i2cErrors.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "Failed to write to the i2c bus after retries" << std::endl;
+            return false;
+        }
+        usleep(1000); // 1ms 대기 후 재시도
+    }
+    return true;
+}
+
+bool PCA9685::readRegister(uint8_t reg, uint8_t& value) {
+    int retries = 0;
+    while (!bus->write(&reg, 1)) {
+        if (++retries >= I2C_RETRY_LIMIT) {
+            i2cErrors.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "Failed to write to the i2c bus after retries" << std::endl;
+            return false;
+        }
+        usleep(1000);
+    }
+    if (!bus->read(&value, 1)) {
+        i2cErrors.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "Failed to read from the i2c bus" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+SimulatedPCA9685::SimulatedPCA9685() {
+    std::memset(registers, 0, sizeof(registers));
+    registers[MODE1] = 0x11;        // SLEEP | ALLCALL
+    registers[0x01] = 0x04;         // MODE2: OUTDRV
+    registers[0x02] = 0xE2;         // SUBADR1~3, ALLCALLADR
+    registers[0x03] = 0xE4;
+    registers[0x04] = 0xE8;
+    registers[0x05] = 0xE0;
+    for (int channel = 0; channel < 16; ++channel) {
+        registers[LED0_OFF_L + 4 * channel + 1] = 0x10;     // full off
+    }
+    registers[ALL_LED_ON_L + 3] = 0x10;
+    registers[PRESCALE] = 0x1E;     // 200 Hz
+}
+
+bool SimulatedPCA9685::write(const uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (failWrites > 0) {
+        --failWrites;
+        return false;
+    }
+    if (length == 0) {
+        return false;
+    }
+    pointer = data[0];
+    for (size_t i = 1; i < length; ++i) {
+        store(pointer, data[i]);
+        advance();
+    }
+    ++writeCount;
+    return true;
+}
+
+bool SimulatedPCA9685::read(uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = registers[pointer];
+        advance();
+    }
+    return true;
+}
+
+uint8_t SimulatedPCA9685::reg(uint8_t address) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return registers[address];
+}
+
+int SimulatedPCA9685::offCount(int channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    int base = LED0_OFF_L + 4 * channel;
+    return registers[base] | ((registers[base + 1] & 0x0F) << 8);
+}
+
+double SimulatedPCA9685::pwmFrequency() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return 25000000.0 / (4096.0 * (registers[PRESCALE] + 1));
+}
+
+uint64_t SimulatedPCA9685::writes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writeCount;
+}
+
+void SimulatedPCA9685::failNextWrites(unsigned count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    failWrites = count;
+}
+
+void SimulatedPCA9685::store(uint8_t address, uint8_t value) {
+    if (address == MODE1) {
+        registers[MODE1] = value & ~MODE1_RESTART;     // RESTART는 1을 쓰면 지워짐
+    } else if (address == PRESCALE) {
+        if (registers[MODE1] & MODE1_SLEEP) {
+            registers[PRESCALE] = value;
+        }
+    } else if (address >= ALL_LED_ON_L && address < PRESCALE) {
+        registers[address] = value;
+        for (int channel = 0; channel < 16; ++channel) {
+            registers[LED0_ON_L + 4 * channel + (address - ALL_LED_ON_L)] = value;
+        }
+    } else if (address <= LAST_LED_REGISTER) {
+        registers[address] = value;
+    }
+    // 0x46~0xF9 예약, 0xFF TestMode는 무시
+}
+
+void SimulatedPCA9685::advance() {
+    if (registers[MODE1] & MODE1_AI) {
+        pointer = pointer == LAST_LED_REGISTER ? 0 : static_cast<uint8_t>(pointer + 1);
+    }
+}
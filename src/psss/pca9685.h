@@ -0,0 +1,76 @@
+// PCA9685 16채널 PWM 드라이버 (모터 ESC 출력)
+// I2C 전송은 I2CTransport로 받음: 실제 보드는 /dev/i2c-1, 모의 모드는 SimulatedPCA9685 레지스터 파일
+#ifndef PCA9685_H
+#define PCA9685_H
+
+#include "motor_control.h"    // PCA9685 주소와 레지스터 정의
+#include "motor_output.h"
+#include "../oss/transport.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// 모의 모드면 SimulatedPCA9685, 아니면 /dev/i2c-1 (열기 실패는 예외)
+std::unique_ptr<I2CTransport> openPCA9685Bus(int address = PCA9685_ADDR);
+
+// 초기화 실패는 예외, 동작 중 I2C 오류는 false 반환 (프로세스를 끝내지 않고 호출자/워치독이 대응)
+// 제어 루프와 워치독 스레드가 함께 쓰므로 레지스터 묶음 쓰기는 잠금으로 보호
+class PCA9685 {
+public:
+    explicit PCA9685(std::unique_ptr<I2CTransport> bus = openPCA9685Bus());
+    ~PCA9685();
+
+    bool setPWM(int channel, int on, int off);
+    bool setMotorSpeed(int channel, int pwm_value);
+    // 네 모터를 I2C 쓰기 한 번으로 (채널 0~3의 레지스터가 연속, 자동 증가 사용)
+    bool setMotorSpeeds(const int (&pwm)[MOTOR_COUNT]);
+    // 모든 모터를 안전 값으로
+    bool safeStop();
+    // 워치독용: 제어 루프가 버스 쓰기 중에 멈춰 있으면 기다리지 않고 false
+    bool trySafeStop();
+
+    uint64_t errorCount() const { return i2cErrors.load(std::memory_order_relaxed); }
+
+private:
+    std::unique_ptr<I2CTransport> bus;
+    std::mutex busMutex;
+    std::atomic<uint64_t> i2cErrors{0};
+
+    bool reset();
+    bool writePWM(int channel, int on, int off);
+    bool writeSafe();
+    bool setPWMFreq(int freq);
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool writeFrame(const uint8_t* frame, size_t length);
+    bool readRegister(uint8_t reg, uint8_t& value);
+};
+
+// 하드웨어 없는 PCA9685: 256바이트 레지스터 파일과 레지스터 포인터
+// I2C 쓰기의 첫 바이트가 포인터, 이후 바이트는 포인터 위치에 쓰고 MODE1 AI가 켜져 있으면 포인터 증가 (0x45 다음은 0x00)
+// 전원 인가 값(MODE1 SLEEP, 모든 채널 full off)에서 시작하고, PRE_SCALE은 SLEEP일 때만 써짐, ALL_LED는 모든 채널에 씀
+class SimulatedPCA9685 : public I2CTransport {
+public:
+    SimulatedPCA9685();
+
+    bool write(const uint8_t* data, size_t length) override;
+    bool read(uint8_t* data, size_t length) override;
+
+    uint8_t reg(uint8_t address) const;
+    int offCount(int channel) const;        // LEDn_OFF 12비트 값
+    double pwmFrequency() const;            // 25 MHz 내부 클럭과 PRE_SCALE 기준
+    uint64_t writes() const;                // 성공한 쓰기 트랜잭션 수
+    void failNextWrites(unsigned count);    // 다음 count번의 쓰기를 NACK (오류 처리 시험용)
+
+private:
+    mutable std::mutex mutex;
+    uint8_t registers[256];
+    uint8_t pointer = 0;
+    uint64_t writeCount = 0;
+    unsigned failWrites = 0;
+
+    void store(uint8_t address, uint8_t value);
+    void advance();
+};
+
+#endif
@@ -3,6 +3,11 @@
 #include "ekf.h"
 #include "imu_sensor.h"
 #include "gps_sensor.h"
+#include "../oss/blackbox.h"
+#include "../oss/binary_logger.h"
+#include "../oss/trace.h"
+#include "../oss/loop_stats.h"
+#include "log_records.h"
 #include <math.h>
 #include <iostream>
 #include <iomanip>
@@ -27,23 +32,67 @@ Eigen::Vector3f quaternionToEuler(const Eigen::Quaternionf& q) {
     return Eigen::Vector3f(roll, pitch, yaw) * (180.0f / M_PI);
 }
 
+// 캘리브레이션 파일 경로와 저장 주기
+const char* CALIBRATION_PATH = "calibration.bin";
+const char* TEMPERATURE_TABLE_PATH = "imu_temperature.bin";  // fit_temperature_bias로 생성
+const uint64_t CALIBRATION_SAVE_INTERVAL_NS = 60000000000ULL;  // 정지 중 60초마다
+
+// 서울 부근 지구 자기장 세기 (gauss), 자기장 보정 결과도 이 세기로 맞춤
+const float EARTH_FIELD_STRENGTH = 0.5f;
+
+// 항법 해 시각 → NAV-PVT 마지막 바이트 수신까지의 최소 지연 (u-blox M8N 10Hz 기준, 수신기/항법 주기를 바꾸면 조정)
+// 실제 지연의 변동은 GpsTimeAligner가 iTOW로 따라감
+const uint64_t GPS_MIN_OUTPUT_DELAY_NS = 50000000ULL;
+
 // PoseEstimator 생성자
-PoseEstimator::PoseEstimator() : ekf(), running(true) {
+PoseEstimator::PoseEstimator() : ekf(), running(true), gpsTimeAligner(GPS_MIN_OUTPUT_DELAY_NS), ready(false), boardTemperature(NAN), magCalibrator(EARTH_FIELD_STRENGTH) {
     currentState = Eigen::VectorXf::Zero(16);
-    imuAccel = Eigen::Vector3f::Zero();
-    imuGyro = Eigen::Vector3f::Zero();
-    imuMag = Eigen::Vector3f::Zero();
-    gpsPos = Eigen::Vector3f::Zero();
-    gpsVel = Eigen::Vector3f::Zero();
-    gyroOffset = Eigen::Vector3f::Zero();
+
+    // 서울 부근 지구 자기장 (WMM 기준 편각 약 -9도, 복각 약 54도, 약 0.5 gauss)
+    ekf.setMagneticField(-9.0f * M_PI / 180.0f, 54.0f * M_PI / 180.0f, EARTH_FIELD_STRENGTH);
+
+    // 제한 시간: IMU 400Hz, GPS 1~10Hz, 기압 수십 Hz, 추정 100ms 주기에 지터 여유
+    imuHeartbeat = superviseThread("imu", 50000000ULL, POSE_FAULT_IMU);
+    gpsHeartbeat = superviseThread("gps", 1500000000ULL, POSE_FAULT_GPS);
+    baroHeartbeat = superviseThread("baro", 500000000ULL, POSE_FAULT_BARO);
+    estimatorHeartbeat = superviseThread("estimator", 300000000ULL, POSE_FAULT_ESTIMATOR);
+
+    // 재생: 기록 외의 입력(저장된 바이어스, 온도표, 벽시계 주기의 자기장 보정)을 쓰지 않아야 결과가 재현됨
+    replaying = blackboxReplaying();
+    if (replaying) {
+        imuThread = std::thread(&PoseEstimator::processIMU, this);
+        gpsThread = std::thread(&PoseEstimator::processGPS, this);
+        baroThread = std::thread(&PoseEstimator::processBaro, this);
+        estimationThread = std::thread(&PoseEstimator::calculatePose, this);
+        return;
+    }
+
+    // 마지막으로 저장된 바이어스를 바로 적용 (시작 시 온도를 모르므로 가장 최근 기록)
+    // 이후 정지 구간에서 다시 추정한 값으로 갱신하고 저장
+    imuSerial = readIMUSerialNumber();
+    CalibrationRecord record;
+    if (calibration.open(CALIBRATION_PATH) && calibration.find(imuSerial, NAN, record)) {
+        ekf.setBiases(Eigen::Vector3f(record.gyroBias[0], record.gyroBias[1], record.gyroBias[2]),
+                      Eigen::Vector3f(record.accelBias[0], record.accelBias[1], record.accelBias[2]));
+        calibrationLoaded = true;
+        std::cout << "Loaded calibration for IMU " << imuSerial << " (" << record.temperatureC << " C)" << std::endl;
+    }
+    if (temperatureTable.load(TEMPERATURE_TABLE_PATH, imuSerial)) {
+        std::cout << "Loaded temperature bias table for IMU " << imuSerial << std::endl;
+    }
 
     imuThread = std::thread(&PoseEstimator::processIMU, this);
     gpsThread = std::thread(&PoseEstimator::processGPS, this);
+    baroThread = std::thread(&PoseEstimator::processBaro, this);
+    magCalibrationThread = std::thread(&PoseEstimator::processMagCalibration, this);
     estimationThread = std::thread(&PoseEstimator::calculatePose, this);
 }
 
 // PoseEstimator 소멸자
 PoseEstimator::~PoseEstimator() {
+    for (Heartbeat* heartbeat : {imuHeartbeat, gpsHeartbeat, baroHeartbeat, estimatorHeartbeat}) {
+        watchdogRelease(*heartbeat);  // 콜백이 this를 가리킴
+    }
     running = false;
     if (estimationThread.joinable()) {
         estimationThread.join();
@@ -54,101 +103,363 @@ PoseEstimator::~PoseEstimator() {
     if (gpsThread.joinable()) {
         gpsThread.join();
     }
+    if (baroThread.joinable()) {
+        baroThread.join();
+    }
+    if (magCalibrationThread.joinable()) {
+        magCalibrationThread.join();
+    }
 }
 
-// 자이로 캘리브레이션 함수
-void PoseEstimator::calibrateGyro() {
-    int sampleCount = 100;
-    Eigen::Vector3f gyroSum = Eigen::Vector3f::Zero();
-    for (int i = 0; i < sampleCount; ++i) {
-        IMUData imuData = readIMU();
-        gyroSum += Eigen::Vector3f(imuData.gyroX, imuData.gyroY, imuData.gyroZ);
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-    gyroOffset = gyroSum / sampleCount;
-    isGyroCalibrated = true;
+// 놓치면 장애 비트를 세우고, 다시 신호가 오면 해제
+Heartbeat* PoseEstimator::superviseThread(const char* name, uint64_t timeoutNs, uint32_t fault) {
+    return &watchdogRegister(name, timeoutNs, [this, fault] { faults.fetch_or(fault, std::memory_order_relaxed); },
+                             [this, fault] { faults.fetch_and(~fault, std::memory_order_relaxed); });
 }
 
+// 기압 샘플 간격이 이보다 길면 그동안 GPS 고도로 추정한 pD 기준으로 기압 바이어스를 다시 잡음
+const uint64_t BARO_RESEED_GAP_NS = 5000000000ULL;
+
+// 지상 판정: 이 시간 안의 GPS가 있으면 그 속도가 임계값 미만일 때만 지상 (등속 비행 중 정지 오판 방지)
+const uint64_t GROUND_GPS_MAX_AGE_NS = 1000000000ULL;
+const float GROUND_MAX_GPS_SPEED = 0.5f;  // m/s
+
+// 예측 한 번에 합칠 IMU 샘플 수 (400Hz → 100Hz 예측, bench_preintegration 참고)
+const int IMU_BATCH_SAMPLES = 4;
+
+// 재생 중 자기장 보정 주기 (추정 스텝 수, 1초)
+const int REPLAY_MAG_CALIBRATION_STEPS = 10;
+
 // 포즈 계산 함수
+// 마지막 계산 이후 수신된 IMU/GPS 샘플을 수신 시각 순서대로 모두 처리
+// 재생 중에는 벽시계 대신 데이터 시각 100ms마다 한 번 계산 (매 계산의 입력 샘플 집합이 항상 같음)
 void PoseEstimator::calculatePose() {
+    LoopStats& loopStats = registerLoop("estimator", 100000000ULL);
+    int replaySteps = 0;
     while (running) {
-        float dt = 0.1f;
-
-        // 유효하지 않은 IMU 데이터가 감지되면 대체 값으로 초기화
-        if (imuAccel.hasNaN() || imuGyro.hasNaN() || imuMag.hasNaN()) {
-            std::cerr << "Invalid IMU data detected, using last valid data" << std::endl;
-            imuAccel.setZero();
-            imuGyro.setZero();
-            imuMag.setZero();
+        if (replaying) {
+            if (!replayStep(100000000ULL)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));  // 기록 끝
+                continue;
+            }
+            if (++replaySteps % REPLAY_MAG_CALIBRATION_STEPS == 0) {
+                magCalibrator.solve();
+            }
+        }
+        loopStats.begin();
+        estimatorHeartbeat->kick();
+        {
+            std::lock_guard<std::mutex> lock(poseMutex);
+            imuSnapshot = imuHistory;
+            gpsSnapshot = gpsHistory;
+            baroSnapshot = baroHistory;
+        }
+
+        uint64_t lastImuTime = 0;
+        long imuStart = imuSnapshot.findAtOrBefore(lastPredictNs) + 1;
+        long gpsIndex = gpsSnapshot.findAtOrBefore(lastGpsUpdateNs) + 1;
+        long baroIndex = baroSnapshot.findAtOrBefore(lastBaroUpdateNs) + 1;
+        uint64_t fusedGpsTimes[GPS_HISTORY_SIZE];
+        size_t fusedGpsCount = 0;
+        uint64_t fusedBaroTimes[BARO_HISTORY_SIZE];
+        size_t fusedBaroCount = 0;
+
+        // 새 IMU 샘플을 사전 적분하여 IMU_BATCH_SAMPLES개마다(그리고 마지막 샘플에서) 한 번 예측
+        // 예측 결과는 EKF가 상태 히스토리에 기록, 자기장/영속도는 EKF가 샘플 시각 기준으로 주기를 제한하여 융합
+        // 자이로/가속도 바이어스는 EKF 상태로 추정: 첫 정지 구간에서 평균으로 초기화하고 이후 정지 때마다 영속도 업데이트
+        // (정지는 IMU만으로 판정하므로 지상 상태일 때만, onGround 참고)
+        size_t batchStart = static_cast<size_t>(imuStart);
+        for (size_t i = static_cast<size_t>(imuStart); i < imuSnapshot.size(); ++i) {
+            const ImuSample& sample = imuSnapshot.at(i);
+            uint64_t sampleTime = imuSnapshot.timeAt(i);
+            integrateSample(sampleTime, sample);
+
+            // 원시 자기장은 보정기 격자에 넣고, 정지 판정은 모든 샘플로 수행
+            magCalibrator.addSample(sample.mag);
+            stillness.add(sample.accel, sample.gyro, sampleTime);
+            if (firstImuNs == 0) {
+                firstImuNs = sampleTime;
+                // 저장된 바이어스가 있으면 첫 샘플로 기울기만 맞추고 바로 사용
+                if (calibrationLoaded) {
+                    ekf.alignTilt(sample.accel);
+                    ready = true;
+                    std::cout << "Pose estimator ready from stored calibration" << std::endl;
+                }
+            }
+
+            if (preintegrator.count() < IMU_BATCH_SAMPLES && i + 1 < imuSnapshot.size()) {
+                continue;
+            }
+            predictBatch(sampleTime);
+            if (tracingEnabled()) {
+                for (size_t j = batchStart; j <= i; ++j) {
+                    trace(TRACE_ESTIMATOR, imuSnapshot.timeAt(j), BLACKBOX_IMU);  // 묶음의 모든 샘플이 이 예측으로 반영됨
+                }
+            }
+            batchStart = i + 1;
+
+            // 보정값이 있으면 적용하여 자기장 융합
+            magCalibrator.latest(magCalibration, magCalibrationVersion);
+            ekf.updateWithMag(magCalibration.valid ? magCalibration.apply(sample.mag) : sample.mag, sampleTime);
+
+            if (stillness.isStill() && onGround(sampleTime)) {
+                if (!seeded) {
+                    ekf.seedAtRest(stillness.meanAccel(), stillness.meanGyro(), stillness.windowDuration());
+                    seeded = true;
+                    if (!ready) {
+                        ready = true;
+                        std::cout << "Pose estimator ready after " << (sampleTime - firstImuNs) / 1000000ULL << " ms" << std::endl;
+                    }
+                    saveCalibration(sampleTime);
+                } else {
+                    ekf.updateZeroVelocity(sampleTime);
+                    if (sampleTime > lastCalibrationSaveNs + CALIBRATION_SAVE_INTERVAL_NS) {
+                        saveCalibration(sampleTime);
+                    }
+                }
+            }
+            lastImuTime = sampleTime;
+        }
+
+        // 예측이 따라잡은 GPS는 실제 측정 시각(iTOW로 추정한 항법 해 시각)의 과거 상태에 융합
+        while (gpsIndex < static_cast<long>(gpsSnapshot.size()) && gpsSnapshot.timeAt(gpsIndex) <= lastPredictNs) {
+            uint64_t gpsTime = gpsSnapshot.timeAt(gpsIndex);
+            const GpsSample& gps = gpsSnapshot.at(gpsIndex);
+            {
+                PerfScope scope(gpsUpdateRegion);
+                ekf.updateWithGPS(gps.position, gps.velocity, gps.measurementNs);
+            }
+            trace(TRACE_ESTIMATOR, gpsTime, BLACKBOX_GPS);
+            lastGpsUpdateNs = gpsTime;
+            fusedGpsTimes[fusedGpsCount++] = gpsTime;
+            ++gpsIndex;
         }
 
-        // EKF 예측 및 자기장 업데이트 단계 실행
-        ekf.predict(imuAccel, imuGyro, dt);
-        // ekf.updateWithMag(imuMag);
-        ekf.updateWithGPS(gpsPos ,gpsVel);
+        // 워치독이 기압 중단을 감지하면 수직 기준이 없으므로 다시 살아날 때까지 GPS 고도를 융합
+        if (baroActive && (faults.load(std::memory_order_relaxed) & POSE_FAULT_BARO)) {
+            ekf.setGpsAltitudeFusion(true);
+            baroActive = false;
+            std::cerr << "Barometer lost, using GPS altitude" << std::endl;
+        }
+
+        // 기압 고도는 지연이 작으므로 현재 상태에 바로 융합
+        // 첫 샘플로 기압 바이어스가 잡히면 수직 위치는 기압만 사용 (GPS 고도는 수평보다 오차가 크고 튐)
+        while (baroIndex < static_cast<long>(baroSnapshot.size()) && baroSnapshot.timeAt(baroIndex) <= lastPredictNs) {
+            uint64_t baroTime = baroSnapshot.timeAt(baroIndex);
+            if (!baroActive) {
+                if (lastBaroUpdateNs != 0 && baroTime > lastBaroUpdateNs + BARO_RESEED_GAP_NS) {
+                    ekf.resetBaroBias();  // 오래 끊긴 동안 바이어스가 드리프트했을 수 있음
+                }
+                ekf.setGpsAltitudeFusion(false);
+                baroActive = true;
+            }
+            ekf.updateWithBaro(baroSnapshot.at(baroIndex).altitude);
+            trace(TRACE_ESTIMATOR, baroTime, BLACKBOX_BARO);
+            lastBaroUpdateNs = baroTime;
+            fusedBaroTimes[fusedBaroCount++] = baroTime;
+            ++baroIndex;
+        }
 
         // 현재 상태를 보호된 상태로 업데이트
         {
             std::lock_guard<std::mutex> lock(poseMutex);
+            uint64_t now = monotonicNs();
+            latency.imuFusion.add(lastImuTime, now);
+            for (size_t i = 0; i < fusedGpsCount; ++i) {
+                latency.gpsFusion.add(fusedGpsTimes[i], now);
+            }
+            for (size_t i = 0; i < fusedBaroCount; ++i) {
+                latency.baroFusion.add(fusedBaroTimes[i], now);
+            }
             currentState = ekf.getState();
+            stateTimestampNs = lastPredictNs;
         }
+        loopStats.end();
 
         // 계산 주기 설정 (100ms)
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (!replaying) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+}
+
+// 영속도 업데이트/정지 바이어스 설정을 해도 되는 지상 상태인지
+// 비행 제어의 지상 플래그가 꺼져 있으면 아님, 최근 GPS가 있으면 GPS 속도로 판정, 없으면 플래그만 사용
+bool PoseEstimator::onGround(uint64_t timeNs) const {
+    if (!groundFlag.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    long gps = gpsSnapshot.findAtOrBefore(timeNs);
+    if (gps < 0 || timeNs - gpsSnapshot.timeAt(gps) > GROUND_GPS_MAX_AGE_NS) {
+        return true;
+    }
+    return gpsSnapshot.at(gps).velocity.norm() * 1e-3f < GROUND_MAX_GPS_SPEED;  // mm/s
+}
+
+// 현재 추정 바이어스를 최근 기압 센서 온도 구간으로 저장 (mmap 복사, 파일 I/O는 커널이 비동기로 처리)
+void PoseEstimator::saveCalibration(uint64_t timeNs) {
+    lastCalibrationSaveNs = timeNs;
+    if (replaying) {
+        return;  // 재생 결과로 실기체 캘리브레이션을 덮어쓰지 않음
+    }
+    float temperature = baroSnapshot.empty() ? NAN : baroSnapshot.newest().temperature;
+    Eigen::Vector3f gyroBias = ekf.getGyroBias();
+    Eigen::Vector3f accelBias = ekf.getAccelBias();
+    calibration.save(imuSerial, temperature, gyroBias.data(), accelBias.data());
+}
+
+// 이전 샘플 시각부터 timeNs까지를 이 샘플 값으로 사전 적분 (첫 샘플은 시각만 기록)
+void PoseEstimator::integrateSample(uint64_t timeNs, const ImuSample& sample) {
+    if (lastIntegratedNs != 0 && timeNs > lastIntegratedNs) {
+        preintegrator.add(sample, nsToSec(timeNs - lastIntegratedNs));
+    }
+    if (timeNs > lastIntegratedNs) {
+        lastIntegratedNs = timeNs;
+    }
+}
+
+// 누적된 증분을 평균 입력으로 바꾸어 한 번에 예측 (coning/sculling 보정 포함)
+void PoseEstimator::predictBatch(uint64_t timeNs) {
+    ImuSample mean;
+    if (preintegrator.average(mean)) {
+        PerfScope scope(predictRegion);
+        ekf.predict(mean.accel, mean.gyro, preintegrator.duration(), timeNs);
+        preintegrator.reset();
+    }
+    if (timeNs > lastPredictNs) {
+        lastPredictNs = timeNs;
     }
 }
 
 // IMU 데이터 처리 함수
 void PoseEstimator::processIMU() {
-
+    LoopStats& loopStats = registerLoop("imu", 0);  // 주기는 센서가 정함 (읽기 대기는 실행 시간에서 제외)
     while (running) {
         IMUData imuData = readIMU();  // IMU 센서에서 데이터 읽기
+        trace(TRACE_PARSE, imuData.timestampNs, BLACKBOX_IMU);
+        loopStats.begin();
         Eigen::Vector3f newAccel = Eigen::Vector3f(imuData.accelX, imuData.accelY, imuData.accelZ);
-        Eigen::Vector3f newGyro = Eigen::Vector3f(imuData.gyroX, imuData.gyroY, imuData.gyroZ) - gyroOffset;
+        Eigen::Vector3f newGyro = Eigen::Vector3f(imuData.gyroX, imuData.gyroY, imuData.gyroZ);  // 바이어스는 EKF에서 추정
         Eigen::Vector3f newMag = Eigen::Vector3f(imuData.magX, imuData.magY, imuData.magZ);
 
         // 유효한 IMU 데이터인 경우에만 업데이트
         if (!newAccel.hasNaN() && !newGyro.hasNaN() && !newMag.hasNaN()) {
+            // 온도에 따른 바이어스 변화를 먼저 빼서 EKF는 온도와 무관한 나머지만 추정
+            float temperature = boardTemperature.load(std::memory_order_relaxed);
+            if (temperatureTable.isLoaded() && !std::isnan(temperature)) {
+                temperatureTable.correct(temperature, newGyro, newAccel);
+            }
             {
                 std::lock_guard<std::mutex> lock(poseMutex);  // 동기화 보호
-                imuAccel = newAccel;
-                imuGyro = newGyro;
-                imuMag = newMag;
+                imuHistory.push(imuData.timestampNs, ImuSample{newAccel, newGyro, newMag});
+                latency.imuIngest.add(imuData.timestampNs, monotonicNs());
+            }
+            imuHeartbeat->kick();
+            ImuLog imuLog;
+            imuLog.rxTimeNs = imuData.timestampNs;
+            for (int i = 0; i < 3; ++i) {
+                imuLog.accel[i] = newAccel(i);
+                imuLog.gyro[i] = newGyro(i);
+                imuLog.mag[i] = newMag(i);
             }
+            logWrite(LOG_IMU, imuLog);
         } else {
             std::cerr << "Invalid IMU data, keeping last valid data" << std::endl;
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));  // 주기 설정
+        loopStats.end();
+        // 모든 샘플을 히스토리에 보관하므로 별도 대기 없이 센서 주기로 읽음
     }
 }
 
+// 홈 원점으로 삼을 최소 위성 수
+const uint8_t GPS_MIN_SATELLITES = 6;
+
 // GPS 데이터 처리 함수
+// 위도/경도(1e-7도)와 타원체고(mm)를 홈 원점 기준 NED(m)로 변환하여 저장
 void PoseEstimator::processGPS() {
+    LoopStats& loopStats = registerLoop("gps", 0);
     while (running) {
-        // 기존의 GPS 데이터 읽기 부분을 주석 처리합니다.
-        /*
-        GPSData gpsData = readGPS();
-        Eigen::Vector3f newPos = Eigen::Vector3f(gpsData.latitude / 1e7, gpsData.longitude / 1e7, gpsData.altitude / 1000.0f);
-        Eigen::Vector3f newVel = Eigen::Vector3f(gpsData.velocityX, gpsData.velocityY, gpsData.velocityZ);
+        GPSData gpsData = readGPS();  // 다음 NAV-PVT 메시지까지 대기
+        trace(TRACE_PARSE, gpsData.timestampNs, BLACKBOX_GPS);
+        loopStats.begin();
+        gpsHeartbeat->kick();  // 위성 수와 무관하게 수신기가 살아 있음
+        GpsLog gpsLog = {gpsData.timestampNs, static_cast<int32_t>(gpsData.latitude), static_cast<int32_t>(gpsData.longitude),
+                         static_cast<int32_t>(gpsData.altitude),
+                         {static_cast<int32_t>(gpsData.velocityX), static_cast<int32_t>(gpsData.velocityY), static_cast<int32_t>(gpsData.velocityZ)},
+                         gpsData.iTOW, gpsData.numSV};
+        logWrite(LOG_GPS, gpsLog);
+        if (gpsData.numSV < GPS_MIN_SATELLITES) {
+            loopStats.end();
+            continue;  // 고정 전이거나 위성 수 부족
+        }
+
+        double latDeg = gpsData.latitude * 1e-7;
+        double lonDeg = gpsData.longitude * 1e-7;
+        double altM = gpsData.altitude * 1e-3;
+        if (!homeFrame.hasOrigin()) {
+            homeFrame.setOrigin(latDeg, lonDeg, altM);  // EKF 원점(0, 0, 0)과 일치
+        }
+
+        uint64_t measuredNs = gpsTimeAligner.measurementTime(gpsData.timestampNs, gpsData.iTOW);
+        Eigen::Vector3f newPos = homeFrame.toNED(latDeg, lonDeg, altM);
+        Eigen::Vector3f newVel = Eigen::Vector3f(gpsData.velocityX, gpsData.velocityY, gpsData.velocityZ);  // mm/s
 
         // GPS 데이터가 유효하지 않으면 마지막 유효 데이터를 그대로 사용
         if (newPos.hasNaN() || newVel.hasNaN()) {
             std::cerr << "Invalid GPS data, keeping last valid data" << std::endl;
         } else {
-            gpsPos = newPos;  // 새로운 유효한 GPS 데이터로 업데이트
-            gpsVel = newVel;
+            std::lock_guard<std::mutex> lock(poseMutex);
+            gpsHistory.push(gpsData.timestampNs, GpsSample{newPos, newVel, measuredNs});  // 새로운 유효한 GPS 데이터 추가
+        }
+        loopStats.end();
+    }
+}
+
+// 기압 데이터 처리 함수
+void PoseEstimator::processBaro() {
+    LoopStats& loopStats = registerLoop("baro", 0);
+    while (running) {
+        BarometerData baroData = readBarometer();  // 다음 프레임까지 대기
+        trace(TRACE_PARSE, baroData.timestampNs, BLACKBOX_BARO);
+        loopStats.begin();
+        float altitude = pressureToAltitude(baroData.pressure);
+
+        if (std::isnan(altitude) || std::isinf(altitude)) {
+            std::cerr << "Invalid barometer data" << std::endl;
+            loopStats.end();
+            continue;
+        }
+        boardTemperature.store(baroData.temperature, std::memory_order_relaxed);
+        baroHeartbeat->kick();
+        {
+            std::lock_guard<std::mutex> lock(poseMutex);
+            baroHistory.push(baroData.timestampNs, BaroSample{altitude, baroData.temperature});
         }
-        */
-        gpsPos = Eigen::Vector3f::Zero();
-        gpsVel = Eigen::Vector3f::Zero();
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        loopStats.end();
+    }
+}
+
+// 자기장 보정 스레드 (1초마다 격자 샘플로 타원체 재적합, 품질 검사를 통과한 결과만 반영)
+void PoseEstimator::processMagCalibration() {
+    LoopStats& loopStats = registerLoop("magcal", 1000000000ULL);
+    while (running) {
+        loopStats.begin();
+        magCalibrator.solve();
+        loopStats.end();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 }
 
 // 현재 포즈를 얻는 함수
 Eigen::VectorXf PoseEstimator::getPose() {
+    uint64_t sampleTimeNs;
+    return getPose(sampleTimeNs);
+}
+
+// 포즈와 그 포즈가 반영하는 마지막 IMU 샘플 시각 (지연 추적의 샘플 id)
+Eigen::VectorXf PoseEstimator::getPose(uint64_t& sampleTimeNs) {
     std::lock_guard<std::mutex> lock(poseMutex);
+    sampleTimeNs = stateTimestampNs;
 
     Eigen::VectorXf pose(9);  // 위치, 속도, 오일러 각을 포함한 9차원 벡터
     pose.segment<3>(0) = currentState.segment<3>(0);  // 위치 (x, y, z)
@@ -159,5 +470,12 @@ Eigen::VectorXf PoseEstimator::getPose() {
     attitude.normalize();  // 쿼터니언 정규화
     pose.segment<3>(6) = quaternionToEuler(attitude);  // 오일러 각 (Roll, Pitch, Yaw) 추가
 
+    latency.poseOutput.add(stateTimestampNs, monotonicNs());
     return pose;
 }
+
+// 단계별 지연 통계 반환
+LatencyReport PoseEstimator::getLatencyReport() {
+    std::lock_guard<std::mutex> lock(poseMutex);
+    return latency;
+}
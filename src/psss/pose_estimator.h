@@ -7,6 +7,38 @@
 #include "ekf.h"
 #include "imu_sensor.h"
 #include "gps_sensor.h"
+#include "barometer_sensor.h"
+#include "sensor_history.h"
+#include "geodetic.h"
+#include "stillness_detector.h"
+#include "calibration_store.h"
+#include "mag_calibrator.h"
+#include "temperature_compensation.h"
+#include "imu_preintegrator.h"
+#include "gps_time_aligner.h"
+#include "../oss/timer.h"
+#include "../oss/watchdog.h"
+#include "../oss/perf_counters.h"
+
+// 파이프라인 단계별 샘플 지연 (센서 수신 시각 기준)
+struct LatencyReport {
+    LatencyStat imuIngest;   // IMU 수신 → processIMU 저장
+    LatencyStat imuFusion;   // IMU 수신 → EKF 예측
+    LatencyStat gpsFusion;   // GPS 수신 → EKF 업데이트
+    LatencyStat baroFusion;  // 기압 수신 → EKF 업데이트
+    LatencyStat poseOutput;  // 상태에 반영된 IMU 수신 → getPose() 반환
+};
+
+// 쿼터니언 → roll, pitch, yaw (deg)
+Eigen::Vector3f quaternionToEuler(const Eigen::Quaternionf& q);
+
+// 워치독이 감지한 스레드 장애 (비트 합, 스레드가 다시 움직이면 해제)
+enum PoseFault : uint32_t {
+    POSE_FAULT_IMU = 1,         // 유효한 IMU 샘플 없음 (readIMU 정지 포함) → 예측이 멈추고 자세는 마지막 값 유지
+    POSE_FAULT_GPS = 2,         // NAV-PVT 없음 → IMU/기압만으로 추정
+    POSE_FAULT_BARO = 4,        // 기압 없음 → 복구될 때까지 GPS 고도로 수직 추정
+    POSE_FAULT_ESTIMATOR = 8,   // 추정 스레드 정지 (poseMutex를 잡고 멈췄을 수 있으므로 getPose를 부르지 말 것)
+};
 
 class PoseEstimator {
 public:
@@ -14,6 +46,15 @@ public:
     ~PoseEstimator();
     
     Eigen::VectorXf getPose();
+    Eigen::VectorXf getPose(uint64_t& sampleTimeNs);
+    LatencyReport getLatencyReport();
+    // 정지 구간에서 바이어스/자세가 초기화되어 제어에 사용할 수 있는 상태
+    bool isReady() const { return ready; }
+    // 현재 장애 (PoseFault 비트), 워치독이 실행 중일 때만 갱신
+    uint32_t getFaults() const { return faults.load(std::memory_order_relaxed); }
+    // 비행 제어가 알려 주는 지상 상태 (disarm/모터 정지면 true, 기본 true)
+    // 정지 검출기는 등속 비행과 정지를 구분하지 못하므로 false이면 영속도 업데이트/바이어스 재설정을 하지 않음
+    void setOnGround(bool value) { groundFlag.store(value, std::memory_order_relaxed); }
     
 private:
     EKF ekf;
@@ -21,23 +62,74 @@ private:
     std::thread estimationThread;
     std::thread imuThread;
     std::thread gpsThread;
+    std::thread baroThread;
+    std::thread magCalibrationThread;
     std::atomic<bool> running;
+    bool replaying = false;          // 블랙박스 재생 입력 (데이터 시각으로 추정 주기 진행)
+
+    // 스레드별 생존 신호 (놓치면 해당 PoseFault 비트 설정)
+    std::atomic<uint32_t> faults{0};
+    Heartbeat* imuHeartbeat = nullptr;
+    Heartbeat* gpsHeartbeat = nullptr;
+    Heartbeat* baroHeartbeat = nullptr;
+    Heartbeat* estimatorHeartbeat = nullptr;
+    Heartbeat* superviseThread(const char* name, uint64_t timeoutNs, uint32_t fault);
+
+    // 성능 카운터 구간 (startPerfCounters 전에는 측정하지 않음)
+    PerfRegion& predictRegion = perfRegion("ekf_predict");
+    PerfRegion& gpsUpdateRegion = perfRegion("ekf_gps");
     
+    static constexpr size_t IMU_HISTORY_SIZE = 512;  // 400Hz 기준 약 1.3초
+    static constexpr size_t GPS_HISTORY_SIZE = 16;
+    static constexpr size_t BARO_HISTORY_SIZE = 16;
+
     Eigen::VectorXf currentState;
-    Eigen::Vector3f imuAccel;
-    Eigen::Vector3f imuGyro;
-    Eigen::Vector3f imuMag;
-    Eigen::Vector3f gpsPos;
-    Eigen::Vector3f gpsVel;
+    SensorHistory<ImuSample, IMU_HISTORY_SIZE> imuHistory;  // 수신 스레드가 채우는 버퍼
+    SensorHistory<GpsSample, GPS_HISTORY_SIZE> gpsHistory;
+    SensorHistory<ImuSample, IMU_HISTORY_SIZE> imuSnapshot; // 추정 스레드 작업용 복사본
+    SensorHistory<GpsSample, GPS_HISTORY_SIZE> gpsSnapshot;
+    SensorHistory<BaroSample, BARO_HISTORY_SIZE> baroHistory;
+    SensorHistory<BaroSample, BARO_HISTORY_SIZE> baroSnapshot;
+    uint64_t lastPredictNs = 0;      // 마지막으로 예측에 사용한 IMU 샘플 시각
+    uint64_t lastIntegratedNs = 0;   // 마지막으로 사전 적분에 넣은 IMU 샘플 시각
+    ImuPreintegrator preintegrator;  // 예측 사이 IMU 샘플 누적 (추정 스레드 전용)
+    uint64_t lastGpsUpdateNs = 0;    // 마지막으로 융합한 GPS 샘플 시각
+    uint64_t lastBaroUpdateNs = 0;   // 마지막으로 융합한 기압 샘플 시각
+    bool baroActive = false;         // 기압 고도를 수직 기준으로 사용 중 (GPS 고도 미사용, 기압 장애 중에는 false)
+    uint64_t stateTimestampNs = 0;   // currentState가 반영하는 IMU 샘플 시각
+    LatencyReport latency;
+    LocalFrame homeFrame;            // 첫 GPS 고정 위치를 원점으로 하는 NED 좌표계 (GPS 스레드 전용)
+    GpsTimeAligner gpsTimeAligner;   // iTOW → 측정 시각 (GPS 스레드 전용)
     std::mutex poseMutex;
 
-    Eigen::Vector3f gyroOffset;
-    bool isGyroCalibrated = false;
-    
-    void calibrateGyro();
+    StillnessDetector stillness;     // 추정 스레드 전용
+    std::atomic<bool> groundFlag{true};
+    std::atomic<bool> ready;
+    bool seeded = false;             // 정지 구간 평균으로 바이어스를 다시 잡았는지
+    uint64_t firstImuNs = 0;         // 시작 시간 측정용 첫 IMU 샘플 시각
+
+    CalibrationStore calibration;    // 시리얼/온도별 저장 바이어스 (부팅 시 즉시 적용)
+    uint32_t imuSerial = 0;
+    bool calibrationLoaded = false;
+    uint64_t lastCalibrationSaveNs = 0;
+
+    void saveCalibration(uint64_t timeNs);
+
+    TemperatureBiasTable temperatureTable;   // 온도에 따른 바이어스 변화 (수신 스레드에서 샘플마다 보정)
+    std::atomic<float> boardTemperature;     // 기압 센서 온도 (IMU 근처 보드 온도로 사용)
+
+    MagCalibrator magCalibrator;     // 샘플 추가는 추정 스레드, 적합은 보정 스레드
+    MagCalibration magCalibration;   // 추정 스레드가 적용하는 현재 보정값
+    uint32_t magCalibrationVersion = 0;
+    void processMagCalibration();
+
     void calculatePose();
+    bool onGround(uint64_t timeNs) const;
+    void integrateSample(uint64_t timeNs, const ImuSample& sample);
+    void predictBatch(uint64_t timeNs);
     void processIMU();
     void processGPS();
+    void processBaro();
     
     const std::chrono::milliseconds loopDuration = std::chrono::milliseconds(20);
 };
\ No newline at end of file
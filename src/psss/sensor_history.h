@@ -0,0 +1,131 @@
+// 센서별 시간 인덱스 히스토리 버퍼
+// 서로 다른 주기/지연으로 들어오는 센서 값을 수신 시각 기준으로 보관하고
+// 과거 임의 시각의 값을 보간하여 조회하는 데 사용
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// IMU 샘플 (보간 대상)
+struct ImuSample {
+    Eigen::Vector3f accel;
+    Eigen::Vector3f gyro;
+    Eigen::Vector3f mag;
+};
+
+// GPS 샘플
+struct GpsSample {
+    Eigen::Vector3f position;
+    Eigen::Vector3f velocity;
+    uint64_t measurementNs;     // 항법 해 시각 (CLOCK_MONOTONIC 기준으로 옮긴 값, 히스토리 키는 수신 시각)
+};
+
+// 기압 샘플 (ISA 기압 고도 m, 센서 온도 °C)
+struct BaroSample {
+    float altitude;
+    float temperature;
+};
+
+// 두 IMU 샘플 사이 선형 보간 (frac: 0 → a, 1 → b)
+inline ImuSample interpolateSample(const ImuSample& a, const ImuSample& b, float frac) {
+    ImuSample out;
+    out.accel = a.accel + (b.accel - a.accel) * frac;
+    out.gyro = a.gyro + (b.gyro - a.gyro) * frac;
+    out.mag = a.mag + (b.mag - a.mag) * frac;
+    return out;
+}
+
+// 고정 용량 링 버퍼. 삽입 O(1), 시각 검색 O(log n)
+// 시각은 단조 증가해야 하며 역전된 샘플은 버림
+template <typename T, size_t Capacity>
+class SensorHistory {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // 샘플 추가 (가득 차면 가장 오래된 샘플을 덮어씀)
+    bool push(uint64_t timeNs, const T& sample) {
+        if (count > 0 && timeNs <= newestTime()) {
+            return false;
+        }
+        size_t slot = (head + count) & MASK;
+        times[slot] = timeNs;
+        samples[slot] = sample;
+        if (count < Capacity) {
+            ++count;
+        } else {
+            head = (head + 1) & MASK;
+        }
+        return true;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // i = 0이 가장 오래된 샘플
+    uint64_t timeAt(size_t i) const { return times[(head + i) & MASK]; }
+    const T& at(size_t i) const { return samples[(head + i) & MASK]; }
+    T& at(size_t i) { return samples[(head + i) & MASK]; }
+
+    uint64_t oldestTime() const { return timeAt(0); }
+    uint64_t newestTime() const { return timeAt(count - 1); }
+    const T& newest() const { return at(count - 1); }
+
+    // timeNs 이하인 마지막 샘플의 인덱스 (없으면 -1), 이진 탐색
+    long findAtOrBefore(uint64_t timeNs) const {
+        if (count == 0 || timeNs < oldestTime()) {
+            return -1;
+        }
+        size_t lo = 0;
+        size_t hi = count;  // [lo, hi) 안에서 timeAt > timeNs 인 첫 위치 탐색
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (timeAt(mid) <= timeNs) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return static_cast<long>(lo) - 1;
+    }
+
+    // timeNs 시점의 값을 인접 두 샘플로 보간
+    // 버퍼 범위를 벗어나면 false (가장 가까운 끝 값을 out에 기록)
+    bool interpolate(uint64_t timeNs, T& out) const {
+        if (count == 0) {
+            return false;
+        }
+        long i = findAtOrBefore(timeNs);
+        if (i < 0) {
+            out = at(0);
+            return false;
+        }
+        size_t idx = static_cast<size_t>(i);
+        if (idx + 1 >= count) {
+            out = at(idx);
+            return timeAt(idx) == timeNs;
+        }
+        uint64_t t0 = timeAt(idx);
+        uint64_t t1 = timeAt(idx + 1);
+        float frac = static_cast<float>(timeNs - t0) / static_cast<float>(t1 - t0);
+        out = interpolateSample(at(idx), at(idx + 1), frac);
+        return true;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    std::array<uint64_t, Capacity> times{};
+    std::array<T, Capacity> samples{};
+    size_t head = 0;   // 가장 오래된 샘플 위치
+    size_t count = 0;
+};
+
+#endif
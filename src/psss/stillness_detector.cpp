@@ -0,0 +1,71 @@
+#include "stillness_detector.h"
+#include <cmath>
+
+// 정지 판정 임계값 (VN-100 정지 시 측정 기준으로 여유를 둔 값)
+const double STILL_GYRO_STD = 0.01;       // rad/s, 축별 표준편차
+const double STILL_GYRO_MEAN = 0.05;      // rad/s, 바이어스를 포함한 평균 각속도 크기
+const double STILL_ACCEL_STD = 0.1;       // m/s^2, 축별 표준편차
+const double STILL_GRAVITY_TOLERANCE = 0.3; // m/s^2, 평균 비력 크기와 중력의 차이
+const double STILL_GRAVITY = 9.80665;
+
+void StillnessDetector::add(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, uint64_t timeNs) {
+    const Eigen::Vector3d a = accel.cast<double>();
+    const Eigen::Vector3d g = gyro.cast<double>();
+
+    size_t slot = (head + count) % WINDOW;
+    if (count == WINDOW) {
+        // 가장 오래된 샘플을 빼고 그 자리에 저장
+        const Eigen::Vector3d oldA = accelSamples[head].cast<double>();
+        const Eigen::Vector3d oldG = gyroSamples[head].cast<double>();
+        accelSum -= oldA;
+        accelSqSum -= oldA.cwiseAbs2();
+        gyroSum -= oldG;
+        gyroSqSum -= oldG.cwiseAbs2();
+        slot = head;
+        head = (head + 1) % WINDOW;
+    } else {
+        ++count;
+    }
+
+    accelSamples[slot] = accel;
+    gyroSamples[slot] = gyro;
+    times[slot] = timeNs;
+    accelSum += a;
+    accelSqSum += a.cwiseAbs2();
+    gyroSum += g;
+    gyroSqSum += g.cwiseAbs2();
+}
+
+float StillnessDetector::windowDuration() const {
+    if (count < 2) {
+        return 0.0f;
+    }
+    uint64_t newest = times[(head + count - 1) % WINDOW];
+    return static_cast<float>(newest - times[head]) * 1e-9f;
+}
+
+void StillnessDetector::reset() {
+    head = 0;
+    count = 0;
+    accelSum.setZero();
+    accelSqSum.setZero();
+    gyroSum.setZero();
+    gyroSqSum.setZero();
+}
+
+bool StillnessDetector::isStill() const {
+    if (count < WINDOW) {
+        return false;
+    }
+
+    const double n = static_cast<double>(count);
+    Eigen::Vector3d accelMean = accelSum / n;
+    Eigen::Vector3d gyroMean = gyroSum / n;
+    Eigen::Vector3d accelVar = accelSqSum / n - accelMean.cwiseAbs2();
+    Eigen::Vector3d gyroVar = gyroSqSum / n - gyroMean.cwiseAbs2();
+
+    return gyroVar.maxCoeff() < STILL_GYRO_STD * STILL_GYRO_STD
+        && gyroMean.norm() < STILL_GYRO_MEAN
+        && accelVar.maxCoeff() < STILL_ACCEL_STD * STILL_ACCEL_STD
+        && std::fabs(accelMean.norm() - STILL_GRAVITY) < STILL_GRAVITY_TOLERANCE;
+}
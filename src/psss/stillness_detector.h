@@ -0,0 +1,43 @@
+// IMU 정지 상태 검출기
+// 최근 WINDOW개 샘플의 자이로/가속도 평균과 분산을 슬라이딩 윈도우로 유지하고
+// 흔들림이 임계값 이하이면 정지로 판단 (시작 시 바이어스 초기화, 정지 중 영속도 업데이트에 사용)
+#ifndef STILLNESS_DETECTOR_H
+#define STILLNESS_DETECTOR_H
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class StillnessDetector {
+public:
+    static constexpr size_t WINDOW = 64;  // 400Hz 기준 160ms
+
+    // 샘플 추가 (timeNs: 수신 시각), 샘플당 O(1)
+    void add(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, uint64_t timeNs);
+    void reset();
+
+    // 윈도우가 가득 찼고 자이로/가속도 흔들림과 비력 크기가 임계값 이내
+    bool isStill() const;
+
+    Eigen::Vector3f meanAccel() const { return (accelSum / count).cast<float>(); }
+    Eigen::Vector3f meanGyro() const { return (gyroSum / count).cast<float>(); }
+    size_t sampleCount() const { return count; }
+    // 윈도우의 첫 샘플부터 마지막 샘플까지 시간 (초)
+    float windowDuration() const;
+
+private:
+    std::array<Eigen::Vector3f, WINDOW> accelSamples;
+    std::array<Eigen::Vector3f, WINDOW> gyroSamples;
+    std::array<uint64_t, WINDOW> times;
+    size_t head = 0;
+    size_t count = 0;
+
+    // 합과 제곱합은 빼기 누적 오차를 줄이기 위해 double
+    Eigen::Vector3d accelSum = Eigen::Vector3d::Zero();
+    Eigen::Vector3d accelSqSum = Eigen::Vector3d::Zero();
+    Eigen::Vector3d gyroSum = Eigen::Vector3d::Zero();
+    Eigen::Vector3d gyroSqSum = Eigen::Vector3d::Zero();
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include "temperature_compensation.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+const uint32_t TEMPERATURE_TABLE_MAGIC = 0x41494254;  // "TBIA"
+
+// 파일 헤더 (뒤에 POINTS개의 Row가 이어짐)
+struct TemperatureTableHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sensorSerial;
+    uint32_t points;
+    float minC;
+    float stepC;
+};
+
+TemperatureBiasTable::TemperatureBiasTable() {
+    for (Row& row : rows) {
+        row.setZero();
+    }
+}
+
+TemperatureBiasTable::Row TemperatureBiasTable::biasAt(float temperatureC) const {
+    Eigen::Vector3f gyro = Eigen::Vector3f::Zero();
+    Eigen::Vector3f accel = Eigen::Vector3f::Zero();
+    correct(temperatureC, gyro, accel);
+    Row row = Row::Zero();
+    row.head<3>() = -gyro;
+    row.segment<3>(3) = -accel;
+    return row;
+}
+
+// 기저 함수: 격자점 k의 삼각(hat) 함수, 샘플은 인접한 두 점에 (1 - frac, frac) 가중
+// 최소화: sum |y - B r|^2 + smoothing * N * sum |r[k-1] - 2 r[k] + r[k+1]|^2
+// 6축이 같은 기저를 공유하므로 16x16 정규방정식 하나를 6개 우변으로 풂
+void TemperatureBiasTable::fit(const std::vector<TemperatureSample>& samples, float smoothing) {
+    typedef Eigen::Matrix<double, POINTS, POINTS> Normal;
+    typedef Eigen::Matrix<double, POINTS, 6> Rhs;
+
+    Normal normal = Normal::Zero();
+    Rhs rhs = Rhs::Zero();
+    for (const TemperatureSample& s : samples) {
+        double x = (s.temperatureC - MIN_C) / STEP_C;
+        x = std::min(std::max(x, 0.0), POINTS - 1.0);
+        int i = std::min(static_cast<int>(x), POINTS - 2);
+        double w1 = x - i;
+        double w0 = 1.0 - w1;
+
+        Eigen::Matrix<double, 1, 6> y;
+        y << s.gyro.cast<double>().transpose(), s.accel.cast<double>().transpose();
+        normal(i, i) += w0 * w0;
+        normal(i, i + 1) += w0 * w1;
+        normal(i + 1, i) += w0 * w1;
+        normal(i + 1, i + 1) += w1 * w1;
+        rhs.row(i) += w0 * y;
+        rhs.row(i + 1) += w1 * y;
+    }
+
+    // 2차 차분 평활화 D^T D
+    double lambda = smoothing * std::max<size_t>(samples.size(), 1);
+    for (int k = 1; k < POINTS - 1; ++k) {
+        const int idx[3] = {k - 1, k, k + 1};
+        const double c[3] = {1.0, -2.0, 1.0};
+        for (int a = 0; a < 3; ++a) {
+            for (int b = 0; b < 3; ++b) {
+                normal(idx[a], idx[b]) += lambda * c[a] * c[b];
+            }
+        }
+    }
+    normal.diagonal().array() += 1e-9;  // 데이터가 전혀 없을 때 특이 행렬 방지
+
+    Rhs values = normal.ldlt().solve(rhs);
+    for (int k = 0; k < POINTS; ++k) {
+        rows[k].setZero();
+        rows[k].head<6>() = values.row(k).transpose().cast<float>();
+    }
+
+    // 기준 온도에서 0이 되도록 이동 (절대 바이어스는 온라인 추정이 담당)
+    Row reference = biasAt(REFERENCE_C);
+    for (Row& row : rows) {
+        row -= reference;
+    }
+    loaded = true;
+}
+
+bool TemperatureBiasTable::load(const std::string& path, uint32_t sensorSerial) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    TemperatureTableHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != TEMPERATURE_TABLE_MAGIC || header.version != VERSION || header.points != POINTS
+        || header.minC != MIN_C || header.stepC != STEP_C) {
+        std::cerr << "Invalid temperature table: " << path << std::endl;
+        return false;
+    }
+    if (header.sensorSerial != sensorSerial) {
+        std::cerr << "Temperature table is for IMU " << header.sensorSerial << ", not " << sensorSerial << std::endl;
+        return false;
+    }
+    std::array<Row, POINTS> loadedRows;
+    file.read(reinterpret_cast<char*>(loadedRows.data()), sizeof(Row) * POINTS);
+    if (!file) {
+        return false;
+    }
+    rows = loadedRows;
+    loaded = true;
+    return true;
+}
+
+bool TemperatureBiasTable::save(const std::string& path, uint32_t sensorSerial) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        perror("Failed to write temperature table");
+        return false;
+    }
+    TemperatureTableHeader header = {TEMPERATURE_TABLE_MAGIC, VERSION, sensorSerial, POINTS, MIN_C, STEP_C};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(rows.data()), sizeof(Row) * POINTS);
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,60 @@
+// IMU 바이어스 온도 보정표
+// 일정 간격 온도 격자점마다 6축(자이로 3, 가속도 3) 바이어스 변화량을 저장하고 선형 보간하여 샘플마다 뺌
+// 값은 기준 온도(REFERENCE_C)에서 0인 변화량이며, 온도와 무관한 바이어스는 EKF/캘리브레이션 저장소가 담당
+// 한 행을 8개 float(6축 + 패딩)로 두어 보간이 4/8폭 SIMD 두 번(또는 한 번)으로 끝나도록 함
+#ifndef TEMPERATURE_COMPENSATION_H
+#define TEMPERATURE_COMPENSATION_H
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 정지 로그 샘플 하나 (오프라인 적합 입력)
+struct TemperatureSample {
+    float temperatureC;
+    Eigen::Vector3f gyro;
+    Eigen::Vector3f accel;
+};
+
+class TemperatureBiasTable {
+public:
+    static constexpr int POINTS = 16;
+    static constexpr float MIN_C = -20.0f;
+    static constexpr float STEP_C = 5.0f;          // -20 ~ 55°C
+    static constexpr float REFERENCE_C = 25.0f;
+    static constexpr uint32_t VERSION = 1;
+
+    typedef Eigen::Matrix<float, 8, 1> Row;        // gx gy gz ax ay az 0 0
+
+    TemperatureBiasTable();
+
+    // 샘플에서 온도에 따른 바이어스 변화량을 빼기 (표가 비어 있으면 변화 없음)
+    void correct(float temperatureC, Eigen::Vector3f& gyro, Eigen::Vector3f& accel) const {
+        float x = (temperatureC - MIN_C) * (1.0f / STEP_C);
+        x = !(x >= 0.0f) ? 0.0f : (x > POINTS - 1.0f ? POINTS - 1.0f : x);  // 범위 밖은 끝값 유지 (NaN → 0)
+        int i = static_cast<int>(x);
+        i = i > POINTS - 2 ? POINTS - 2 : i;
+        float frac = x - i;
+        Row bias = rows[i] + frac * (rows[i + 1] - rows[i]);
+        gyro -= bias.head<3>();
+        accel -= bias.segment<3>(3);
+    }
+
+    Row biasAt(float temperatureC) const;
+
+    // 정지 로그로부터 격자점 값을 최소제곱 적합 (구간 선형 기저 + 2차 차분 평활화)
+    // 데이터가 없는 구간은 평활화 항에 의해 선형 외삽, 가속도는 자세가 고정된 로그를 가정
+    void fit(const std::vector<TemperatureSample>& samples, float smoothing = 1e-2f);
+
+    bool load(const std::string& path, uint32_t sensorSerial);
+    bool save(const std::string& path, uint32_t sensorSerial) const;
+    bool isLoaded() const { return loaded; }
+
+private:
+    std::array<Row, POINTS> rows;
+    bool loaded = false;
+};
+
+#endif
@@ -0,0 +1,193 @@
+// 기압 센서 드라이버/고도 융합 벤치마크
+//   - 프레임 파서 처리량: 잡음 바이트가 섞인 GY-39 스트림 (MB/s, frames/s, 체크섬 오류 검출)
+//   - pressureToAltitude, EKF 기압 업데이트 1회 비용
+//   - 호버링 수직 유지: GPS 고도 융합 vs 기압 고도 융합 (GPS는 수평만) 수직 위치 RMS
+//     GPS는 pose_estimator처럼 측정 시각(수신 - 지연)으로 지연 업데이트, 기압은 현재 상태에 바로 적용
+//     (지연 GPS 재전파가 기압 보정을 다시 적용하는지 확인)
+//   - 바이어스 초기화 전 스텝으로 재전파: 고도 40m에서 첫 기압으로 바이어스를 잡은 뒤, 그보다 앞선 측정 시각의 GPS를 융합해도
+//     pD가 유지되는지 (GPS 고도 미사용, pose_estimator와 같은 설정)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_baro.cpp ../src/ioss/barometer_sensor.cpp ../src/psss/ekf.cpp ../src/oss/transport.cpp ../src/oss/blackbox.cpp ../src/oss/trace.cpp ../src/oss/timer.cpp -pthread -o bench_baro
+#include "../src/ioss/barometer_sensor.h"
+#include "../src/psss/ekf.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <vector>
+#include <cmath>
+
+const float GRAVITY = 9.80665f;
+const float IMU_DT = 0.0025f;
+const int STEPS = 400 * 300;       // 5분
+const int GPS_DIVIDER = 40;        // 10Hz
+const int BARO_DIVIDER = 16;       // 25Hz
+const int RMS_START = 400 * 30;
+const uint64_t IMU_DT_NS = 2500000ULL;
+const uint64_t GPS_DELAY_NS = 100000000ULL;  // 측정 → 수신 지연
+
+// GY-39 기압 프레임 하나를 만듦
+static void appendFrame(std::vector<uint8_t>& out, float temperature, float pressure, bool corrupt) {
+    int16_t t = static_cast<int16_t>(temperature * 100.0f);
+    int32_t p = static_cast<int32_t>(pressure * 100.0f);
+    uint8_t frame[15] = {0x5A, 0x5A, 0x45, 0x0A,
+                         uint8_t(t >> 8), uint8_t(t),
+                         uint8_t(p >> 24), uint8_t(p >> 16), uint8_t(p >> 8), uint8_t(p),
+                         0x12, 0x34, 0x00, 0x64, 0};
+    uint8_t sum = 0;
+    for (int i = 0; i < 14; ++i) {
+        sum += frame[i];
+    }
+    frame[14] = corrupt ? uint8_t(sum + 1) : sum;
+    out.insert(out.end(), frame, frame + 15);
+}
+
+void benchParser() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> stream;
+    int expected = 0, corrupted = 0;
+    for (int i = 0; i < 200000; ++i) {
+        bool corrupt = (i % 100 == 99);
+        appendFrame(stream, 25.0f + 0.01f * (i % 50), 100000.0f + i % 1000, corrupt);
+        corrupt ? ++corrupted : ++expected;
+        if (i % 10 == 0) {
+            stream.push_back(uint8_t(byte(rng)) & 0x7F);  // 동기 바이트가 아닌 잡음
+        }
+    }
+
+    BaroFrameParser parser;
+    BarometerData data = {};
+    int frames = 0;
+    uint64_t start = monotonicNs();
+    for (uint8_t b : stream) {
+        frames += parser.push(b, data);
+    }
+    double sec = nsToSec(monotonicNs() - start);
+
+    std::cout << "parser: " << stream.size() << " bytes, " << frames << "/" << expected << " frames, "
+              << parser.checksumErrors() << "/" << corrupted << " checksum errors" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  " << stream.size() / sec / 1e6 << " MB/s, " << frames / sec / 1e6 << " Mframes/s, "
+              << sec * 1e9 / stream.size() << " ns/byte" << std::endl;
+    std::cout << "  (GY-39 9600bps = 960 B/s, 64 frames/s 최대)" << std::endl;
+}
+
+void benchAltitude() {
+    const int N = 1000000;
+    volatile float sink = 0;
+    uint64_t start = monotonicNs();
+    for (int i = 0; i < N; ++i) {
+        sink = sink + pressureToAltitude(95000.0f + (i & 1023));
+    }
+    double ns = double(monotonicNs() - start) / N;
+    std::cout << "pressureToAltitude: " << std::setprecision(1) << ns << " ns, "
+              << "100000 Pa -> " << std::setprecision(2) << pressureToAltitude(100000.0f) << " m" << std::endl;
+}
+
+struct HoverResult {
+    double vertRms = 0, maxErr = 0, baroNs = 0;
+};
+
+// 고정 위치 호버링 (약한 수직 진동), GPS 고도는 느리게 떠도는 오차 + 노이즈
+HoverResult runHover(bool useBaro) {
+    std::mt19937 rng(13);
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    std::unique_ptr<EKF> ekf(new EKF());
+    ekf->setGpsNoise(1.0f, 0.04f);
+    ekf->setGpsAltitudeFusion(!useBaro);
+    // 이륙 지점 기준 (기압 고도만으로는 절대 수직 위치를 알 수 없으므로 시작 위치는 참값)
+    ekf->initializeWithGPS(Eigen::Vector3f(0.0f, 0.0f, -2.0f), Eigen::Vector3f(0.0f, 0.0f, -150.0f));
+
+    const Eigen::Vector3f accelBias(0.02f, -0.01f, 0.05f);
+    float gpsAltWander = 0.0f;      // GPS 수직 오차 (1차 마르코프, 약 3m)
+    float baroBias = 3.0f;          // 기압 고도 바이어스 (m, 천천히 드리프트)
+    const float groundAltitude = 80.0f;
+
+    HoverResult r;
+    uint64_t baroNs = 0;
+    int baroCount = 0, count = 0;
+    for (int i = 0; i < STEPS; ++i) {
+        float t = i * IMU_DT;
+        float z = -2.0f - 0.3f * std::sin(0.5f * t);            // NED 아래 +
+        float az = 0.075f * std::sin(0.5f * t);
+        uint64_t timeNs = uint64_t(i + 1) * IMU_DT_NS;
+
+        Eigen::Vector3f accel(0.0f, 0.0f, az - GRAVITY);
+        accel += accelBias + 0.02f / std::sqrt(IMU_DT) * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        Eigen::Vector3f gyro = 0.002f / std::sqrt(IMU_DT) * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        ekf->predict(accel, gyro, IMU_DT, timeNs);
+
+        gpsAltWander += -gpsAltWander * IMU_DT / 30.0f + 3.0f * std::sqrt(2.0f * IMU_DT / 30.0f) * n(rng);
+        baroBias += 0.01f * std::sqrt(IMU_DT) * n(rng);
+
+        // 지연 시간 전의 참값으로 만든 GPS를 측정 시각으로 융합
+        if (i % GPS_DIVIDER == 0) {
+            float tm = t - GPS_DELAY_NS * 1e-9f;
+            float zm = -2.0f - 0.3f * std::sin(0.5f * tm);
+            float vzm = -0.15f * std::cos(0.5f * tm);
+            Eigen::Vector3f pos(0.5f * n(rng), 0.5f * n(rng), zm + gpsAltWander + 0.5f * n(rng));
+            Eigen::Vector3f vel = 1000.0f * Eigen::Vector3f(0.1f * n(rng), 0.1f * n(rng), vzm + 0.2f * n(rng));
+            if (timeNs > GPS_DELAY_NS) {
+                ekf->updateWithGPS(pos, vel, timeNs - GPS_DELAY_NS);
+            }
+        }
+        if (useBaro && i % BARO_DIVIDER == 0) {
+            float altitude = groundAltitude - z + baroBias + 0.3f * n(rng);
+            uint64_t start = monotonicNs();
+            ekf->updateWithBaro(altitude);
+            baroNs += monotonicNs() - start;
+            ++baroCount;
+        }
+        if (i >= RMS_START) {
+            double err = ekf->getState()(2) - z;
+            r.vertRms += err * err;
+            r.maxErr = std::max(r.maxErr, std::fabs(err));
+            ++count;
+        }
+    }
+    r.vertRms = std::sqrt(r.vertRms / count);
+    r.baroNs = baroCount ? baroNs / double(baroCount) : 0.0;
+    return r;
+}
+
+// 정지 상태에서 첫 기압 샘플로 바이어스 초기화, 초기화 이전 시각의 GPS를 지연 융합한 뒤의 pD 오차 (m)
+float seedReplayError() {
+    const float siteAltitude = 40.0f;
+    std::unique_ptr<EKF> ekf(new EKF());
+    ekf->setGpsAltitudeFusion(false);
+    ekf->initializeWithGPS(Eigen::Vector3f::Zero(), Eigen::Vector3f::Zero());
+    const Eigen::Vector3f accel(0.0f, 0.0f, -GRAVITY);
+    const Eigen::Vector3f gyro = Eigen::Vector3f::Zero();
+
+    const int SEED_STEP = 40;
+    for (int i = 0; i < 80; ++i) {
+        ekf->predict(accel, gyro, IMU_DT, uint64_t(i + 1) * IMU_DT_NS);
+        if (i >= SEED_STEP && (i - SEED_STEP) % BARO_DIVIDER == 0) {
+            ekf->updateWithBaro(siteAltitude);  // 첫 호출은 바이어스 초기화
+        }
+    }
+    // 측정 시각이 바이어스 초기화보다 앞선 GPS (수직 성분은 융합하지 않음)
+    ekf->updateWithGPS(Eigen::Vector3f::Zero(), Eigen::Vector3f::Zero(), uint64_t(SEED_STEP / 2) * IMU_DT_NS);
+    return ekf->getState()(2);
+}
+
+int main() {
+    benchParser();
+    benchAltitude();
+
+    float seedError = seedReplayError();
+    bool seedOk = std::fabs(seedError) < 0.1f;
+    std::cout << std::fixed << std::setprecision(3) << "replay across baro bias seed: pD " << seedError << " m "
+              << (seedOk ? "ok" : "WRONG") << std::endl;
+
+    HoverResult gps = runHover(false);
+    HoverResult baro = runHover(true);
+    std::cout << std::endl << "hover (GPS alt 3m wander, baro 0.3m noise + drifting bias)" << std::endl;
+    std::cout << "vertical source   RMS[m]   max[m]   baro update[ns]" << std::endl;
+    std::cout << std::fixed << std::setprecision(3)
+              << "GPS altitude   " << std::setw(9) << gps.vertRms << std::setw(9) << gps.maxErr << std::endl
+              << "barometer      " << std::setw(9) << baro.vertRms << std::setw(9) << baro.maxErr
+              << std::setprecision(1) << std::setw(14) << baro.baroNs << std::endl;
+    return seedOk ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+// 블랙박스 벤치마크: 센서별 최대 선로 속도로 원시 바이트를 넣고
+//   - blackboxRead 호출당 비용 (기록 켬/끔 차이가 복사 비용)
+//   - 프로세스 CPU 사용률 증가분, 쓰기 스레드 CPU, 파일 쓰기 속도와 헤더 오버헤드
+//   - 기록 파일을 다시 읽어 장치별 덩어리/수신 시각이 비트 단위로 같은지
+// 장치마다 파이프 하나와 스레드 하나 (쓰고 바로 blackboxRead로 읽음)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -pthread bench_blackbox.cpp ../src/oss/blackbox.cpp ../src/oss/trace.cpp ../src/oss/timer.cpp -o bench_blackbox
+#include "../src/oss/blackbox.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <unistd.h>
+#include <sys/resource.h>
+
+const char* PATH = "/tmp/bench_blackbox.bin";
+const double SECONDS = 5.0;
+
+// 선로 속도 기준 최대 입력 (바이트/초, 한 번에 읽히는 덩어리 크기)
+struct DeviceLoad {
+    BlackboxDevice device;
+    const char* name;
+    double bytesPerSecond;
+    size_t chunk;
+};
+const DeviceLoad LOADS[] = {
+    {BLACKBOX_IMU, "IMU 921600bps", 92160, 64},
+    {BLACKBOX_GPS, "GPS 115200bps", 11520, 100},
+    {BLACKBOX_RC, "SBUS 100000bps 8E2", 9090, 25},
+    {BLACKBOX_BARO, "GY-39 9600bps", 960, 16},
+};
+const int DEVICES = 4;
+
+struct Received {
+    std::vector<uint64_t> times;
+    std::vector<uint8_t> bytes;
+    std::vector<uint32_t> sizes;
+    uint64_t readNs = 0;
+    uint64_t reads = 0;
+};
+
+void produce(const DeviceLoad& load, Received& out, uint64_t startNs) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return;
+    }
+    std::mt19937 rng(load.device);
+    std::vector<uint8_t> chunk(load.chunk), buffer(1024);
+    uint64_t intervalNs = static_cast<uint64_t>(load.chunk / load.bytesPerSecond * 1e9);
+    uint64_t next = startNs;
+    uint64_t end = startNs + static_cast<uint64_t>(SECONDS * 1e9);
+    while (next < end) {
+        while (monotonicNs() < next) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        for (uint8_t& b : chunk) {
+            b = static_cast<uint8_t>(rng());
+        }
+        if (write(fds[1], chunk.data(), chunk.size()) != static_cast<ssize_t>(chunk.size())) {
+            break;
+        }
+        uint64_t rxTime;
+        uint64_t t0 = monotonicNs();
+        ssize_t n = blackboxRead(load.device, fds[0], buffer.data(), buffer.size(), rxTime);
+        out.readNs += monotonicNs() - t0;
+        ++out.reads;
+        if (n > 0) {
+            out.times.push_back(rxTime);
+            out.sizes.push_back(static_cast<uint32_t>(n));
+            out.bytes.insert(out.bytes.end(), buffer.begin(), buffer.begin() + n);
+        }
+        next += intervalNs;
+    }
+    close(fds[0]);
+    close(fds[1]);
+}
+
+double processCpuSec() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+// 장치 스레드를 실제 속도로 돌리고 CPU 사용률(%) 반환
+double run(bool record, Received (&received)[DEVICES]) {
+    if (record) {
+        startBlackbox(PATH);
+    }
+    double cpu0 = processCpuSec();
+    uint64_t start = monotonicNs() + 10000000ULL;
+    std::vector<std::thread> threads;
+    for (int d = 0; d < DEVICES; ++d) {
+        threads.emplace_back(produce, std::cref(LOADS[d]), std::ref(received[d]), start);
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    if (record) {
+        stopBlackbox();
+    }
+    return (processCpuSec() - cpu0) / SECONDS * 100.0;
+}
+
+int main() {
+    Received plain[DEVICES], recorded[DEVICES];
+    double cpuPlain = run(false, plain);
+    double cpuRecorded = run(true, recorded);
+    BlackboxStats stats = blackboxStats();
+
+    std::cout << std::fixed << std::setprecision(0);
+    for (int d = 0; d < DEVICES; ++d) {
+        std::cout << std::left << std::setw(20) << LOADS[d].name << std::right
+                  << " blackboxRead off " << std::setw(5) << double(plain[d].readNs) / plain[d].reads << " ns"
+                  << ", on " << std::setw(5) << double(recorded[d].readNs) / recorded[d].reads << " ns per call ("
+                  << recorded[d].reads << " reads)" << std::endl;
+    }
+    std::cout << std::setprecision(2)
+              << "process CPU: off " << cpuPlain << " %, on " << cpuRecorded << " %  (writer thread "
+              << stats.writerCpuNs * 1e-7 / SECONDS << " %)" << std::endl
+              << "raw " << stats.rawBytes / SECONDS / 1024 << " KB/s in " << stats.chunks << " chunks -> file "
+              << stats.fileBytes / SECONDS / 1024 << " KB/s (" << std::setprecision(1)
+              << 100.0 * (double(stats.fileBytes) / stats.rawBytes - 1.0) << " % header overhead), "
+              << stats.dropped << " dropped" << std::endl;
+
+    // 다시 읽어 비교
+    BlackboxReader reader;
+    if (!reader.open(PATH)) {
+        std::cerr << "Failed to open recording" << std::endl;
+        return 1;
+    }
+    size_t index[DEVICES] = {}, offset[DEVICES] = {};
+    bool exact = true;
+    size_t chunks = 0;
+    BlackboxChunk chunk;
+    while (reader.next(chunk)) {
+        Received& r = recorded[chunk.device];
+        size_t i = index[chunk.device]++;
+        if (i >= r.sizes.size() || r.sizes[i] != chunk.size || r.times[i] != chunk.timestampNs || chunk.gap
+            || std::memcmp(r.bytes.data() + offset[chunk.device], chunk.data, chunk.size) != 0) {
+            exact = false;
+            break;
+        }
+        offset[chunk.device] += chunk.size;
+        ++chunks;
+    }
+    for (int d = 0; d < DEVICES; ++d) {
+        exact = exact && index[d] == recorded[d].sizes.size();
+    }
+    std::cout << "replay check: " << chunks << " chunks, " << (exact ? "bit-exact" : "MISMATCH") << std::endl;
+    std::remove(PATH);
+    return exact ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+// 캘리브레이션 저장소: 열기/조회/저장 비용, 기록 중단 복구, 부팅 후 준비까지 시간
+//   - cold: 파일 없음 → 정지 구간(StillnessDetector::WINDOW 샘플) 평균으로 초기화해야 준비
+//   - warm: 저장된 바이어스를 mmap으로 읽어 첫 IMU 샘플에서 바로 준비
+//   - 한 온도 구간에 반복 저장 (정지 중 60초 주기 저장): 다른 온도 구간과 다른 IMU의 레코드가 남는지
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_calibration_store.cpp ../src/psss/calibration_store.cpp ../src/oss/timer.cpp -o bench_calibration_store
+#include "../src/psss/calibration_store.h"
+#include "../src/psss/stillness_detector.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+const char* PATH = "/tmp/bench_calibration.bin";
+const uint32_t SERIAL = 100012345;
+const double IMU_PERIOD_MS = 2.5;  // 400Hz
+
+int main() {
+    std::remove(PATH);
+    const float gyro[3] = {0.01f, -0.008f, 0.005f};
+    const float accel[3] = {0.02f, -0.03f, 0.08f};
+
+    // 새 파일 생성
+    uint64_t start = monotonicNs();
+    {
+        CalibrationStore store;
+        store.open(PATH);
+    }
+    double createUs = (monotonicNs() - start) * 1e-3;
+
+    // 여러 온도에서 저장 (슬롯 순환 포함)
+    CalibrationStore store;
+    store.open(PATH);
+    const int saves = 1000;
+    start = monotonicNs();
+    for (int i = 0; i < saves; ++i) {
+        float g[3] = {gyro[0] + i * 1e-6f, gyro[1], gyro[2]};
+        store.save(SERIAL, 5.0f + (i % 4) * 10.0f, g, accel);
+    }
+    double saveUs = (monotonicNs() - start) * 1e-3 / saves;
+    store.close();
+
+    // 다시 열어 조회 (부팅 직후 경로)
+    start = monotonicNs();
+    CalibrationRecord record;
+    bool found = store.open(PATH) && store.find(SERIAL, NAN, record);
+    double warmUs = (monotonicNs() - start) * 1e-3;
+
+    const int lookups = 100000;
+    start = monotonicNs();
+    int hits = 0;
+    for (int i = 0; i < lookups; ++i) {
+        CalibrationRecord r;
+        hits += store.find(SERIAL, 20.0f + (i & 7), r);
+    }
+    double findNs = double(monotonicNs() - start) / lookups;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "create file:       " << createUs << " us" << std::endl
+              << "open + find (warm): " << warmUs << " us, found " << found << ", seq " << record.sequence
+              << ", gyroX " << std::setprecision(6) << record.gyroBias[0] << std::endl
+              << std::setprecision(1)
+              << "find:              " << findNs << " ns (" << hits << "/" << lookups << ")" << std::endl
+              << "save:              " << saveUs << " us" << std::endl;
+
+    // 최신 레코드를 기록 도중 끊긴 것처럼 훼손 → 이전 레코드로 복구되는지
+    store.close();
+    {
+        int fd = open(PATH, O_RDWR);
+        CalibrationStore probe;
+        probe.open(PATH);
+        CalibrationRecord newest;
+        probe.find(SERIAL, NAN, newest);
+        probe.close();
+        // 헤더 16바이트 뒤 레코드 배열에서 newest와 같은 시퀀스를 가진 슬롯을 찾아 gyroBias 한 바이트 변경
+        CalibrationRecord slot;
+        for (size_t i = 0; i < CalibrationStore::CAPACITY; ++i) {
+            off_t offset = 16 + i * sizeof(CalibrationRecord);
+            pread(fd, &slot, sizeof(slot), offset);
+            if (slot.sequence == newest.sequence) {
+                uint8_t b = 0xFF;
+                pwrite(fd, &b, 1, offset + offsetof(CalibrationRecord, gyroBias));
+                break;
+            }
+        }
+        close(fd);
+    }
+    store.open(PATH);
+    CalibrationRecord recovered;
+    store.find(SERIAL, NAN, recovered);
+    std::cout << "torn newest record: fell back to seq " << recovered.sequence << " (newest was " << record.sequence << ")" << std::endl;
+    store.close();
+
+    // 25°C 구간에 100번 저장해도 5°C 구간과 다른 시리얼의 레코드가 유지되는지
+    std::remove(PATH);
+    store.open(PATH);
+    const uint32_t OTHER_SERIAL = 100054321;
+    store.save(SERIAL, 5.0f, gyro, accel);
+    store.save(OTHER_SERIAL, 25.0f, gyro, accel);
+    for (int i = 0; i < 100; ++i) {
+        store.save(SERIAL, 25.0f, gyro, accel);
+    }
+    CalibrationRecord cold, other, repeated;
+    bool coldKept = store.find(SERIAL, 5.0f, cold) && cold.temperatureBucket == CalibrationStore::bucketOf(5.0f);
+    bool otherKept = store.find(OTHER_SERIAL, 25.0f, other);
+    bool repeatedNewest = store.find(SERIAL, 25.0f, repeated) && repeated.sequence == 102;
+    std::cout << "100 saves in one bucket: other bucket " << (coldKept ? "kept" : "LOST") << ", other serial "
+              << (otherKept ? "kept" : "LOST") << ", newest " << (repeatedNewest ? "ok" : "WRONG") << std::endl;
+    bool pass = coldKept && otherKept && repeatedNewest;
+    store.close();
+
+    // 부팅 후 첫 유효 자세까지 (센서 데이터 대기 시간 + 저장소 처리)
+    double coldMs = StillnessDetector::WINDOW * IMU_PERIOD_MS + createUs * 1e-3;
+    double warmMs = IMU_PERIOD_MS + warmUs * 1e-3;
+    std::cout << "time to ready: cold " << coldMs << " ms (still window), warm " << warmMs << " ms (first sample)" << std::endl;
+
+    std::remove(PATH);
+    return pass ? 0 : 1;
+}
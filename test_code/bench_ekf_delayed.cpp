@@ -0,0 +1,120 @@
+// EKF 지연 GPS 융합(히스토리 재전파) 비용 측정
+// 같은 예측 스텝(25ms 사전 적분 묶음)에 지연 GPS 두 개가 들어올 때 둘 다 반영되는지, 세 번째는 버리고 집계하는지
+// GPS 측정 시각 추정: 출력 지연이 50~150ms로 변할 때 고정 100ms 가정 vs iTOW 기반 GpsTimeAligner 오차 (주 넘김 포함)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_ekf_delayed.cpp ../src/psss/ekf.cpp ../src/oss/timer.cpp -o bench_ekf_delayed
+#include "../src/psss/ekf.h"
+#include "../src/psss/gps_time_aligner.h"
+#include "../src/oss/timer.h"
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+
+const uint64_t IMU_PERIOD_NS = 2500000;     // 400Hz
+const int GPS_DIVIDER = 40;                 // 10Hz
+const int DURATION_STEPS = 400 * 60;        // 60초
+
+void run(uint64_t gpsDelayNs) {
+    std::unique_ptr<EKF> ekf(new EKF());
+    uint64_t t = 1000000000ULL;
+    uint64_t predictNs = 0, updateNs = 0, replaySteps = 0;
+    int updates = 0;
+
+    for (int i = 0; i < DURATION_STEPS; ++i) {
+        // 천천히 회전하며 수평 가속하는 입력
+        Eigen::Vector3f gyro(0.02f, -0.01f, 0.2f);
+        Eigen::Vector3f accel(0.3f, 0.0f, -9.80665f);  // FRD: 정지 시 비력은 -g
+        t += IMU_PERIOD_NS;
+
+        uint64_t start = monotonicNs();
+        ekf->predict(accel, gyro, IMU_PERIOD_NS * 1e-9f, t);
+        predictNs += monotonicNs() - start;
+
+        if (i % GPS_DIVIDER == 0 && i > 0) {
+            Eigen::Vector3f pos(0.0f, 0.0f, 0.0f);
+            Eigen::Vector3f vel(0.0f, 0.0f, 0.0f);
+            start = monotonicNs();
+            if (gpsDelayNs == 0) {
+                ekf->updateWithGPS(pos, vel);
+            } else {
+                ekf->updateWithGPS(pos, vel, t - gpsDelayNs);
+            }
+            updateNs += monotonicNs() - start;
+            replaySteps += ekf->lastReplaySteps();
+            ++updates;
+        }
+    }
+
+    std::cout << std::setw(10) << gpsDelayNs / 1000000 << " ms"
+              << std::setw(14) << std::fixed << std::setprecision(1) << predictNs / double(DURATION_STEPS)
+              << std::setw(14) << updateNs / double(updates) / 1000.0
+              << std::setw(14) << replaySteps / double(updates)
+              << std::setw(12) << std::setprecision(2)
+              << (updateNs / double(updates)) * 10.0 / 1e7 << " %" << std::endl;
+}
+
+// 25ms 묶음 예측 스텝 하나 안의 측정 시각을 가진 GPS를 1개/2개/3개 융합한 뒤 수평 위치 분산
+bool sameStepFixes() {
+    const uint64_t BATCH_NS = 25000000ULL;
+    float variance[3];
+    uint64_t dropped = 0;
+    for (int fixes = 1; fixes <= 3; ++fixes) {
+        std::unique_ptr<EKF> ekf(new EKF());
+        uint64_t t = 1000000000ULL;
+        for (int i = 0; i < 8; ++i) {
+            t += BATCH_NS;
+            ekf->predict(Eigen::Vector3f(0.0f, 0.0f, -9.80665f), Eigen::Vector3f::Zero(), BATCH_NS * 1e-9f, t);
+        }
+        for (int k = 0; k < fixes; ++k) {
+            ekf->updateWithGPS(Eigen::Vector3f::Zero(), Eigen::Vector3f::Zero(), t - 4 * BATCH_NS + 5000000ULL * (k + 1));
+        }
+        variance[fixes - 1] = ekf->getCovariance()(0, 0);
+        dropped = ekf->droppedGps();
+    }
+    bool ok = variance[1] < variance[0] && variance[2] == variance[1] && dropped == 1;
+    std::cout << std::scientific << std::setprecision(3) << "same-step GPS fixes: P_nn 1 fix " << variance[0] << ", 2 fixes "
+              << variance[1] << ", 3 fixes " << variance[2] << " (dropped " << dropped << ") " << (ok ? "ok" : "WRONG") << std::endl;
+    return ok;
+}
+
+// 10Hz 600개 (1분), 수신기 시계와 CLOCK_MONOTONIC 차이는 임의 값, 중간에 iTOW 주 넘김
+void alignment() {
+    const uint32_t WEEK_MS = 604800000u;
+    const int64_t CLOCK_OFFSET_NS = 1234567890123LL;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> latencyMs(50, 150);
+    GpsTimeAligner aligner(50000000ULL);
+    double fixedSum = 0, fixedMax = 0, alignedSum = 0, alignedMax = 0;
+    int count = 0;
+    for (int i = 0; i < 600; ++i) {
+        uint64_t gpsMs = WEEK_MS - 30000u + 100u * i;    // 30초 뒤 주 넘김
+        uint32_t iTOW = static_cast<uint32_t>(gpsMs % WEEK_MS);
+        uint64_t measuredNs = gpsMs * 1000000ULL + CLOCK_OFFSET_NS;
+        uint64_t receiveNs = measuredNs + latencyMs(rng) * 1000000ULL;
+        double fixedErr = std::fabs(double(int64_t(receiveNs - 100000000ULL) - int64_t(measuredNs))) * 1e-6;
+        double alignedErr = std::fabs(double(int64_t(aligner.measurementTime(receiveNs, iTOW)) - int64_t(measuredNs))) * 1e-6;
+        if (i >= 10 && (i < 300 || i >= 310)) {   // 시작/주 넘김 직후 창이 찰 때까지 제외
+            fixedSum += fixedErr;
+            fixedMax = std::max(fixedMax, fixedErr);
+            alignedSum += alignedErr;
+            alignedMax = std::max(alignedMax, alignedErr);
+            ++count;
+        }
+    }
+    std::cout << std::fixed << std::setprecision(1) << "GPS measurement time error (latency 50..150 ms), mean/max ms:" << std::endl
+              << "  fixed 100 ms   " << fixedSum / count << " / " << fixedMax << std::endl
+              << "  iTOW aligned   " << alignedSum / count << " / " << alignedMax << std::endl;
+}
+
+int main() {
+    std::cout << "EKF history: " << EKF::HISTORY_SIZE << " steps, sizeof(EKF) = " << sizeof(EKF) << " bytes" << std::endl;
+    std::cout << "  GPS delay   predict[ns]  update[us]  replay steps   CPU@10Hz" << std::endl;
+    run(0);
+    run(50000000ULL);
+    run(100000000ULL);
+    run(150000000ULL);
+    bool pass = sameStepFixes();
+    alignment();
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+// 오차 상태 EKF 정확도/속도 비교
+// 합성 비행 데이터(원 선회 + 자세 기동, 400Hz IMU, 10Hz GPS)를 재생하여
+// 기존 방식(단위 Jacobian, 16차원 밀집 공분산)과 오차 상태 EKF를 비교
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_ekf_eskf.cpp ../src/psss/ekf.cpp ../src/oss/timer.cpp -o bench_ekf_eskf
+#include "../src/psss/ekf.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <vector>
+#include <cmath>
+
+const float GRAVITY = 9.80665f;
+const float IMU_DT = 0.0025f;
+const int GPS_DIVIDER = 40;
+const int STEPS = 400 * 120;  // 120초
+
+struct ReplaySample {
+    Eigen::Vector3f accel, gyro;      // 측정값 (노이즈 + 바이어스 포함)
+    Eigen::Vector3f truePos, trueVel;
+    Eigen::Quaternionf trueAtt;
+    bool hasGps;
+    Eigen::Vector3f gpsPos, gpsVel;   // gpsVel은 mm/s
+};
+
+// 합성 데이터 생성 (고정 시드, 결정적)
+std::vector<ReplaySample> makeDataset() {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    const Eigen::Vector3f gyroBias(0.004f, -0.003f, 0.002f);
+    const Eigen::Vector3f accelBias(0.05f, -0.04f, 0.03f);
+
+    std::vector<ReplaySample> data(STEPS);
+    Eigen::Vector3f p = Eigen::Vector3f::Zero();
+    Eigen::Vector3f v(0.0f, 4.0f, 0.0f);
+    Eigen::Quaternionf q = Eigen::Quaternionf::Identity();
+
+    for (int i = 0; i < STEPS; ++i) {
+        float t = i * IMU_DT;
+        // 원 선회 가속도 + 상하 기동, 자세는 롤/피치 진동과 일정 요 회전
+        Eigen::Vector3f accelWorld(-0.8f * std::cos(0.2f * t), -0.8f * std::sin(0.2f * t), 0.3f * std::sin(0.5f * t));
+        Eigen::Vector3f rate(0.3f * std::cos(0.7f * t), 0.2f * std::sin(0.9f * t), 0.2f);
+
+        ReplaySample& s = data[i];
+        Eigen::Vector3f specific = accelWorld - Eigen::Vector3f(0.0f, 0.0f, GRAVITY);
+        s.accel = q.toRotationMatrix().transpose() * specific + accelBias
+                + 0.02f / std::sqrt(IMU_DT) * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        s.gyro = rate + gyroBias + 0.002f / std::sqrt(IMU_DT) * Eigen::Vector3f(n(rng), n(rng), n(rng));
+
+        p += v * IMU_DT + 0.5f * accelWorld * IMU_DT * IMU_DT;
+        v += accelWorld * IMU_DT;
+        Eigen::Vector3f rv = rate * IMU_DT;
+        q = (q * Eigen::Quaternionf(Eigen::AngleAxisf(rv.norm(), rv.normalized()))).normalized();
+
+        s.truePos = p;
+        s.trueVel = v;
+        s.trueAtt = q;
+        s.hasGps = (i % GPS_DIVIDER == 0);
+        s.gpsPos = p + 0.3f * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        s.gpsVel = (v + 0.1f * Eigen::Vector3f(n(rng), n(rng), n(rng))) * 1000.0f;
+    }
+    return data;
+}
+
+// 기존 방식: 단위+dt Jacobian, 16x16 밀집 공분산 (중력 부호만 NED로 맞춤)
+class LegacyEKF {
+public:
+    LegacyEKF() {
+        state.setZero();
+        state(6) = 1.0f;
+        P = Eigen::MatrixXf::Identity(16, 16) * 0.05f;
+        Q = Eigen::MatrixXf::Zero(16, 16);
+        Q.block<3, 3>(0, 0) = Eigen::Matrix3f::Identity() * 0.05f;
+        Q.block<3, 3>(3, 3) = Eigen::Matrix3f::Identity() * 0.05f;
+        Q.block<4, 4>(6, 6) = Eigen::Matrix4f::Identity() * 0.001f;
+        R = Eigen::MatrixXf::Identity(6, 6) * 0.1f;
+    }
+
+    void predict(const Eigen::Vector3f& accel, const Eigen::Vector3f& gyro, float dt) {
+        Eigen::Quaternionf q(state(6), state(7), state(8), state(9));
+        Eigen::Vector3f rv = gyro * dt;
+        q = (q * Eigen::Quaternionf(Eigen::AngleAxisf(rv.norm(), rv.normalized()))).normalized();
+        Eigen::Vector3f a = q.toRotationMatrix() * accel;
+        a(2) += GRAVITY;
+        state.segment<3>(3) += a * dt;
+        state.segment<3>(0) += state.segment<3>(3) * dt + 0.5f * a * dt * dt;
+        state(6) = q.w();
+        state.segment<3>(7) = q.vec();
+        Eigen::MatrixXf J = Eigen::MatrixXf::Identity(16, 16);
+        J.block<3, 3>(0, 3) = Eigen::Matrix3f::Identity() * dt;
+        P = J * P * J.transpose() + Q;
+    }
+
+    void update(const Eigen::Vector3f& pos, const Eigen::Vector3f& vel) {
+        Eigen::VectorXf y(6);
+        y.segment<3>(0) = pos - state.segment<3>(0);
+        y.segment<3>(3) = vel / 1000.0f - state.segment<3>(3);
+        Eigen::MatrixXf H = Eigen::MatrixXf::Zero(6, 16);
+        H.block<3, 3>(0, 0) = Eigen::Matrix3f::Identity();
+        H.block<3, 3>(3, 3) = Eigen::Matrix3f::Identity();
+        Eigen::MatrixXf S = H * P * H.transpose() + R;
+        Eigen::MatrixXf K = P * H.transpose() * S.inverse();
+        state += K * y;
+        P = (Eigen::MatrixXf::Identity(16, 16) - K * H) * P;
+        Eigen::Quaternionf q(state(6), state(7), state(8), state(9));
+        q.normalize();
+        state(6) = q.w();
+        state.segment<3>(7) = q.vec();
+    }
+
+    Eigen::VectorXf getState() const { return state.head(10); }
+
+private:
+    Eigen::Matrix<float, 16, 1> state;
+    Eigen::MatrixXf P, Q, R;
+};
+
+struct Result {
+    double posRms = 0, velRms = 0, attRmsDeg = 0, predictNs = 0;
+};
+
+template <typename Filter>
+Result run(Filter& filter, const std::vector<ReplaySample>& data) {
+    Result r;
+    uint64_t predictNs = 0;
+    int count = 0;
+    for (int i = 0; i < STEPS; ++i) {
+        const ReplaySample& s = data[i];
+        uint64_t start = monotonicNs();
+        filter.predict(s.accel, s.gyro, IMU_DT);
+        predictNs += monotonicNs() - start;
+        if (s.hasGps) {
+            filter.update(s.gpsPos, s.gpsVel);
+        }
+        // 초기 수렴 10초 이후 오차 집계
+        if (i >= 4000) {
+            Eigen::VectorXf x = filter.getState();
+            Eigen::Quaternionf q(x(6), x(7), x(8), x(9));
+            r.posRms += (x.segment<3>(0) - s.truePos).squaredNorm();
+            r.velRms += (x.segment<3>(3) - s.trueVel).squaredNorm();
+            float angle = 2.0f * std::acos(std::min(1.0f, std::fabs(q.normalized().dot(s.trueAtt))));
+            r.attRmsDeg += angle * angle;
+            ++count;
+        }
+    }
+    r.posRms = std::sqrt(r.posRms / count);
+    r.velRms = std::sqrt(r.velRms / count);
+    r.attRmsDeg = std::sqrt(r.attRmsDeg / count) * 180.0 / M_PI;
+    r.predictNs = predictNs / double(STEPS);
+    return r;
+}
+
+// EKF의 updateWithGPS 이름에 맞추는 어댑터
+struct ErrorStateAdapter {
+    EKF ekf;
+    void predict(const Eigen::Vector3f& a, const Eigen::Vector3f& g, float dt) { ekf.predict(a, g, dt); }
+    void update(const Eigen::Vector3f& p, const Eigen::Vector3f& v) { ekf.updateWithGPS(p, v); }
+    Eigen::VectorXf getState() const { return ekf.getState(); }
+};
+
+// 같은 희소 구조의 F를 밀집 ERROR_SIZE x ERROR_SIZE로 곱했을 때의 비용 (기압 바이어스는 단위 블록)
+typedef Eigen::Matrix<float, EKF::ERROR_SIZE, EKF::ERROR_SIZE> DenseErrorMatrix;
+
+double denseTransitionNs(float& sink) {
+    DenseErrorMatrix F = DenseErrorMatrix::Identity();
+    F.block<3, 3>(0, 3) = Eigen::Matrix3f::Identity() * IMU_DT;
+    F.block<3, 3>(3, 6) = Eigen::Matrix3f::Random() * IMU_DT;
+    F.block<3, 3>(3, 12) = -Eigen::Matrix3f::Identity() * IMU_DT;
+    F.block<3, 3>(6, 6) = Eigen::Matrix3f::Identity();
+    F.block<3, 3>(6, 9) = -Eigen::Matrix3f::Identity() * IMU_DT;
+    DenseErrorMatrix P = DenseErrorMatrix::Identity() * 0.01f;
+    const int N = 200000;
+    uint64_t start = monotonicNs();
+    for (int i = 0; i < N; ++i) {
+        P = (F * P * F.transpose()).eval();
+        P(0, 0) += 1e-9f;
+    }
+    sink = P(0, 0);
+    return (monotonicNs() - start) / double(N);
+}
+
+int main() {
+    std::vector<ReplaySample> data = makeDataset();
+
+    std::unique_ptr<LegacyEKF> legacy(new LegacyEKF());
+    std::unique_ptr<ErrorStateAdapter> eskf(new ErrorStateAdapter());
+    Result a = run(*legacy, data);
+    Result b = run(*eskf, data);
+    float sink = 0.0f;
+    double dense = denseTransitionNs(sink);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "filter              pos RMS[m]  vel RMS[m/s]  att RMS[deg]  predict[ns]" << std::endl;
+    std::cout << "legacy (identity J) " << std::setw(10) << a.posRms << std::setw(14) << a.velRms
+              << std::setw(14) << a.attRmsDeg << std::setw(13) << std::setprecision(1) << a.predictNs << std::endl;
+    std::cout << std::setprecision(3);
+    std::cout << "error-state (" << EKF::ERROR_SIZE << ")    " << std::setw(10) << b.posRms << std::setw(14) << b.velRms
+              << std::setw(14) << b.attRmsDeg << std::setw(13) << std::setprecision(1) << b.predictNs << std::endl;
+    std::cout << "dense " << EKF::ERROR_SIZE << "x" << EKF::ERROR_SIZE << " F P F^T alone: " << dense << " ns (" << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,87 @@
+// GPS 업데이트: 밀집(6x6 S 역행렬) vs 스칼라 순차 업데이트 비교
+// 같은 입력을 두 필터에 넣고 업데이트 1회당 시간, 연산량(FLOPs), 결과 차이, 공분산 대칭성 확인
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_ekf_gps_update.cpp ../src/psss/ekf.cpp ../src/oss/timer.cpp -o bench_ekf_gps_update
+#include "../src/psss/ekf.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <cmath>
+
+const float IMU_DT = 0.0025f;
+const int GPS_DIVIDER = 40;
+const int STEPS = 400 * 60;  // 60초
+
+struct Result {
+    double updateNs = 0;
+    int updates = 0;
+    float maxAsymmetry = 0;
+    float minDiagonal = 1e9f;
+};
+
+// 업데이트 1회 FLOPs (곱셈+덧셈, n = 15, m = 6)
+// 밀집: H P, (H P) H^T, S^-1(LU ~ 2m^3), P H^T, K = P H^T S^-1, K y, I - K H, (I - K H) P
+long denseFlops() {
+    const long n = EKF::ERROR_SIZE, m = 6;
+    return 2 * m * n * n + 2 * m * n * m + 2 * m * m * m + 2 * n * n * m + 2 * n * m * m + 2 * n * m
+         + 2 * n * m * n + 2 * n * n * n;
+}
+
+// 순차(Joseph): 성분당 s(1), K(n), dx 갱신(2n+1), P -= K p^T(2n^2), rK - m(2n), P += (rK - m)K^T(2n^2), 대칭화(n(n-1))
+long sequentialFlops() {
+    const long n = EKF::ERROR_SIZE, m = 6;
+    return m * (1 + n + 2 * n + 1 + 2 * n * n + 2 * n + 2 * n * n + n * (n - 1));
+}
+
+Result run(EKF& ekf, bool sequential, Eigen::VectorXf& finalState) {
+    ekf.setSequentialUpdate(sequential);
+    std::mt19937 rng(3);
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    Result r;
+
+    for (int i = 0; i < STEPS; ++i) {
+        float t = i * IMU_DT;
+        Eigen::Vector3f gyro(0.1f * std::cos(0.5f * t), 0.05f, 0.2f);
+        Eigen::Vector3f accel(0.3f * std::sin(0.2f * t), 0.0f, -9.80665f);
+        ekf.predict(accel, gyro, IMU_DT);
+
+        if (i % GPS_DIVIDER == 0) {
+            Eigen::Vector3f pos(n(rng), n(rng), n(rng));
+            Eigen::Vector3f vel = 100.0f * Eigen::Vector3f(n(rng), n(rng), n(rng));
+            uint64_t start = monotonicNs();
+            ekf.updateWithGPS(pos, vel);
+            r.updateNs += monotonicNs() - start;
+            ++r.updates;
+
+            const EKF::ErrorMatrix& P = ekf.getCovariance();
+            r.maxAsymmetry = std::max(r.maxAsymmetry, (P - P.transpose()).cwiseAbs().maxCoeff());
+            r.minDiagonal = std::min(r.minDiagonal, P.diagonal().minCoeff());
+        }
+    }
+    r.updateNs /= r.updates;
+    finalState = ekf.getState();
+    return r;
+}
+
+int main() {
+    std::unique_ptr<EKF> dense(new EKF());
+    std::unique_ptr<EKF> sequential(new EKF());
+    Eigen::VectorXf denseState, sequentialState;
+    Result a = run(*dense, false, denseState);
+    Result b = run(*sequential, true, sequentialState);
+
+    std::cout << std::fixed;
+    std::cout << "update          FLOPs   time[ns]   max|P-P^T|   min diag(P)" << std::endl;
+    std::cout << "dense      " << std::setw(9) << denseFlops() << std::setw(11) << std::setprecision(1) << a.updateNs
+              << std::setw(13) << std::scientific << std::setprecision(2) << a.maxAsymmetry
+              << std::setw(14) << a.minDiagonal << std::fixed << std::endl;
+    std::cout << "sequential " << std::setw(9) << sequentialFlops() << std::setw(11) << std::setprecision(1) << b.updateNs
+              << std::setw(13) << std::scientific << std::setprecision(2) << b.maxAsymmetry
+              << std::setw(14) << b.minDiagonal << std::fixed << std::endl;
+    std::cout << "max |state diff| after " << a.updates << " updates: " << std::scientific
+              << (denseState - sequentialState).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << "max |P diff|: " << (dense->getCovariance() - sequential->getCovariance()).cwiseAbs().maxCoeff()
+              << std::endl;
+    return 0;
+}
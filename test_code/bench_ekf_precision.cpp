@@ -0,0 +1,150 @@
+// EKF 스칼라 타입별 비용/드리프트 비교 (float, double 상태 + float 공분산, double)
+// 같은 합성 재생 로그를 원점 부근과 원점에서 먼 NED 위치에서 각각 재생
+//   - GPS 구간: 노이즈 있는 IMU/GPS, 위치/속도 RMS 오차
+//   - GPS 단절 구간: 노이즈 없는 입력으로 수렴시킨 뒤 GPS 없이 60초 항법, 최종 위치 드리프트
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_ekf_precision.cpp ../src/psss/ekf.cpp ../src/oss/timer.cpp -o bench_ekf_precision
+#include "../src/psss/ekf.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <vector>
+#include <cmath>
+
+const double GRAVITY = 9.80665;
+const double IMU_DT = 0.0025;
+const int GPS_DIVIDER = 40;
+const int STEPS = 400 * 120;          // 120초
+const int OUTAGE_START = 400 * 60;    // 드리프트 시험: 60초 이후 GPS 없음
+
+struct ReplaySample {
+    Eigen::Vector3d accel, gyro;
+    Eigen::Vector3d truePos, trueVel;
+    bool hasGps;
+    Eigen::Vector3d gpsPos, gpsVel;   // gpsVel은 mm/s
+};
+
+// 합성 데이터 (고정 시드). noisy = false이면 센서/GPS 노이즈 없음
+std::vector<ReplaySample> makeDataset(const Eigen::Vector3d& origin, bool noisy) {
+    std::mt19937 rng(11);
+    std::normal_distribution<double> n(0.0, noisy ? 1.0 : 0.0);
+    const Eigen::Vector3d gyroBias(0.004, -0.003, 0.002);
+    const Eigen::Vector3d accelBias(0.05, -0.04, 0.03);
+
+    std::vector<ReplaySample> data(STEPS);
+    Eigen::Vector3d p = origin;
+    Eigen::Vector3d v(15.0, 5.0, 0.0);
+    Eigen::Quaterniond q = Eigen::Quaterniond::Identity();
+
+    for (int i = 0; i < STEPS; ++i) {
+        double t = i * IMU_DT;
+        Eigen::Vector3d accelWorld(-0.8 * std::cos(0.2 * t), -0.8 * std::sin(0.2 * t), 0.3 * std::sin(0.5 * t));
+        Eigen::Vector3d rate(0.3 * std::cos(0.7 * t), 0.2 * std::sin(0.9 * t), 0.2);
+
+        ReplaySample& s = data[i];
+        Eigen::Vector3d specific = accelWorld - Eigen::Vector3d(0.0, 0.0, GRAVITY);
+        s.accel = q.toRotationMatrix().transpose() * specific + accelBias
+                + 0.02 / std::sqrt(IMU_DT) * Eigen::Vector3d(n(rng), n(rng), n(rng));
+        s.gyro = rate + gyroBias + 0.002 / std::sqrt(IMU_DT) * Eigen::Vector3d(n(rng), n(rng), n(rng));
+
+        p += v * IMU_DT + 0.5 * accelWorld * IMU_DT * IMU_DT;
+        v += accelWorld * IMU_DT;
+        Eigen::Vector3d rv = rate * IMU_DT;
+        q = (q * Eigen::Quaterniond(Eigen::AngleAxisd(rv.norm(), rv.normalized()))).normalized();
+
+        s.truePos = p;
+        s.trueVel = v;
+        s.hasGps = (i % GPS_DIVIDER == 0);
+        s.gpsPos = p + 0.3 * Eigen::Vector3d(n(rng), n(rng), n(rng));
+        s.gpsVel = (v + 0.1 * Eigen::Vector3d(n(rng), n(rng), n(rng))) * 1000.0;
+    }
+    return data;
+}
+
+struct Result {
+    double posRms = 0, velRms = 0, predictNs = 0, updateNs = 0, driftM = 0;
+};
+
+// GPS 구간 정확도와 비용
+template <typename Scalar, typename CovScalar>
+void runWithGps(const std::vector<ReplaySample>& data, Result& r) {
+    typedef typename BasicEKF<Scalar, CovScalar>::Vector3 Vector3;
+    std::unique_ptr<BasicEKF<Scalar, CovScalar>> ekf(new BasicEKF<Scalar, CovScalar>());
+    ekf->initializeWithGPS(data[0].gpsPos.cast<Scalar>(), data[0].gpsVel.cast<Scalar>());
+
+    uint64_t predictNs = 0, updateNs = 0;
+    int updates = 0, count = 0;
+    for (int i = 0; i < STEPS; ++i) {
+        const ReplaySample& s = data[i];
+        Vector3 accel = s.accel.cast<Scalar>();
+        Vector3 gyro = s.gyro.cast<Scalar>();
+        uint64_t start = monotonicNs();
+        ekf->predict(accel, gyro, Scalar(IMU_DT));
+        predictNs += monotonicNs() - start;
+        if (s.hasGps) {
+            Vector3 pos = s.gpsPos.cast<Scalar>();
+            Vector3 vel = s.gpsVel.cast<Scalar>();
+            start = monotonicNs();
+            ekf->updateWithGPS(pos, vel);
+            updateNs += monotonicNs() - start;
+            ++updates;
+        }
+        if (i >= 4000) {
+            Eigen::VectorXd x = ekf->getState().template cast<double>();
+            r.posRms += (x.segment<3>(0) - s.truePos).squaredNorm();
+            r.velRms += (x.segment<3>(3) - s.trueVel).squaredNorm();
+            ++count;
+        }
+    }
+    r.posRms = std::sqrt(r.posRms / count);
+    r.velRms = std::sqrt(r.velRms / count);
+    r.predictNs = predictNs / double(STEPS);
+    r.updateNs = updateNs / double(updates);
+}
+
+// GPS 단절 후 관성 항법 드리프트 (노이즈 없는 입력)
+template <typename Scalar, typename CovScalar>
+void runOutage(const std::vector<ReplaySample>& data, Result& r) {
+    std::unique_ptr<BasicEKF<Scalar, CovScalar>> ekf(new BasicEKF<Scalar, CovScalar>());
+    ekf->initializeWithGPS(data[0].gpsPos.cast<Scalar>(), data[0].gpsVel.cast<Scalar>());
+    for (int i = 0; i < STEPS; ++i) {
+        const ReplaySample& s = data[i];
+        ekf->predict(s.accel.cast<Scalar>(), s.gyro.cast<Scalar>(), Scalar(IMU_DT));
+        if (s.hasGps && i < OUTAGE_START) {
+            ekf->updateWithGPS(s.gpsPos.cast<Scalar>(), s.gpsVel.cast<Scalar>());
+        }
+    }
+    Eigen::VectorXd x = ekf->getState().template cast<double>();
+    r.driftM = (x.segment<3>(0) - data[STEPS - 1].truePos).norm();
+}
+
+template <typename Scalar, typename CovScalar>
+void report(const char* name, const std::vector<ReplaySample>& noisy, const std::vector<ReplaySample>& clean) {
+    Result r;
+    runWithGps<Scalar, CovScalar>(noisy, r);
+    runOutage<Scalar, CovScalar>(clean, r);
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << r.posRms << std::setw(11) << r.velRms << std::setw(12) << r.driftM
+              << std::setprecision(1) << std::setw(13) << r.predictNs << std::setw(12) << r.updateNs
+              << std::setw(8) << sizeof(BasicEKF<Scalar, CovScalar>) / 1024 << " KB" << std::endl;
+}
+
+int main() {
+    const Eigen::Vector3d origins[2] = {
+        Eigen::Vector3d(0.0, 0.0, 0.0),
+        Eigen::Vector3d(120000.0, -80000.0, -500.0),  // 홈에서 약 144km 떨어진 NED 위치
+    };
+
+    for (const Eigen::Vector3d& origin : origins) {
+        std::vector<ReplaySample> noisy = makeDataset(origin, true);
+        std::vector<ReplaySample> clean = makeDataset(origin, false);
+        std::cout << "start offset " << std::fixed << std::setprecision(0) << origin.norm() << " m" << std::endl;
+        std::cout << "config                pos RMS[m] vel RMS[m/s] drift60s[m] predict[ns] update[ns]    size" << std::endl;
+        report<float, float>("float", noisy, clean);
+        report<double, float>("double state/float P", noisy, clean);
+        report<double, double>("double", noisy, clean);
+        std::cout << std::endl;
+    }
+    return 0;
+}
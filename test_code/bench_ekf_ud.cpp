@@ -0,0 +1,148 @@
+// 공분산 표현별 수치 건전성/비용 비교 (단정밀도)
+//   - standard dense : (I - K H) P 밀집 업데이트
+//   - standard seq   : 스칼라 순차 업데이트 (대칭형)
+//   - UD             : Thornton 전파 + Bierman 업데이트
+// 두 가지 조건에서 시간에 따른 P의 최소 고유값, 음수 고유값 발생 횟수, 위치 오차, 실행 시간을 측정
+//   - continuous: 1cm GPS 100Hz 연속
+//   - outage    : 1mm RTK 400Hz, 60~240초 단절 후 재수신 (큰 P에 작은 r 업데이트)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_ekf_ud.cpp ../src/psss/ekf.cpp ../src/oss/timer.cpp -o bench_ekf_ud
+#include "../src/psss/ekf.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <vector>
+#include <cmath>
+
+const float GRAVITY = 9.80665f;
+const float IMU_DT = 0.0025f;
+const int STEPS = 400 * 300;          // 5분
+const int EIGEN_DIVIDER = 40;         // 0.1초마다 고유값 검사
+const int RMS_START = 400 * 250;      // 위치 오차는 마지막 50초 동안 집계
+
+struct Scenario {
+    const char* name;
+    int gpsDivider;
+    float posSigma;     // m
+    float velSigma;     // m/s
+    int outageStart;    // GPS 단절 구간 (스텝)
+    int outageEnd;
+};
+
+struct ReplaySample {
+    Eigen::Vector3f accel, gyro;
+    Eigen::Vector3f truePos;
+    bool hasGps;
+    Eigen::Vector3f gpsPos, gpsVel;   // gpsVel은 mm/s
+};
+
+std::vector<ReplaySample> makeDataset(const Scenario& sc) {
+    std::mt19937 rng(5);
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    const Eigen::Vector3f gyroBias(0.004f, -0.003f, 0.002f);
+    const Eigen::Vector3f accelBias(0.05f, -0.04f, 0.03f);
+
+    std::vector<ReplaySample> data(STEPS);
+    Eigen::Vector3f p = Eigen::Vector3f::Zero();
+    Eigen::Vector3f v(0.0f, 4.0f, 0.0f);
+    Eigen::Quaternionf q = Eigen::Quaternionf::Identity();
+
+    for (int i = 0; i < STEPS; ++i) {
+        float t = i * IMU_DT;
+        Eigen::Vector3f accelWorld(-0.8f * std::cos(0.2f * t), -0.8f * std::sin(0.2f * t), 0.3f * std::sin(0.5f * t));
+        Eigen::Vector3f rate(0.3f * std::cos(0.7f * t), 0.2f * std::sin(0.9f * t), 0.2f);
+
+        ReplaySample& s = data[i];
+        Eigen::Vector3f specific = accelWorld - Eigen::Vector3f(0.0f, 0.0f, GRAVITY);
+        s.accel = q.toRotationMatrix().transpose() * specific + accelBias
+                + 0.02f / std::sqrt(IMU_DT) * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        s.gyro = rate + gyroBias + 0.002f / std::sqrt(IMU_DT) * Eigen::Vector3f(n(rng), n(rng), n(rng));
+
+        p += v * IMU_DT + 0.5f * accelWorld * IMU_DT * IMU_DT;
+        v += accelWorld * IMU_DT;
+        Eigen::Vector3f rv = rate * IMU_DT;
+        q = (q * Eigen::Quaternionf(Eigen::AngleAxisf(rv.norm(), rv.normalized()))).normalized();
+
+        s.truePos = p;
+        s.hasGps = (i % sc.gpsDivider == 0) && (i < sc.outageStart || i >= sc.outageEnd);
+        s.gpsPos = p + sc.posSigma * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        s.gpsVel = (v + sc.velSigma * Eigen::Vector3f(n(rng), n(rng), n(rng))) * 1000.0f;
+    }
+    return data;
+}
+
+struct Result {
+    double predictNs = 0, updateNs = 0, posRms = 0;
+    double minEigen = 1e9, finalMinEigen = 0;
+    int negativeCount = 0, checks = 0;
+};
+
+Result run(const Scenario& sc, const std::vector<ReplaySample>& data, EKF::CovarianceForm form, bool sequential) {
+    std::unique_ptr<EKF> ekf(new EKF());
+    ekf->setCovarianceForm(form);
+    ekf->setSequentialUpdate(sequential);
+    ekf->setGpsNoise(sc.posSigma * sc.posSigma, sc.velSigma * sc.velSigma);
+
+    Result r;
+    uint64_t predictNs = 0, updateNs = 0;
+    int updates = 0, count = 0;
+    for (int i = 0; i < STEPS; ++i) {
+        const ReplaySample& s = data[i];
+        uint64_t start = monotonicNs();
+        ekf->predict(s.accel, s.gyro, IMU_DT);
+        predictNs += monotonicNs() - start;
+        if (s.hasGps) {
+            start = monotonicNs();
+            ekf->updateWithGPS(s.gpsPos, s.gpsVel);
+            updateNs += monotonicNs() - start;
+            ++updates;
+        }
+        if (i % EIGEN_DIVIDER == 0) {
+            // 고유값은 double로 계산하여 검사 자체의 반올림 영향을 줄임
+            Eigen::MatrixXd P = ekf->getCovariance().cast<double>();
+            P = 0.5 * (P + P.transpose());
+            double lambda = Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(P, Eigen::EigenvaluesOnly).eigenvalues()(0);
+            r.minEigen = std::min(r.minEigen, lambda);
+            r.finalMinEigen = lambda;
+            if (lambda <= 0.0) {
+                ++r.negativeCount;
+            }
+            ++r.checks;
+        }
+        if (i >= RMS_START) {
+            r.posRms += (ekf->getState().segment<3>(0) - s.truePos).squaredNorm();
+            ++count;
+        }
+    }
+    r.predictNs = predictNs / double(STEPS);
+    r.updateNs = updateNs / double(updates);
+    r.posRms = std::sqrt(r.posRms / count);
+    return r;
+}
+
+void print(const char* name, const Result& r) {
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << r.predictNs << std::setw(12) << r.updateNs
+              << std::scientific << std::setprecision(2) << std::setw(12) << r.minEigen
+              << std::setw(12) << r.finalMinEigen
+              << std::setw(8) << r.negativeCount << "/" << r.checks
+              << std::fixed << std::setprecision(4) << std::setw(11) << r.posRms << std::endl;
+}
+
+int main() {
+    const Scenario scenarios[2] = {
+        {"continuous (1cm, 100Hz)", 4, 0.01f, 0.01f, STEPS, STEPS},
+        {"outage (1mm, 400Hz, 60-240s gap)", 1, 0.001f, 0.001f, 400 * 60, 400 * 240},
+    };
+    for (const Scenario& sc : scenarios) {
+        std::vector<ReplaySample> data = makeDataset(sc);
+        std::cout << sc.name << std::endl;
+        std::cout << "form            predict[ns]  update[ns]  min eig     final eig   eig<=0     pos RMS[m]" << std::endl;
+        print("standard dense", run(sc, data, EKF::CovarianceForm::Standard, false));
+        print("standard seq", run(sc, data, EKF::CovarianceForm::Standard, true));
+        print("UD", run(sc, data, EKF::CovarianceForm::UD, true));
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+// 측지 → 로컬 NED 변환: 원점 근사(toNED) vs ECEF 기준 변환(toNEDExact)
+// 원점(서울)에서 거리별로 방위 36개 × 고도 3개 지점의 최대 오차와 변환 1회 시간
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_geodetic.cpp ../src/psss/geodetic.cpp ../src/oss/timer.cpp -o bench_geodetic
+#include "../src/psss/geodetic.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+
+const double HOME_LAT = 37.5665;
+const double HOME_LON = 126.9780;
+const double HOME_ALT = 50.0;
+
+struct Fix {
+    double lat, lon, alt;
+};
+
+// 원점에서 distance(m) 떨어진 원 위의 지점들 (위도 1도 ≈ 111km, 경도 1도 ≈ 88km)
+std::vector<Fix> ring(double distance) {
+    std::vector<Fix> fixes;
+    for (int k = 0; k < 36; ++k) {
+        double a = k * 10.0 * M_PI / 180.0;
+        for (double alt : {HOME_ALT, HOME_ALT + 100.0, HOME_ALT + 500.0}) {
+            fixes.push_back({HOME_LAT + distance * std::cos(a) / 111000.0,
+                             HOME_LON + distance * std::sin(a) / 88000.0, alt});
+        }
+    }
+    return fixes;
+}
+
+int main() {
+    LocalFrame frame;
+    frame.setOrigin(HOME_LAT, HOME_LON, HOME_ALT);
+
+    std::cout << "distance[m]  max err double[m]  max err float out[m]" << std::endl;
+    for (double distance : {100.0, 1000.0, 5000.0, 20000.0, 100000.0}) {
+        double worst = 0, worstFloat = 0;
+        for (const Fix& f : ring(distance)) {
+            Eigen::Vector3d exact = frame.toNEDExact(f.lat, f.lon, f.alt);
+            worst = std::max(worst, (frame.toNEDd(f.lat, f.lon, f.alt) - exact).norm());
+            worstFloat = std::max(worstFloat, (frame.toNED(f.lat, f.lon, f.alt).cast<double>() - exact).norm());
+        }
+        std::cout << std::setw(11) << std::fixed << std::setprecision(0) << distance
+                  << std::scientific << std::setprecision(2) << std::setw(19) << worst
+                  << std::setw(22) << worstFloat << std::endl;
+    }
+
+    // 변환 비용 (1e-7도 정수 입력을 GPS 경로와 같이 double로 변환)
+    std::vector<Fix> fixes = ring(2000.0);
+    const int rounds = 20000;
+    Eigen::Vector3d sink = Eigen::Vector3d::Zero();
+
+    uint64_t start = monotonicNs();
+    for (int r = 0; r < rounds; ++r) {
+        for (const Fix& f : fixes) {
+            sink += frame.toNEDd(f.lat, f.lon, f.alt + r * 1e-6);
+        }
+    }
+    double fastNs = double(monotonicNs() - start) / (rounds * fixes.size());
+
+    start = monotonicNs();
+    for (int r = 0; r < rounds; ++r) {
+        for (const Fix& f : fixes) {
+            sink += frame.toNEDExact(f.lat, f.lon, f.alt + r * 1e-6);
+        }
+    }
+    double exactNs = double(monotonicNs() - start) / (rounds * fixes.size());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "toNED (precomputed origin): " << fastNs << " ns/fix" << std::endl
+              << "toNEDExact (LLA->ECEF->NED): " << exactNs << " ns/fix" << std::endl
+              << "(checksum " << std::setprecision(3) << sink.sum() << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,220 @@
+// 로그 읽기 벤치마크: 실제 로거로 큰 로그를 만든 뒤 (페이지 캐시에 있는 상태로)
+//   - 열기 (꼬리/색인 블록만 읽음) vs 꼬리 없는 파일의 청크 머리 복구
+//   - 자세 레코드 필드 왕복 (ready, faults)
+//   - 전체 순차 검사 (fread로 모든 64바이트 칸의 종류 확인, version 1 형식에서 한 종류를 읽던 방식)
+//   - 커서로 전체/한 종류만 반복, 임의 시각 10ms 구간 검색
+//   - CSV/열 단위 변환
+// 처리량은 초당 레코드 수
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -pthread bench_log_reader.cpp ../src/oss/log_reader.cpp ../src/oss/binary_logger.cpp ../src/oss/timer.cpp -o bench_log_reader
+#include "../src/oss/log_reader.h"
+#include "../src/oss/binary_logger.h"
+#include "../src/oss/timer.h"
+#include "../src/psss/log_records.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <unistd.h>
+
+const char* LOG_PATH = "/tmp/bench_log_reader.log";
+const char* TRUNCATED_PATH = "/tmp/bench_log_reader_truncated.log";
+const uint64_t TICKS = 2000000;     // 400Hz 기준 약 83분 비행
+uint64_t firstNs = 0, lastNs = 0;   // 기록 시각 범위
+const uint32_t POSE_FAULTS = 0x5;   // 자세 레코드의 faults (읽기 왕복 확인용, 0이 아닌 값)
+
+// 링이 가득 차면 쓰기 스레드가 비울 때까지 양보
+template <typename T>
+void writeRecord(uint16_t type, const T& payload) {
+    while (!logWrite(type, payload)) {
+        std::this_thread::yield();
+    }
+}
+
+// 매 틱 IMU와 모터, 40틱마다 GPS와 자세
+uint64_t writeLog() {
+    startLogger(LOG_PATH, LOG_SCHEMAS, LOG_SCHEMA_COUNT);
+    uint64_t records = 0;
+    firstNs = monotonicNs();
+    for (uint64_t tick = 0; tick < TICKS; ++tick) {
+        ImuLog imu = {monotonicNs(), {0.01f * (tick % 100), 0, -9.8f}, {0.001f, 0, 0}, {0.3f, 0, 0.4f}};
+        writeRecord(LOG_IMU, imu);
+        MotorLog motor = {1200, {1200, 1210, 1190, 1200}};
+        writeRecord(LOG_MOTOR, motor);
+        records += 2;
+        if (tick % 40 == 0) {
+            GpsLog gps = {monotonicNs(), 375665000, 1269780000, 50000, {1000, 0, 0}, static_cast<uint32_t>(tick * 2.5), 12};
+            writeRecord(LOG_GPS, gps);
+            PoseLog pose = {{1, 2, 3}, {0.1f, 0, 0}, {0, 0, 90}, 1, POSE_FAULTS};
+            writeRecord(LOG_POSE, pose);
+            records += 2;
+        }
+    }
+    lastNs = monotonicNs();
+    stopLogger();
+    return records;
+}
+
+double seconds(uint64_t startNs) {
+    return (monotonicNs() - startNs) * 1e-9;
+}
+
+void report(const char* name, uint64_t records, double sec) {
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << records / 1e6 << " M" << std::setw(10) << sec * 1e3 << " ms"
+              << std::setw(10) << records / sec / 1e6 << " M rec/s" << std::endl;
+}
+
+int main() {
+    uint64_t written = writeLog();
+    LoggerStats stats = loggerStats();
+    std::cout << "log: " << written << " records, " << stats.bytes / (1024 * 1024) << " MB" << std::endl;
+
+    // 열기
+    LogReader reader;
+    uint64_t start = monotonicNs();
+    bool opened = reader.open(LOG_PATH);
+    double openSec = seconds(start);
+    if (!opened) {
+        return 1;
+    }
+    uint64_t total = 0;
+    for (uint16_t type : reader.recordTypes()) {
+        total += reader.recordCount(type);
+    }
+    std::cout << "open (index): " << std::setprecision(3) << openSec * 1e3 << " ms, " << reader.chunkCount() << " chunks, "
+              << total << " records" << (total == written ? "" : " MISMATCH") << std::endl;
+
+    // 자세 레코드 필드 왕복 (스키마 이름으로 찾아 디코딩)
+    {
+        const LogSchemaInfo* poseSchema = reader.findSchema(LOG_POSE);
+        const LogFieldInfo* ready = nullptr;
+        const LogFieldInfo* faults = nullptr;
+        for (const LogFieldInfo& field : poseSchema->fields) {
+            ready = field.name == "ready" ? &field : ready;
+            faults = field.name == "faults" ? &field : faults;
+        }
+        uint64_t poses = 0, matched = 0;
+        LogReader::Cursor cursor = reader.query(LOG_POSE);
+        const LogRecord* record;
+        while (ready && faults && cursor.next(record)) {
+            ++poses;
+            matched += logFieldValue(*record, *ready, 0) == 1 && logFieldValue(*record, *faults, 0) == POSE_FAULTS;
+        }
+        std::cout << "pose round trip (ready, faults): " << matched << "/" << poses
+                  << (poses > 0 && matched == poses ? "" : " MISMATCH") << std::endl;
+    }
+
+    // 꼬리와 마지막 청크 일부를 잘라 비정상 종료 흉내
+    {
+        FILE* in = fopen(LOG_PATH, "rb");
+        FILE* out = fopen(TRUNCATED_PATH, "wb");
+        std::vector<char> buffer(1 << 20);
+        size_t n;
+        while ((n = fread(buffer.data(), 1, buffer.size(), in)) > 0) {
+            fwrite(buffer.data(), 1, n, out);
+        }
+        fclose(in);
+        fclose(out);
+        truncate(TRUNCATED_PATH, stats.bytes - 100 * sizeof(LogRecord));
+        LogReader recovered;
+        start = monotonicNs();
+        recovered.open(TRUNCATED_PATH);
+        double recoverSec = seconds(start);
+        uint64_t recoveredRecords = 0;
+        for (uint16_t type : recovered.recordTypes()) {
+            recoveredRecords += recovered.recordCount(type);
+        }
+        std::cout << "open (no footer, scan chunk heads): " << recoverSec * 1e3 << " ms, " << recoveredRecords
+                  << " records recovered" << std::endl;
+        unlink(TRUNCATED_PATH);
+    }
+    std::cout << std::endl;
+
+    // 기준: 파일 전체를 읽으며 모든 칸의 종류 확인
+    {
+        start = monotonicNs();
+        FILE* in = fopen(LOG_PATH, "rb");
+        LogFileHeader header;
+        fread(&header, sizeof(header), 1, in);
+        fseek(in, header.schemaSize, SEEK_CUR);
+        std::vector<LogRecord> buffer(16384);
+        uint64_t slots = 0, gps = 0;
+        size_t n;
+        while ((n = fread(buffer.data(), sizeof(LogRecord), buffer.size(), in)) > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                gps += buffer[i].type == LOG_GPS;
+            }
+            slots += n;
+        }
+        fclose(in);
+        report("sequential scan (fread, GPS)", slots, seconds(start));
+        (void)gps;
+    }
+
+    // 커서: 모든 종류
+    {
+        start = monotonicNs();
+        uint64_t count = 0;
+        double sum = 0;
+        for (uint16_t type : reader.recordTypes()) {
+            LogReader::Cursor cursor = reader.query(type);
+            const LogRecord* record;
+            while (cursor.next(record)) {
+                sum += record->payload[0];
+                ++count;
+            }
+        }
+        report("cursor, all types", count, seconds(start));
+        (void)sum;
+    }
+
+    // 커서: GPS만 (다른 청크는 건너뜀), 기준 대비 시간
+    {
+        start = monotonicNs();
+        uint64_t count = 0;
+        LogReader::Cursor cursor = reader.query(LOG_GPS);
+        const LogRecord* record;
+        while (cursor.next(record)) {
+            ++count;
+        }
+        report("cursor, GPS only", count, seconds(start));
+    }
+
+    // 임의 시각 10ms 구간의 IMU 레코드
+    {
+        std::mt19937_64 rng(1);
+        const LogSchemaInfo* imu = reader.findSchema(LOG_IMU);
+        const int QUERIES = 10000;
+        uint64_t count = 0;
+        start = monotonicNs();
+        for (int q = 0; q < QUERIES; ++q) {
+            uint64_t from = firstNs + rng() % (lastNs - firstNs);
+            LogReader::Cursor cursor = reader.query(LOG_IMU, from, from + 10000000ULL);
+            const LogRecord* record;
+            while (cursor.next(record)) {
+                count += logFieldValue(*record, imu->fields[0], 0) > 0;
+            }
+        }
+        double sec = seconds(start);
+        std::cout << std::left << std::setw(34) << "seek, 10 ms IMU window" << std::right << std::setprecision(1)
+                  << std::setw(10) << sec / QUERIES * 1e6 << " us per query, " << count / QUERIES << " records" << std::endl;
+    }
+    std::cout << std::endl;
+
+    // 변환
+    {
+        const LogSchemaInfo* imu = reader.findSchema(LOG_IMU);
+        start = monotonicNs();
+        FILE* out = fopen("/tmp/bench_log_reader.ImuLog.csv", "w");
+        size_t rows = exportCsv(reader, *imu, out);
+        fclose(out);
+        report("CSV, ImuLog", rows, seconds(start));
+
+        start = monotonicNs();
+        rows = exportColumns(reader, *imu, "/tmp/bench_log_reader.ImuLog");
+        report("columns, ImuLog", rows, seconds(start));
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+// 루프 통계 벤치마크
+//   - begin()/end() 한 쌍의 비용 (시각 읽기 포함/제외)
+//   - 1ms 주기 태스크를 돌리며 다른 스레드가 계속 스냅샷: 스냅샷이 찢어지지 않는지 (히스토그램 합 == 횟수, 최소 <= 평균 <= 최대)
+//   - 히스토그램 백분위 vs 정확한 백분위 (상대 오차 12.5% 이하)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -pthread bench_loop_stats.cpp ../src/oss/loop_stats.cpp ../src/oss/timer.cpp -o bench_loop_stats
+#include "../src/oss/loop_stats.h"
+#include "../src/oss/timer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+int main() {
+    bool pass = true;
+
+    // 비용: 시각을 넘겨 기록만 / monotonicNs 포함
+    {
+        LoopStats& stats = registerLoop("cost", 0);
+        const int N = 10000000;
+        uint64_t start = monotonicNs();
+        uint64_t t = 1;
+        for (int i = 0; i < N; ++i) {
+            stats.begin(t);
+            stats.end(t + 500 + (i & 1023));
+            t += 1000;
+        }
+        double recordNs = static_cast<double>(monotonicNs() - start) / N;
+        LoopStats& clockStats = registerLoop("cost-clock", 0);
+        start = monotonicNs();
+        for (int i = 0; i < N / 10; ++i) {
+            clockStats.begin();
+            clockStats.end();
+        }
+        double clockNs = static_cast<double>(monotonicNs() - start) / (N / 10);
+        std::cout << std::fixed << std::setprecision(1) << "begin+end: " << recordNs << " ns (given time), " << clockNs
+                  << " ns (with monotonicNs)" << std::endl;
+    }
+
+    // 동시 스냅샷
+    {
+        LoopStats& stats = registerLoop("task", 1000000);
+        std::atomic<bool> running{true};
+        std::thread task([&] {
+            std::mt19937 rng(1);
+            while (running.load(std::memory_order_relaxed)) {
+                stats.begin();
+                uint64_t until = monotonicNs() + 50000 + rng() % 200000;   // 50~250us 일
+                while (monotonicNs() < until) {
+                }
+                stats.end();
+                usleep(700);
+            }
+        });
+        uint64_t snapshots = 0, torn = 0;
+        uint64_t deadline = monotonicNs() + 2000000000ULL;
+        while (monotonicNs() < deadline) {
+            LoopStatsSnapshot s;
+            stats.snapshot(s);
+            ++snapshots;
+            const LoopTiming& e = s.execution;
+            if (e.count != s.iterations || (e.count && (e.minNs > e.meanNs || e.meanNs > e.maxNs || e.p50Ns > e.maxNs))) {
+                ++torn;
+            }
+        }
+        running = false;
+        task.join();
+        LoopStatsSnapshot s;
+        stats.snapshot(s);
+        std::cout << "concurrent: " << snapshots << " snapshots, " << torn << " inconsistent, " << s.iterations << " iterations, "
+                  << s.overruns << " overruns" << std::endl;
+        pass = pass && torn == 0 && s.iterations > 0;
+    }
+
+    // 백분위 정확도 (로그 정규 분포 실행 시간)
+    {
+        LoopStats& stats = registerLoop("accuracy", 0);
+        std::mt19937_64 rng(2);
+        std::lognormal_distribution<double> dist(std::log(2e6), 0.5);   // 중앙값 2ms
+        std::vector<uint64_t> values;
+        uint64_t t = 1;
+        for (int i = 0; i < 200000; ++i) {
+            uint64_t v = static_cast<uint64_t>(dist(rng));
+            values.push_back(v);
+            stats.begin(t);
+            stats.end(t + v);
+            t += v + 1000;
+        }
+        std::sort(values.begin(), values.end());
+        LoopStatsSnapshot s;
+        stats.snapshot(s);
+        const double qs[3] = {0.50, 0.99, 0.999};
+        const uint64_t got[3] = {s.execution.p50Ns, s.execution.p99Ns, s.execution.p999Ns};
+        for (int i = 0; i < 3; ++i) {
+            uint64_t exact = values[static_cast<size_t>(qs[i] * values.size())];
+            double error = (static_cast<double>(got[i]) - exact) / exact;
+            std::cout << std::setprecision(1) << "p" << qs[i] * 100 << std::setprecision(3) << ": histogram " << got[i] * 1e-6 << " ms, exact "
+                      << exact * 1e-6 << " ms (" << std::setprecision(1) << error * 100 << "%)" << std::endl;
+            pass = pass && std::fabs(error) <= 0.125;
+        }
+    }
+
+    std::cout << std::endl;
+    printLoopStats(stdout);
+    std::cout << (pass ? "PASS" : "FAIL") << std::endl;
+    return pass ? 0 : 1;
+}
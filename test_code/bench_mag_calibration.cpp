@@ -0,0 +1,121 @@
+// 자기장 타원체 보정 벤치마크
+// 합성 hard-iron/soft-iron 왜곡 + 노이즈가 있는 샘플을 임의 자세로 생성하여
+//   - addSample / solve / apply 비용
+//   - 보정 전후 세기 오차, 방위(수평 성분 각도) 오차
+//   - 수평 회전만 있는 경우(커버리지 부족) 품질 검사로 결과를 거부하는지
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_mag_calibration.cpp ../src/psss/mag_calibrator.cpp ../src/oss/timer.cpp -o bench_mag_calibration
+#include "../src/psss/mag_calibrator.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cmath>
+
+const float FIELD = 0.5f;  // gauss
+const Eigen::Vector3f EARTH_FIELD = FIELD * Eigen::Vector3f(std::cos(0.94f), 0.0f, std::sin(0.94f));  // 복각 54도
+
+struct Distortion {
+    Eigen::Matrix3f softIron;   // 원시 = S m + h
+    Eigen::Vector3f hardIron;
+};
+
+Distortion makeDistortion() {
+    Distortion d;
+    d.softIron << 1.10f, 0.05f, -0.03f,
+                  0.05f, 0.92f, 0.04f,
+                 -0.03f, 0.04f, 1.03f;
+    d.hardIron = Eigen::Vector3f(0.21f, -0.14f, 0.35f);
+    return d;
+}
+
+// 임의 자세 (tiltOnly: yaw 전체, roll/pitch ±10도)
+std::vector<Eigen::Quaternionf> makeAttitudes(int n, bool tiltOnly, std::mt19937& rng) {
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    std::vector<Eigen::Quaternionf> q(n);
+    for (int i = 0; i < n; ++i) {
+        if (tiltOnly) {
+            q[i] = Eigen::AngleAxisf(float(M_PI) * u(rng), Eigen::Vector3f::UnitZ())
+                 * Eigen::AngleAxisf(0.17f * u(rng), Eigen::Vector3f::UnitY())
+                 * Eigen::AngleAxisf(0.17f * u(rng), Eigen::Vector3f::UnitX());
+        } else {
+            q[i] = Eigen::Quaternionf(Eigen::Vector4f(u(rng), u(rng), u(rng), u(rng)).normalized());
+        }
+    }
+    return q;
+}
+
+Eigen::Vector3f measure(const Distortion& d, const Eigen::Quaternionf& q, std::mt19937& rng) {
+    std::normal_distribution<float> n(0.0f, 0.003f);
+    Eigen::Vector3f body = q.conjugate() * EARTH_FIELD;
+    return d.softIron * body + d.hardIron + Eigen::Vector3f(n(rng), n(rng), n(rng));
+}
+
+// 동체 측정값으로 방위 오차 (참 자세로 월드로 돌린 수평 성분 각도)
+float headingError(const Eigen::Vector3f& body, const Eigen::Quaternionf& q) {
+    Eigen::Vector3f world = q * body;
+    return std::fabs(std::atan2(world.y(), world.x())) * 180.0f / float(M_PI);
+}
+
+void run(const char* name, bool tiltOnly) {
+    std::mt19937 rng(17);
+    Distortion d = makeDistortion();
+    MagCalibrator calibrator(FIELD);
+
+    const int N = 20000;
+    std::vector<Eigen::Quaternionf> attitudes = makeAttitudes(N, tiltOnly, rng);
+    std::vector<Eigen::Vector3f> raw(N);
+    for (int i = 0; i < N; ++i) {
+        raw[i] = measure(d, attitudes[i], rng);
+    }
+
+    uint64_t start = monotonicNs();
+    for (int i = 0; i < N; ++i) {
+        calibrator.addSample(raw[i]);
+    }
+    double addNs = double(monotonicNs() - start) / N;
+
+    const int solves = 200;
+    bool ok = false;
+    start = monotonicNs();
+    for (int i = 0; i < solves; ++i) {
+        ok = calibrator.solve();
+    }
+    double solveUs = (monotonicNs() - start) * 1e-3 / solves;
+
+    MagCalibration cal;
+    uint32_t version = 0;
+    calibrator.latest(cal, version);
+
+    Eigen::Vector3f sink = Eigen::Vector3f::Zero();
+    start = monotonicNs();
+    for (int i = 0; i < N; ++i) {
+        sink += cal.apply(raw[i]);
+    }
+    double applyNs = double(monotonicNs() - start) / N;
+
+    double rawNorm = 0, calNorm = 0, rawHeading = 0, calHeading = 0;
+    for (int i = 0; i < N; ++i) {
+        Eigen::Vector3f c = cal.apply(raw[i]);
+        rawNorm += std::pow(raw[i].norm() / FIELD - 1.0f, 2);
+        calNorm += std::pow(c.norm() / FIELD - 1.0f, 2);
+        rawHeading = std::max<double>(rawHeading, headingError(raw[i], attitudes[i]));
+        calHeading = std::max<double>(calHeading, headingError(c, attitudes[i]));
+    }
+
+    std::cout << name << " (" << calibrator.coveredCells() << "/" << MagCalibrator::CELLS << " cells, "
+              << (ok ? "accepted" : "rejected") << ")" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  addSample " << addNs << " ns, solve " << solveUs << " us, apply " << applyNs << " ns" << std::endl
+              << std::setprecision(4)
+              << "  |m| RMS error  raw " << std::sqrt(rawNorm / N) << "  calibrated " << std::sqrt(calNorm / N) << std::endl
+              << std::setprecision(2)
+              << "  max heading error [deg]  raw " << rawHeading << "  calibrated " << calHeading
+              << "   (sink " << sink.sum() << ")" << std::endl;
+}
+
+int main() {
+    run("full rotation", false);
+    run("yaw only, tilt +-10 deg", true);
+    return 0;
+}
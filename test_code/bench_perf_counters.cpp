@@ -0,0 +1,117 @@
+// 성능 카운터 벤치마크
+//   - PerfScope 비용: 꺼짐 / 켜짐 (매번 측정) / 켜짐 (16번에 한 번 측정)
+//   - 귀속 확인: 같은 일을 두 배로 하는 구간은 instructions가 약 두 배 (하드웨어 카운터가 있을 때)
+//     잠드는 구간은 측정마다 context switch 1번 이상, 짧게 도는 구간은 거의 0 (context switch 카운터가 있을 때)
+//   - 카운터를 열 수 없는 환경(VM, perf_event_paranoid)에서는 없는 카운터를 건너뛰고 - 로 출력
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -pthread bench_perf_counters.cpp ../src/oss/perf_counters.cpp ../src/oss/timer.cpp -o bench_perf_counters
+#include "../src/oss/perf_counters.h"
+#include "../src/oss/timer.h"
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <unistd.h>
+
+volatile uint64_t sink;
+
+// 반복 수에 비례하는 일 (최적화로 없어지지 않게)
+void work(int iterations) {
+    uint64_t x = 1;
+    for (int i = 0; i < iterations; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        asm volatile("" : "+r"(x));
+    }
+    sink = x;
+}
+
+double scopeCostNs(PerfRegion& region, int n) {
+    uint64_t start = monotonicNs();
+    for (int i = 0; i < n; ++i) {
+        PerfScope scope(region);
+        asm volatile("" ::: "memory");
+    }
+    return static_cast<double>(monotonicNs() - start) / n;
+}
+
+int main() {
+    bool pass = true;
+
+    // 비용
+    PerfRegion& costRegion = perfRegion("cost");
+    double disabledNs = scopeCostNs(costRegion, 100000000);
+    startPerfCounters(1);
+    double enabledNs = scopeCostNs(costRegion, 1000000);
+    startPerfCounters(16);
+    double sampledNs = scopeCostNs(costRegion, 10000000);
+    stopPerfCounters();
+    std::cout << std::fixed << std::setprecision(1) << "scope: " << disabledNs << " ns disabled, " << enabledNs
+              << " ns every call, " << sampledNs << " ns 1/16 sampled" << std::endl;
+
+    // 귀속 (측정 스레드에서 처음 측정할 때 카운터를 엶)
+    PerfRegion& small = perfRegion("work-1x");
+    PerfRegion& large = perfRegion("work-2x");
+    PerfRegion& spin = perfRegion("spin");
+    PerfRegion& sleeping = perfRegion("sleep");
+    startPerfCounters(1);
+    std::thread task([&] {
+        for (int i = 0; i < 2000; ++i) {
+            {
+                PerfScope scope(small);
+                work(10000);
+            }
+            {
+                PerfScope scope(large);
+                work(20000);
+            }
+        }
+        for (int i = 0; i < 200; ++i) {
+            {
+                PerfScope scope(spin);
+                uint64_t until = monotonicNs() + 20000;
+                while (monotonicNs() < until) {
+                }
+            }
+            {
+                PerfScope scope(sleeping);
+                usleep(1000);
+            }
+        }
+    });
+    task.join();
+    stopPerfCounters();
+
+    uint32_t available = perfCountersAvailable();
+    std::cout << "available:";
+    for (int c = 0; c < PERF_COUNTERS; ++c) {
+        if (available & (1u << c)) {
+            std::cout << " " << perfCounterName(static_cast<PerfCounter>(c));
+        }
+    }
+    std::cout << (available ? "" : " none") << std::endl;
+
+    PerfRegionSnapshot s1 = {}, s2 = {}, sSpin = {}, sSleep = {};
+    for (const PerfRegionSnapshot& s : perfRegionSnapshots()) {
+        std::string name = s.name;
+        if (name == "work-1x") s1 = s;
+        if (name == "work-2x") s2 = s;
+        if (name == "spin") sSpin = s;
+        if (name == "sleep") sSleep = s;
+    }
+    if (available & (1u << PERF_INSTRUCTIONS)) {
+        double ratio = s2.mean(PERF_INSTRUCTIONS) / s1.mean(PERF_INSTRUCTIONS);
+        std::cout << std::setprecision(3) << "instructions 2x/1x: " << ratio << std::endl;
+        pass = pass && std::fabs(ratio - 2.0) < 0.1;
+    }
+    if (available & (1u << PERF_CONTEXT_SWITCHES)) {
+        std::cout << std::setprecision(3) << "context switches: sleep " << sSleep.mean(PERF_CONTEXT_SWITCHES) << ", spin "
+                  << sSpin.mean(PERF_CONTEXT_SWITCHES) << " per sample" << std::endl;
+        pass = pass && sSleep.mean(PERF_CONTEXT_SWITCHES) >= 1.0 && sSpin.mean(PERF_CONTEXT_SWITCHES) < 0.2;
+    }
+    // 카운터가 없으면 측정 없이 지나가야 함
+    pass = pass && (available ? s1.samples == 2000 : s1.samples == 0) && s1.calls == 2000;
+
+    std::cout << std::endl;
+    printPerfCounters(stdout);
+    std::cout << (pass ? "PASS" : "FAIL") << std::endl;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// IMU 사전 적분 벤치마크: 배치 크기별 정확도와 비용
+// 400Hz 샘플에 20Hz 각진동(coning)과 같은 주파수 선진동(sculling)을 넣고 40kHz로 적분한 참값과 비교
+//   - latest: 배치마다 마지막 샘플만 사용 (샘플 버림)
+//   - average: 평균 입력, 보정 없음
+//   - coning/sculling: ImuPreintegrator
+// 각 방식은 배치마다 EKF::predict 한 번 (공분산 전파 포함), 비용은 데이터 1초당 처리 시간
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_preintegration.cpp ../src/psss/imu_preintegrator.cpp ../src/psss/ekf.cpp ../src/oss/timer.cpp -o bench_preintegration
+#include "../src/psss/imu_preintegrator.h"
+#include "../src/psss/ekf.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+const double GRAVITY = 9.80665;
+const double RATE = 400.0;          // IMU 샘플 주기
+const int SUBSTEPS = 100;           // 참값 적분 세분
+const double DURATION = 10.0;
+const double VIBRATION = 2.0 * M_PI * 20.0;
+
+struct Truth {
+    std::vector<ImuSample> samples;
+    Eigen::Quaterniond attitude;
+    Eigen::Vector3d velocity;
+};
+
+// 각속도: 크기 1 rad/s로 xy 평면에서 회전 (coning) + z 축 완만한 회전
+// 비력: 중력 반작용 + y 방향 진동 (x 각진동과 같은 위상 → sculling)
+Eigen::Vector3d angularRate(double t) {
+    return Eigen::Vector3d(std::cos(VIBRATION * t), std::sin(VIBRATION * t), 0.2);
+}
+
+Eigen::Vector3d specificForce(double t, const Eigen::Quaterniond& q) {
+    return q.conjugate() * Eigen::Vector3d(0, 0, -GRAVITY) + Eigen::Vector3d(0, 3.0 * std::cos(VIBRATION * t), 0);
+}
+
+Truth makeTruth() {
+    Truth truth;
+    Eigen::Quaterniond q = Eigen::Quaterniond::Identity();
+    Eigen::Vector3d v = Eigen::Vector3d::Zero();
+    int n = static_cast<int>(DURATION * RATE);
+    double h = 1.0 / (RATE * SUBSTEPS);
+    for (int k = 0; k <= n; ++k) {
+        double t = k / RATE;
+        Eigen::Vector3d f = specificForce(t, q);
+        truth.samples.push_back(ImuSample{f.cast<float>(), angularRate(t).cast<float>(), Eigen::Vector3f::Zero()});
+        if (k == n) {
+            break;
+        }
+        for (int s = 0; s < SUBSTEPS; ++s) {
+            double tm = t + (s + 0.5) * h;
+            Eigen::Vector3d w = angularRate(tm);
+            Eigen::Quaterniond half = q * Eigen::Quaterniond(Eigen::AngleAxisd(0.5 * h * w.norm(), w.normalized()));
+            Eigen::Vector3d a = half * specificForce(tm, half) + Eigen::Vector3d(0, 0, GRAVITY);
+            v += a * h;
+            q = (q * Eigen::Quaterniond(Eigen::AngleAxisd(h * w.norm(), w.normalized()))).normalized();
+        }
+    }
+    truth.attitude = q;
+    truth.velocity = v;
+    return truth;
+}
+
+enum class Method { Latest, Average, Preintegrated };
+
+// 샘플 k가 [t_k, t_k+1) 구간을 대표 (참값 적분과 같은 구간 배정)
+void runOnce(const Truth& truth, Method method, int batch, double& attErrDeg, double& velErr, double& usPerSecond) {
+    const float dt = static_cast<float>(1.0 / RATE);
+    const int n = static_cast<int>(truth.samples.size()) - 1;
+    EKF ekf;
+    ImuPreintegrator pre;
+    Eigen::Vector3f sumAccel = Eigen::Vector3f::Zero(), sumGyro = Eigen::Vector3f::Zero();
+    uint64_t timeNs = 1000;
+
+    uint64_t start = monotonicNs();
+    for (int k = 0; k < n; ++k) {
+        const ImuSample& s = truth.samples[k];
+        pre.add(s, dt);
+        sumAccel += s.accel;
+        sumGyro += s.gyro;
+        if (pre.count() == batch || k == n - 1) {
+            float span = pre.duration();
+            timeNs += static_cast<uint64_t>(span * 1e9f);
+            if (method == Method::Preintegrated) {
+                ImuSample mean;
+                pre.average(mean);
+                ekf.predict(mean.accel, mean.gyro, span, timeNs);
+            } else if (method == Method::Average) {
+                ekf.predict(sumAccel / pre.count(), sumGyro / pre.count(), span, timeNs);
+            } else {
+                ekf.predict(s.accel, s.gyro, span, timeNs);
+            }
+            pre.reset();
+            sumAccel.setZero();
+            sumGyro.setZero();
+        }
+    }
+    usPerSecond = (monotonicNs() - start) * 1e-3 / DURATION;
+
+    Eigen::VectorXf state = ekf.getState();
+    Eigen::Quaterniond q(state(6), state(7), state(8), state(9));
+    attErrDeg = q.normalized().angularDistance(truth.attitude) * 180.0 / M_PI;
+    velErr = (state.segment<3>(3).cast<double>() - truth.velocity).norm();
+}
+
+// 단일 CPU에서 다른 작업의 영향을 줄이기 위해 반복 중 최소 시간 사용
+void run(const Truth& truth, Method method, int batch, double& attErrDeg, double& velErr, double& usPerSecond) {
+    usPerSecond = 1e30;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        double cost;
+        runOnce(truth, method, batch, attErrDeg, velErr, cost);
+        usPerSecond = std::min(usPerSecond, cost);
+    }
+}
+
+int main() {
+    Truth truth = makeTruth();
+    std::cout << "10 s, 400 Hz, 20 Hz coning (1 rad/s) + sculling (3 m/s^2)" << std::endl;
+    std::cout << " batch  method            att err [deg]  vel err [m/s]  cost [us per s]" << std::endl;
+    const int batches[] = {1, 2, 4, 8, 16};
+    const Method methods[] = {Method::Latest, Method::Average, Method::Preintegrated};
+    const char* names[] = {"latest", "average", "coning/sculling"};
+    for (int batch : batches) {
+        for (int m = 0; m < 3; ++m) {
+            if (batch == 1 && m > 0) {
+                continue;  // 배치 1은 세 방식이 같음
+            }
+            double att, vel, cost;
+            run(truth, methods[m], batch, att, vel, cost);
+            std::cout << std::setw(5) << batch << "  " << std::left << std::setw(18) << names[m] << std::right
+                      << std::fixed << std::setprecision(4) << std::setw(12) << att << std::setw(15) << vel
+                      << std::setprecision(1) << std::setw(15) << cost << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+// 블랙박스 재생 벤치마크: 실제 드라이버/추정기 전체 경로를 기록 파일로 오프라인 실행
+//   - 인자가 없으면 참값을 아는 합성 비행(synthetic_flight.h)을 재생
+//   - 인자로 기록 파일(main --blackbox)을 주면 그 파일을 재생
+// 최대 속도로 두 번 재생하여 최종 상태가 비트 단위로 같은지 확인하고 처리량 측정, N배속 재생으로 시간 맞춤 확인
+// 합성 기록은 참값 대비 위치/속도/자세 오차도 검사 (EKF 정확도 회귀 시험)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 -I../src/ioss bench_replay.cpp ../src/psss/pose_estimator.cpp ../src/psss/ekf.cpp ../src/psss/geodetic.cpp ../src/psss/stillness_detector.cpp ../src/psss/calibration_store.cpp ../src/psss/mag_calibrator.cpp ../src/psss/temperature_compensation.cpp ../src/psss/imu_preintegrator.cpp ../src/ioss/imu_sensor.cpp ../src/ioss/gps_sensor.cpp ../src/ioss/barometer_sensor.cpp ../src/oss/transport.cpp ../src/oss/blackbox.cpp ../src/oss/trace.cpp ../src/oss/loop_stats.cpp ../src/oss/watchdog.cpp ../src/oss/perf_counters.cpp ../src/oss/binary_logger.cpp ../src/oss/timer.cpp -pthread -o bench_replay
+#include "synthetic_flight.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+
+const double FAST_SPEED = 20.0;
+
+// 정확도 허용치 (현재 추정기 기준, 이보다 나빠지면 회귀)
+const float MAX_POSITION_ERROR = 1.0f;     // m
+const float MAX_VELOCITY_ERROR = 0.2f;     // m/s
+const float MAX_ATTITUDE_ERROR = 2.0f;     // deg
+
+void printPose(const char* name, const ReplayResult& r) {
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(4);
+    for (int i = 0; i < 9; ++i) {
+        std::cout << std::setw(10) << r.pose[i];
+    }
+    std::cout << std::setprecision(3) << "  wall " << r.wallSec << " s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : SYNTHETIC_PATH;
+    bool synthetic = argc <= 1;
+    if (synthetic && !writeSyntheticLog(path)) {
+        return 1;
+    }
+
+    ReplayResult first, second, paced;
+    if (!replay(path, 0.0, first) || !replay(path, 0.0, second) || !replay(path, FAST_SPEED, paced)) {
+        std::cerr << "Replay failed" << std::endl;
+        return 1;
+    }
+    std::cout << "          pN        pE        pD        vN        vE        vD      roll     pitch       yaw" << std::endl;
+    printPose("max #1", first);
+    printPose("max #2", second);
+    printPose("20x", paced);
+
+    bool pass = true;
+    bool identical = std::memcmp(first.pose, second.pose, sizeof(first.pose)) == 0 &&
+                     std::memcmp(first.pose, paced.pose, sizeof(first.pose)) == 0;
+    std::cout << "bit-identical across runs: " << (identical ? "yes" : "NO") << std::endl;
+    pass = pass && identical;
+
+    std::cout << std::setprecision(1) << "throughput: " << first.dataSec / first.wallSec << "x real time ("
+              << first.dataSec << " s of data in " << std::setprecision(3) << first.wallSec << " s)" << std::endl;
+    double expectedWall = first.dataSec / FAST_SPEED;
+    std::cout << "20x pacing: " << paced.wallSec << " s (expected " << expectedWall << " s)" << std::endl;
+
+    if (synthetic) {
+        double north, velocity, accel;
+        truthAt(DURATION, north, velocity, accel);
+        Eigen::Vector3f position(first.pose[0], first.pose[1], first.pose[2]);
+        Eigen::Vector3f velocityEst(first.pose[3], first.pose[4], first.pose[5]);
+        float positionError = (position - Eigen::Vector3f(north, 0, 0)).norm();
+        float velocityError = (velocityEst - Eigen::Vector3f(velocity, 0, 0)).norm();
+        float attitudeError = Eigen::Vector3f(first.pose[6], first.pose[7], first.pose[8]).cwiseAbs().maxCoeff();
+        std::cout << std::setprecision(3) << "error vs truth: position " << positionError << " m, velocity "
+                  << velocityError << " m/s, attitude " << attitudeError << " deg, ready " << (first.ready ? "yes" : "NO") << std::endl;
+        pass = pass && first.ready && positionError < MAX_POSITION_ERROR && velocityError < MAX_VELOCITY_ERROR &&
+               attitudeError < MAX_ATTITUDE_ERROR;
+    }
+    std::cout << (pass ? "PASS" : "FAIL") << std::endl;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// SensorHistory 조회 성능 측정
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_sensor_history.cpp ../src/oss/timer.cpp -o bench_sensor_history
+#include "../src/psss/sensor_history.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+const uint64_t IMU_PERIOD_NS = 2500000;  // 400Hz
+const int LOOKUPS = 2000000;
+const size_t QUERY_COUNT = 4096;    // 미리 뽑아 둔 조회 시각 (순환 사용, 캐시에 남는 크기)
+
+template <size_t Depth>
+void benchDepth() {
+    static SensorHistory<ImuSample, Depth> history;
+    history.clear();
+
+    // 버퍼를 두 바퀴 채워서 링 래핑 상태에서 측정
+    uint64_t t = 1000000000ULL;
+    uint64_t insertStart = monotonicNs();
+    for (size_t i = 0; i < Depth * 2; ++i) {
+        ImuSample s;
+        s.accel = Eigen::Vector3f(0.0f, 0.0f, -9.8f) + Eigen::Vector3f::Constant(i * 1e-4f);
+        s.gyro = Eigen::Vector3f::Constant(i * 1e-5f);
+        s.mag = Eigen::Vector3f(0.2f, 0.0f, 0.4f);
+        history.push(t, s);
+        t += IMU_PERIOD_NS;
+    }
+    uint64_t insertNs = monotonicNs() - insertStart;
+
+    // 버퍼 범위 안의 임의 과거 시각을 보간 조회 (난수 생성은 측정 구간 밖에서)
+    std::mt19937_64 rng(42);
+    uint64_t span = history.newestTime() - history.oldestTime();
+    std::uniform_int_distribution<uint64_t> dist(0, span);
+    std::vector<uint64_t> queries(QUERY_COUNT);
+    for (uint64_t& q : queries) {
+        q = history.oldestTime() + dist(rng);
+    }
+    float sink = 0.0f;
+    int hits = 0;
+    ImuSample out = history.at(0);
+    uint64_t start = monotonicNs();
+    for (int i = 0; i < LOOKUPS; ++i) {
+        hits += history.interpolate(queries[i & (QUERY_COUNT - 1)], out);
+        sink += out.gyro.x();
+    }
+    uint64_t elapsed = monotonicNs() - start;
+
+    std::cout << std::setw(6) << Depth
+              << std::setw(14) << std::fixed << std::setprecision(2) << (insertNs / double(Depth * 2))
+              << std::setw(14) << (elapsed / double(LOOKUPS))
+              << std::setw(16) << std::setprecision(0) << (LOOKUPS / (elapsed * 1e-9))
+              << "  (" << hits << " hits, " << sink << ")" << std::endl;
+}
+
+int main() {
+    std::cout << " depth  insert[ns]  lookup[ns]  lookups/s" << std::endl;
+    benchDepth<64>();
+    benchDepth<256>();
+    benchDepth<512>();
+    benchDepth<1024>();
+    benchDepth<4096>();
+    return 0;
+}
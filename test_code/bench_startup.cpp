@@ -0,0 +1,129 @@
+// 시작 시 바이어스 추정: 블로킹 캘리브레이션 vs 정지 검출 + EKF 온라인 추정
+//   - 기존 calibrateGyro(): 10ms 간격 100샘플 평균 (1.0초 블로킹), test_code calibrateIMU(): 25ms 간격 (2.5초)
+//   - 신규: 400Hz 샘플마다 StillnessDetector, 첫 정지 윈도우에서 seedAtRest, 이후 정지 중 영속도 업데이트
+// 시나리오: 전원 투입 후 계속 정지 / 처음 1.5초 손으로 들고 흔든 뒤 정지
+// 준비까지 걸린 시간(샘플 시각 기준), 자이로 바이어스 오차, 기울기 오차, 10초 후 속도 (영속도 업데이트 효과)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_startup.cpp ../src/psss/stillness_detector.cpp ../src/psss/ekf.cpp ../src/oss/timer.cpp -o bench_startup
+#include "../src/psss/stillness_detector.h"
+#include "../src/psss/ekf.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <vector>
+#include <cmath>
+
+const float GRAVITY = 9.80665f;
+const uint64_t IMU_PERIOD_NS = 2500000ULL;   // 400Hz
+const int STEPS = 400 * 10;
+const Eigen::Vector3f GYRO_BIAS(0.01f, -0.008f, 0.005f);
+const Eigen::Vector3f ACCEL_BIAS(0.02f, -0.03f, 0.08f);
+const float ROLL = 3.0f * M_PI / 180.0f;
+const float PITCH = -2.0f * M_PI / 180.0f;
+
+struct Sample {
+    Eigen::Vector3f accel, gyro;
+};
+
+// VN-100 수준 노이즈 (샘플당 자이로 0.003rad/s, 가속도 0.02m/s^2)
+// 흔든 뒤에는 마지막 자세로 내려놓은 상태 (restAttitude)
+std::vector<Sample> makeDataset(float shakeSeconds, Eigen::Quaternionf& restAttitude) {
+    std::mt19937 rng(21);
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    Eigen::Quaternionf q = Eigen::AngleAxisf(PITCH, Eigen::Vector3f::UnitY()) * Eigen::AngleAxisf(ROLL, Eigen::Vector3f::UnitX());
+
+    std::vector<Sample> data(STEPS);
+    for (int i = 0; i < STEPS; ++i) {
+        float t = i * IMU_PERIOD_NS * 1e-9f;
+        Eigen::Vector3f rate = Eigen::Vector3f::Zero();
+        Eigen::Vector3f shake = Eigen::Vector3f::Zero();
+        if (t < shakeSeconds) {
+            rate = Eigen::Vector3f(0.6f * std::sin(5.0f * t), 0.4f * std::cos(3.0f * t), 0.3f * std::sin(2.0f * t));
+            shake = Eigen::Vector3f(0.5f * std::sin(7.0f * t), 0.4f * std::cos(6.0f * t), 0.3f * std::sin(9.0f * t));
+        }
+        Sample& s = data[i];
+        s.accel = q.conjugate() * (shake - Eigen::Vector3f(0.0f, 0.0f, GRAVITY)) + ACCEL_BIAS + 0.02f * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        s.gyro = rate + GYRO_BIAS + 0.003f * Eigen::Vector3f(n(rng), n(rng), n(rng));
+        Eigen::Vector3f rv = rate * (IMU_PERIOD_NS * 1e-9f);
+        if (rv.norm() > 0) {
+            q = (q * Eigen::Quaternionf(Eigen::AngleAxisf(rv.norm(), rv.normalized()))).normalized();
+        }
+    }
+    restAttitude = q;
+    return data;
+}
+
+// 기존 방식: 시작부터 intervalMs 간격 100샘플 평균
+void legacy(const std::vector<Sample>& data, int intervalMs, const char* name) {
+    Eigen::Vector3f sum = Eigen::Vector3f::Zero();
+    int stride = intervalMs * 1000000 / static_cast<int>(IMU_PERIOD_NS);
+    for (int k = 0; k < 100; ++k) {
+        sum += data[k * stride].gyro;
+    }
+    float err = (sum / 100.0f - GYRO_BIAS).norm();
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << 100 * intervalMs << std::scientific << std::setprecision(2)
+              << std::setw(14) << err << std::setw(14) << "-" << std::setw(12) << "-" << std::endl;
+}
+
+void online(const std::vector<Sample>& data, const Eigen::Quaternionf& restAttitude, double& detectorNs) {
+    StillnessDetector detector;
+    std::unique_ptr<EKF> ekf(new EKF());
+    int readyStep = -1;
+    float readyErr = 0, attErr = 0;
+    uint64_t cost = 0;
+
+    for (int i = 0; i < STEPS; ++i) {
+        uint64_t t = (i + 1) * IMU_PERIOD_NS;
+        ekf->predict(data[i].accel, data[i].gyro, IMU_PERIOD_NS * 1e-9f, t);
+
+        uint64_t start = monotonicNs();
+        detector.add(data[i].accel, data[i].gyro, t);
+        bool still = detector.isStill();
+        cost += monotonicNs() - start;
+
+        if (still) {
+            if (readyStep < 0) {
+                ekf->seedAtRest(detector.meanAccel(), detector.meanGyro(), detector.windowDuration());
+                readyStep = i;
+                Eigen::Quaternionf q(ekf->getState()(6), ekf->getState()(7), ekf->getState()(8), ekf->getState()(9));
+                Eigen::Vector3f down = q.conjugate() * Eigen::Vector3f::UnitZ();
+                Eigen::Vector3f trueDown = restAttitude.conjugate() * Eigen::Vector3f::UnitZ();
+                attErr = std::acos(std::min(1.0f, down.dot(trueDown))) * 180.0f / M_PI;
+            } else {
+                ekf->updateZeroVelocity(t);
+            }
+        }
+        if (i == readyStep) {
+            // EKF 내부 바이어스는 getState()에 없으므로 정지 평균으로 대신 확인
+            readyErr = (detector.meanGyro() - GYRO_BIAS).norm();
+        }
+    }
+    detectorNs = double(cost) / STEPS;
+
+    std::cout << std::left << std::setw(28) << "stillness + EKF (online)" << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << (readyStep + 1) * IMU_PERIOD_NS * 1e-6 << std::scientific << std::setprecision(2)
+              << std::setw(14) << readyErr << std::setw(14) << attErr
+              << std::setw(12) << std::fixed << std::setprecision(3) << ekf->getState().segment<3>(3).norm() << std::endl;
+}
+
+int main() {
+    const struct {
+        const char* name;
+        float shake;
+    } scenarios[2] = {{"still from power-on", 0.0f}, {"shaken for first 1.5 s", 1.5f}};
+
+    for (const auto& sc : scenarios) {
+        Eigen::Quaternionf restAttitude;
+        std::vector<Sample> data = makeDataset(sc.shake, restAttitude);
+        std::cout << sc.name << std::endl;
+        std::cout << "method                      ready[ms]  gyro bias err  tilt err[deg]  |v| @10s" << std::endl;
+        legacy(data, 10, "calibrateGyro (10ms x100)");
+        legacy(data, 25, "calibrateIMU (25ms x100)");
+        double detectorNs = 0;
+        online(data, restAttitude, detectorNs);
+        std::cout << "detector cost " << std::fixed << std::setprecision(1) << detectorNs << " ns/sample" << std::endl << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,373 @@
+// 전체 파이프라인 벤치마크 모음 (커밋 간 비교용 JSON 출력)
+//   마이크로: IMU CRC/줄 파싱, GPS NAV-PVT 파싱, SBUS 프레임, EKF 예측/GPS 업데이트(현재/지연), 쿼터니언→오일러, PID, 믹서, PCA9685 프레임
+//   매크로: 합성 20초 비행(synthetic_flight.h)을 최대 속도로 재생 (드라이버 + 추정기 전체, IMU 샘플당 ns)
+//   항목마다 한 번 재는 시간이 약 20ms가 되도록 반복 수를 맞추고 REPETITIONS번 재어 op당 중앙값/최소/최대 기록
+// 사용: ./bench_suite [--json 결과.json] [--label 이름] [--filter 이름 일부] [--compare 기준.json] [--threshold %]
+//   --json: 항목 하나가 한 줄인 JSON (diff로 커밋 간 비교 가능)
+//   --compare: 기준 파일과 항목별 중앙값 비교, threshold(기본 10%)보다 느려진 항목이 있으면 종료 코드 1
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 -I../src/ioss bench_suite.cpp ../src/psss/pose_estimator.cpp ../src/psss/ekf.cpp ../src/psss/geodetic.cpp ../src/psss/stillness_detector.cpp ../src/psss/calibration_store.cpp ../src/psss/mag_calibrator.cpp ../src/psss/temperature_compensation.cpp ../src/psss/imu_preintegrator.cpp ../src/psss/motor_output.cpp ../src/ioss/imu_sensor.cpp ../src/ioss/gps_sensor.cpp ../src/ioss/barometer_sensor.cpp ../src/ioss/rc_input.cpp ../src/oss/transport.cpp ../src/oss/blackbox.cpp ../src/oss/trace.cpp ../src/oss/loop_stats.cpp ../src/oss/watchdog.cpp ../src/oss/perf_counters.cpp ../src/oss/binary_logger.cpp ../src/oss/timer.cpp -pthread -o bench_suite
+#include "synthetic_flight.h"
+#include "../src/psss/ekf.h"
+#include "../src/psss/attitude_controller.h"
+#include "../src/psss/motor_output.h"
+#include "../src/ioss/rc_input.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+const uint64_t TARGET_NS = 20000000ULL;     // 한 번 재는 시간 (20ms)
+const int REPETITIONS = 7;
+const int REPLAY_REPETITIONS = 3;
+
+struct BenchResult {
+    std::string name;
+    std::string unit;           // op 하나가 무엇인지
+    uint64_t iterations;        // 한 번 잴 때 op 수
+    int repetitions;
+    double medianNs;            // op당 ns
+    double minNs;
+    double maxNs;
+};
+
+std::vector<BenchResult> results;
+const char* filter = nullptr;
+
+// 결과를 쓴 것으로 만들어 계산이 없어지지 않게 함
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+bool selected(const char* name) {
+    return filter == nullptr || std::strstr(name, filter) != nullptr;
+}
+
+void addResult(const char* name, const char* unit, uint64_t iterations, std::vector<double> perOpNs) {
+    std::sort(perOpNs.begin(), perOpNs.end());
+    BenchResult r = {name, unit, iterations, static_cast<int>(perOpNs.size()), perOpNs[perOpNs.size() / 2],
+                     perOpNs.front(), perOpNs.back()};
+    results.push_back(r);
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1) << std::setw(12)
+              << r.medianNs << " ns/" << std::left << std::setw(10) << unit << std::right << " (min " << r.minNs << ", max "
+              << r.maxNs << ", " << iterations << " x " << r.repetitions << ")" << std::endl;
+}
+
+// body(n)가 op를 n번 실행
+template <typename Body>
+void bench(const char* name, const char* unit, Body body) {
+    if (!selected(name)) {
+        return;
+    }
+    auto timeOf = [&](uint64_t n) {
+        uint64_t start = monotonicNs();
+        body(n);
+        return monotonicNs() - start;
+    };
+    // 반복 수 맞춤 (준비 실행 겸용)
+    uint64_t n = 1;
+    uint64_t elapsed = timeOf(n);
+    while (elapsed < TARGET_NS / 10 && n < (1ULL << 32)) {
+        n *= 10;
+        elapsed = timeOf(n);
+    }
+    n = std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(n) * TARGET_NS / std::max<uint64_t>(elapsed, 1)));
+
+    std::vector<double> perOpNs;
+    for (int r = 0; r < REPETITIONS; ++r) {
+        perOpNs.push_back(static_cast<double>(timeOf(n)) / n);
+    }
+    addResult(name, unit, n, perOpNs);
+}
+
+// VN-100 $VNRRG,20 응답 (드라이버가 받는 형식)
+std::string imuLine(int k) {
+    char line[160];
+    int n = snprintf(line, sizeof(line), "$VNRRG,20,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.5f,%.5f,%.5f", 0.2900, -0.0459, 0.4045,
+                     0.0123 * k, -0.0456, -9.8066, 0.00012, -0.00034, 0.00056 * k);
+    unsigned short crc = calculateIMUCRC(reinterpret_cast<unsigned char*>(line) + 1, n - 1);
+    snprintf(line + n, sizeof(line) - n, "*%04X", crc);
+    return line;
+}
+
+void microBenchmarks() {
+    // 센서 파싱
+    std::string line = imuLine(1);
+    bench("imu_crc", "message", [&](uint64_t n) {
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(line.data()) + 1;
+        unsigned int length = static_cast<unsigned int>(line.find('*') - 1);
+        for (uint64_t i = 0; i < n; ++i) {
+            unsigned short crc = calculateIMUCRC(data, length);
+            keep(crc);
+        }
+    });
+    bench("imu_parse_line", "line", [&](uint64_t n) {
+        char buffer[160];
+        IMUData data = {};
+        for (uint64_t i = 0; i < n; ++i) {
+            std::memcpy(buffer, line.c_str(), line.size() + 1);   // 파서가 '*'를 NUL로 바꾸므로 매번 복사
+            bool ok = parseIMULine(buffer, data);
+            keep(ok);
+            keep(data);
+        }
+    });
+
+    std::vector<uint8_t> gpsFrame(100, 0);
+    {
+        const uint8_t header[6] = {0xB5, 0x62, 0x01, 0x07, 92, 0};
+        std::copy(header, header + 6, gpsFrame.begin());
+        putLE(&gpsFrame[6], 123456);
+        gpsFrame[6 + 23] = 12;
+        putLE(&gpsFrame[6 + 24], 1269780000);
+        putLE(&gpsFrame[6 + 28], 375665000);
+        putLE(&gpsFrame[6 + 32], 50000);
+        putLE(&gpsFrame[6 + 48], 2000);
+    }
+    bench("gps_parse_navpvt", "message", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            GPSData data = parseGpsData(gpsFrame);
+            keep(data);
+        }
+    });
+
+    uint8_t sbusFrame[SBUS_FRAME_SIZE] = {0x0F};
+    for (int i = 1; i < SBUS_FRAME_SIZE - 1; ++i) {
+        sbusFrame[i] = static_cast<uint8_t>(i * 37);
+        sbusFrame[SBUS_FRAME_SIZE - 1] ^= sbusFrame[i];
+    }
+    bench("sbus_parse_frame", "frame", [&](uint64_t n) {
+        uint16_t channels[SBUS_CHANNELS];
+        for (uint64_t i = 0; i < n; ++i) {
+            bool ok = parseSbusFrame(sbusFrame, channels);
+            keep(ok);
+            keep(channels);
+        }
+    });
+
+    // EKF (정지 입력으로 초기화한 뒤 400Hz 예측)
+    const float dt = 0.0025f;
+    const Eigen::Vector3f restAccel(0.0f, 0.0f, -9.80665f), restGyro(0.0f, 0.0f, 0.0f);
+    std::unique_ptr<EKF> ekf(new EKF());
+    ekf->seedAtRest(restAccel, restGyro, 2.0f);
+    uint64_t ekfTimeNs = 1000000000ULL;
+    bench("ekf_predict", "step", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            ekfTimeNs += 2500000ULL;
+            ekf->predict(restAccel, restGyro, dt, ekfTimeNs);
+        }
+    });
+    const Eigen::Vector3f gpsPos(0.1f, -0.2f, 0.05f), gpsVel(0.01f, 0.0f, -0.02f);
+    bench("ekf_update_gps", "update", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            ekf->updateWithGPS(gpsPos, gpsVel);
+        }
+    });
+    // 100ms 전 측정: 히스토리의 과거 상태에 적용하고 현재까지 재전파 (실제 GPS 지연 경로)
+    bench("ekf_update_gps_delayed", "update", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            bool applied = ekf->updateWithGPS(gpsPos, gpsVel, ekfTimeNs - 100000000ULL);
+            keep(applied);
+        }
+    });
+
+    std::vector<Eigen::Quaternionf> quaternions;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 256; ++i) {
+        quaternions.push_back(Eigen::Quaternionf::UnitRandom());
+    }
+    bench("quaternion_to_euler", "call", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            Eigen::Vector3f euler = quaternionToEuler(quaternions[i & 255]);
+            keep(euler);
+        }
+    });
+
+    // 제어
+    std::vector<float> measurements(256);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    for (float& m : measurements) {
+        m = noise(rng);
+    }
+    PIDController pid(1.2f, 0.1f, 0.05f);
+    bench("pid_update", "call", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            float output = pid.update(0.0f, measurements[i & 255], 0.01f);
+            keep(output);
+        }
+    });
+
+    std::vector<int> sticks(256);
+    for (size_t i = 0; i < sticks.size(); ++i) {
+        sticks[i] = RC_MIN + static_cast<int>(rng() % (RC_MAX - RC_MIN));
+    }
+    bench("mixer", "call", [&](uint64_t n) {
+        int motor_PWM[MOTOR_COUNT];
+        for (uint64_t i = 0; i < n; ++i) {
+            int throttle = computeThrottlePWM(mapThrottle(sticks[i & 255]));
+            int adjust = computeAdjustment(static_cast<double>(sticks[(i + 1) & 255] - RC_MID) / (RC_MAX - RC_MID));
+            mixMotors(throttle, adjust, -adjust / 2, adjust / 4, motor_PWM);
+            keep(motor_PWM);
+        }
+    });
+    bench("pca9685_frame", "frame", [&](uint64_t n) {
+        uint8_t frame[PCA9685_FRAME_MAX];
+        int pwm[MOTOR_COUNT] = {PWM_MIN, PWM_MIN, PWM_MAX, PWM_MAX};
+        for (uint64_t i = 0; i < n; ++i) {
+            pwm[i & 3] = PWM_MIN + static_cast<int>(i % (PWM_MAX - PWM_MIN));
+            size_t length = buildPCA9685Frame(0, pwm, MOTOR_COUNT, frame);
+            keep(length);
+            keep(frame);
+        }
+    });
+}
+
+// 합성 비행 재생 (fork한 자식에서 최대 속도), op = IMU 샘플 하나를 드라이버부터 추정기까지 처리
+void replayBenchmark() {
+    if (!selected("replay_synthetic_flight")) {
+        return;
+    }
+    if (!writeSyntheticLog(SYNTHETIC_PATH)) {
+        std::cerr << "Cannot write " << SYNTHETIC_PATH << std::endl;
+        return;
+    }
+    const uint64_t samples = static_cast<uint64_t>(DURATION * 400);
+    std::vector<double> perOpNs;
+    for (int r = 0; r < REPLAY_REPETITIONS; ++r) {
+        ReplayResult result;
+        if (!replay(SYNTHETIC_PATH, 0.0, result)) {
+            std::cerr << "Replay failed" << std::endl;
+            return;
+        }
+        perOpNs.push_back(result.wallSec * 1e9 / samples);
+    }
+    addResult("replay_synthetic_flight", "imu_sample", samples, perOpNs);
+}
+
+std::string cpuModel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0 || line.compare(0, 8, "Hardware") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                std::string model = line.substr(line.find_first_not_of(" \t", colon + 1));
+                std::replace(model.begin(), model.end(), '"', '\'');
+                return model;
+            }
+        }
+    }
+    return "unknown";
+}
+
+// 항목 하나가 한 줄 (줄 단위 diff와 --compare가 이 형식에 의존)
+bool writeJson(const char* path, const char* label) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    out << "{\n"
+        << "  \"suite\": \"flight-pipeline\",\n"
+        << "  \"label\": \"" << label << "\",\n"
+        << "  \"date\": \"" << date << "\",\n"
+        << "  \"cpu\": \"" << cpuModel() << "\",\n"
+        << "  \"cores\": " << std::thread::hardware_concurrency() << ",\n"
+        << "  \"compiler\": \"" << __VERSION__ << "\",\n"
+        << "  \"benchmarks\": [\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"unit\": \"" << r.unit << "\", \"ns_per_op\": " << r.medianNs
+            << ", \"min_ns\": " << r.minNs << ", \"max_ns\": " << r.maxNs << ", \"iterations\": " << r.iterations
+            << ", \"repetitions\": " << r.repetitions << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// writeJson이 쓴 파일에서 이름 → ns_per_op
+std::map<std::string, double> readJson(const char* path) {
+    std::map<std::string, double> values;
+    std::ifstream in(path);
+    std::string line;
+    const std::string nameKey = "\"name\": \"", valueKey = "\"ns_per_op\": ";
+    while (std::getline(in, line)) {
+        size_t name = line.find(nameKey);
+        size_t value = line.find(valueKey);
+        if (name == std::string::npos || value == std::string::npos) {
+            continue;
+        }
+        name += nameKey.size();
+        values[line.substr(name, line.find('"', name) - name)] = std::atof(line.c_str() + value + valueKey.size());
+    }
+    return values;
+}
+
+// 느려진 항목 수 반환
+int compare(const char* path, double thresholdPercent) {
+    std::map<std::string, double> baseline = readJson(path);
+    if (baseline.empty()) {
+        std::cerr << "No benchmarks in " << path << std::endl;
+        return 1;
+    }
+    int regressions = 0;
+    std::cout << std::endl << "vs " << path << " (threshold " << thresholdPercent << "%)" << std::endl;
+    for (const BenchResult& r : results) {
+        auto found = baseline.find(r.name);
+        if (found == baseline.end() || found->second <= 0) {
+            std::cout << std::left << std::setw(24) << r.name << std::right << "  new" << std::endl;
+            continue;
+        }
+        double change = (r.medianNs / found->second - 1.0) * 100.0;
+        bool regressed = change > thresholdPercent;
+        regressions += regressed;
+        std::cout << std::left << std::setw(24) << r.name << std::right << std::setprecision(1) << std::setw(12)
+                  << found->second << " -> " << std::setw(10) << r.medianNs << " ns  " << std::showpos << change
+                  << std::noshowpos << "%" << (regressed ? "  REGRESSION" : "") << std::endl;
+    }
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    const char* comparePath = nullptr;
+    const char* label = "";
+    double threshold = 10.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            jsonPath = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--compare") == 0) {
+            comparePath = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--filter") == 0) {
+            filter = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--label") == 0) {
+            label = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--threshold") == 0) {
+            threshold = std::atof(argv[i + 1]);
+        } else {
+            std::cerr << "Unknown option " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    microBenchmarks();
+    replayBenchmark();
+
+    if (jsonPath && !writeJson(jsonPath, label)) {
+        std::cerr << "Cannot write " << jsonPath << std::endl;
+        return 1;
+    }
+    if (comparePath) {
+        return compare(comparePath, threshold) > 0 ? 1 : 0;
+    }
+    return 0;
+}
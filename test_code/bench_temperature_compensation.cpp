@@ -0,0 +1,126 @@
+// IMU 온도 보정표 벤치마크
+// 합성 온도-바이어스 곡선(자이로 2차, 가속도 1차 + 노이즈)으로 정지 소크 로그를 만들어
+//   - fit 비용과 보정 후 남는 바이어스 오차 (로그 범위 안/밖)
+//   - 샘플당 correct 비용 (1us 미만 목표), 축별 3차 다항식 평가와 비교
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -I/usr/include/eigen3 bench_temperature_compensation.cpp ../src/psss/temperature_compensation.cpp ../src/oss/timer.cpp -o bench_temperature_compensation
+#include "../src/psss/temperature_compensation.h"
+#include "../src/oss/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+
+const float GRAVITY = 9.80665f;
+
+// 참 바이어스 (기준 온도에서의 값 포함)
+Eigen::Matrix<float, 6, 1> trueBias(float t) {
+    float d = t - TemperatureBiasTable::REFERENCE_C;
+    Eigen::Matrix<float, 6, 1> b;
+    b << 0.002f + 1.5e-4f * d + 4e-6f * d * d,
+        -0.001f - 0.8e-4f * d + 2e-6f * d * d,
+         0.0005f + 2.0e-4f * d - 3e-6f * d * d,
+         0.05f + 2.0e-3f * d,
+        -0.03f - 1.5e-3f * d,
+         0.08f + 3.0e-3f * d + 2e-5f * d * d;
+    return b;
+}
+
+int main() {
+    std::mt19937 rng(3);
+    std::normal_distribution<float> gyroNoise(0.0f, 0.003f);
+    std::normal_distribution<float> accelNoise(0.0f, 0.02f);
+
+    // 0 → 45°C 소크, 400Hz 약 10분
+    const int N = 240000;
+    std::vector<TemperatureSample> samples(N);
+    for (int i = 0; i < N; ++i) {
+        float t = 45.0f * i / (N - 1);
+        Eigen::Matrix<float, 6, 1> b = trueBias(t);
+        samples[i].temperatureC = t;
+        samples[i].gyro = b.head<3>() + Eigen::Vector3f(gyroNoise(rng), gyroNoise(rng), gyroNoise(rng));
+        samples[i].accel = Eigen::Vector3f(0.0f, 0.0f, -GRAVITY) + b.tail<3>()
+                         + Eigen::Vector3f(accelNoise(rng), accelNoise(rng), accelNoise(rng));
+    }
+
+    TemperatureBiasTable table;
+    uint64_t start = monotonicNs();
+    table.fit(samples);
+    double fitMs = (monotonicNs() - start) * 1e-6;
+
+    // 보정 후 남는 바이어스 = 참 바이어스 - 보정량, 기준 온도 값은 EKF가 추정하므로 뺌
+    auto residual = [&](float lo, float hi, float& gyroErr, float& accelErr, float& gyroRaw, float& accelRaw) {
+        gyroErr = accelErr = gyroRaw = accelRaw = 0.0f;
+        Eigen::Matrix<float, 6, 1> reference = trueBias(TemperatureBiasTable::REFERENCE_C);
+        for (float t = lo; t <= hi; t += 0.1f) {
+            Eigen::Matrix<float, 6, 1> drift = trueBias(t) - reference;
+            Eigen::Matrix<float, 6, 1> left = drift - table.biasAt(t).head<6>();
+            gyroErr = std::max(gyroErr, left.head<3>().cwiseAbs().maxCoeff());
+            accelErr = std::max(accelErr, left.tail<3>().cwiseAbs().maxCoeff());
+            gyroRaw = std::max(gyroRaw, drift.head<3>().cwiseAbs().maxCoeff());
+            accelRaw = std::max(accelRaw, drift.tail<3>().cwiseAbs().maxCoeff());
+        }
+    };
+    float ge, ae, gr, ar;
+    std::cout << std::fixed << std::setprecision(1) << "fit " << N << " samples: " << fitMs << " ms" << std::endl;
+    std::cout << std::setprecision(5);
+    residual(0.0f, 45.0f, ge, ae, gr, ar);
+    std::cout << "  0~45C (logged)    max drift gyro " << gr << " rad/s, accel " << ar
+              << " m/s^2  ->  after table " << ge << ", " << ae << std::endl;
+    residual(-20.0f, 55.0f, ge, ae, gr, ar);
+    std::cout << "  -20~55C (extrap.) max drift gyro " << gr << " rad/s, accel " << ar
+              << " m/s^2  ->  after table " << ge << ", " << ae << std::endl;
+
+    // 샘플당 보정 비용 (온도는 천천히 변하지만 매번 다른 칸을 쓰도록 무작위)
+    const int M = 1 << 20;
+    std::uniform_real_distribution<float> temp(-25.0f, 60.0f);
+    std::vector<float> temps(M);
+    std::vector<Eigen::Vector3f> gyros(M), accels(M);
+    for (int i = 0; i < M; ++i) {
+        temps[i] = temp(rng);
+        gyros[i] = Eigen::Vector3f(gyroNoise(rng), gyroNoise(rng), gyroNoise(rng));
+        accels[i] = Eigen::Vector3f(0.0f, 0.0f, -GRAVITY);
+    }
+
+    Eigen::Vector3f sink = Eigen::Vector3f::Zero();
+    start = monotonicNs();
+    for (int i = 0; i < M; ++i) {
+        Eigen::Vector3f g = gyros[i], a = accels[i];
+        table.correct(temps[i], g, a);
+        sink += g + a;
+    }
+    double tableNs = double(monotonicNs() - start) / M;
+
+    // 비교: 축별 3차 다항식 (Horner)
+    float coeff[6][4];
+    for (int a = 0; a < 6; ++a) {
+        for (int c = 0; c < 4; ++c) {
+            coeff[a][c] = 1e-4f * (a + 1) / (c + 1);
+        }
+    }
+    start = monotonicNs();
+    for (int i = 0; i < M; ++i) {
+        float t = temps[i];
+        float b[6];
+        for (int a = 0; a < 6; ++a) {
+            b[a] = ((coeff[a][3] * t + coeff[a][2]) * t + coeff[a][1]) * t + coeff[a][0];
+        }
+        Eigen::Vector3f g = gyros[i] - Eigen::Vector3f(b[0], b[1], b[2]);
+        Eigen::Vector3f a = accels[i] - Eigen::Vector3f(b[3], b[4], b[5]);
+        sink += g + a;
+    }
+    double polyNs = double(monotonicNs() - start) / M;
+
+    std::cout << std::setprecision(2) << "correct per sample: table " << tableNs << " ns, cubic polynomial "
+              << polyNs << " ns   (sink " << sink.sum() << ")" << std::endl;
+
+    // 저장/읽기 왕복
+    const char* path = "/tmp/bench_imu_temperature.bin";
+    TemperatureBiasTable loaded;
+    bool ok = table.save(path, 1234) && loaded.load(path, 1234) && !loaded.load(path, 99);
+    ok = ok && (loaded.biasAt(37.3f) - table.biasAt(37.3f)).norm() == 0.0f;
+    std::cout << "save/load round trip " << (ok ? "ok" : "FAILED") << std::endl;
+    std::remove(path);
+    return ok ? 0 : 1;
+}
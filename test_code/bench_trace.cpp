@@ -0,0 +1,141 @@
+// 지연 추적 벤치마크
+//   - 추적점 한 번의 비용: 꺼진 상태, 켜진 상태(링 기록), 비교용 clock_gettime 한 번
+//     (1000회 묶음의 평균을 묶음마다 재서 p50/p99, 목표 < 50ns)
+//   - 두 스레드 파이프라인 (수신/파싱 → 큐 → 추정/제어/믹서/I2C 흉내)의 단계별 지연과 JSON 내보내기
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -pthread bench_trace.cpp ../src/oss/trace.cpp ../src/oss/timer.cpp -o bench_trace
+#include "../src/oss/trace.h"
+#include "../src/oss/blackbox.h"
+#include "../src/oss/timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <pthread.h>
+#include <unistd.h>
+
+const int BATCH = 1000;
+const int BATCHES = 5000;
+const double BUDGET_NS = 50.0;
+
+struct Cost {
+    double p50;
+    double p99;
+};
+
+// 1000회 묶음의 호출당 시간 분포
+template <typename F>
+Cost measure(F&& body) {
+    std::vector<double> perCall;
+    perCall.reserve(BATCHES);
+    uint64_t id = 1;
+    for (int b = 0; b < BATCHES; ++b) {
+        uint64_t start = monotonicNs();
+        for (int i = 0; i < BATCH; ++i) {
+            body(id++);
+        }
+        perCall.push_back(static_cast<double>(monotonicNs() - start) / BATCH);
+    }
+    std::sort(perCall.begin(), perCall.end());
+    return {perCall[BATCHES / 2], perCall[BATCHES * 99 / 100]};
+}
+
+void report(const char* name, const Cost& cost) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << " p50 " << std::setw(6) << cost.p50 << " ns  p99 " << std::setw(6) << cost.p99 << " ns" << std::endl;
+}
+
+// 수신 스레드: 2ms마다 샘플 수신/파싱, 처리 스레드: 큐에서 꺼내 나머지 단계
+void runPipeline(int samples) {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<uint64_t> queue;
+    bool done = false;
+
+    std::thread consumer([&] {
+        pthread_setname_np(pthread_self(), "control");
+        while (true) {
+            uint64_t id;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&] { return done || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                id = queue.front();
+                queue.pop_front();
+            }
+            trace(TRACE_ESTIMATOR, id, BLACKBOX_IMU);
+            trace(TRACE_CONTROLLER, id);
+            trace(TRACE_MIXER, id);
+            usleep(100);  // I2C 쓰기 흉내
+            trace(TRACE_I2C_WRITE, id);
+        }
+    });
+
+    pthread_setname_np(pthread_self(), "serial");
+    for (int i = 0; i < samples; ++i) {
+        uint64_t id = monotonicNs();
+        trace(TRACE_SERIAL_READ, id, BLACKBOX_IMU);
+        trace(TRACE_PARSE, id, BLACKBOX_IMU);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(id);
+        }
+        ready.notify_one();
+        usleep(2000);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    ready.notify_one();
+    consumer.join();
+}
+
+int main() {
+    volatile uint64_t sink = 0;
+    Cost off = measure([](uint64_t id) { trace(TRACE_PARSE, id, BLACKBOX_IMU); });
+    report("trace (disabled)", off);
+
+    startTracing();
+    Cost on = measure([](uint64_t id) { trace(TRACE_PARSE, id, BLACKBOX_IMU); });
+    stopTracing();
+    report("trace (enabled)", on);
+
+    Cost tick = measure([&](uint64_t) { sink = sink + traceTick(); });
+    report("traceTick", tick);
+    Cost clock = measure([&](uint64_t) { sink = sink + monotonicNs(); });
+    report("clock_gettime(MONOTONIC)", clock);
+    std::cout << std::endl;
+
+    // 파이프라인: 500 샘플 (약 1초)
+    const int SAMPLES = 500;
+    startTracing();
+    runPipeline(SAMPLES);
+    stopTracing();
+    std::vector<TraceEvent> events = collectTrace();
+    bool sorted = std::is_sorted(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.tick < b.tick; });
+    std::vector<TraceStageStats> stats = traceLatencies(events);
+    std::cout << "pipeline: " << events.size() << " events" << (sorted ? "" : " (NOT SORTED)") << std::endl;
+    bool complete = stats.size() == TRACE_STAGES - 1;
+    for (const TraceStageStats& s : stats) {
+        std::cout << "  " << std::left << std::setw(12) << traceStageName(s.stage) << std::right << std::setw(5) << s.count
+                  << std::setprecision(1) << "  p50 " << std::setw(8) << s.p50Ns * 1e-3 << " us  p99 " << std::setw(8)
+                  << s.p99Ns * 1e-3 << " us  max " << std::setw(8) << s.maxNs * 1e-3 << " us" << std::endl;
+        complete = complete && s.count == SAMPLES;
+    }
+
+    const char* path = "/tmp/bench_trace.json";
+    uint64_t start = monotonicNs();
+    bool exported = exportChromeTrace(events, path);
+    std::cout << "export: " << (monotonicNs() - start) / 1000 << " us -> " << path << std::endl;
+
+    bool pass = on.p50 < BUDGET_NS && sorted && complete && exported;
+    std::cout << (pass ? "PASS" : "FAIL") << std::endl;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+// 전송 계층 벤치마크 (모의 백엔드, 하드웨어 없이)
+//   - 모의 시리얼(pty): 0x00~0xFF 모든 바이트가 양방향으로 바뀌지 않고 전달되는지 (CR/LF 변환, XON/XOFF, ISIG 문자 등)
+//   - RC 드라이버를 pty 위에서: SBUS 프레임을 쓰고 readRCChannel이 새 프레임을 볼 때까지 지연 (p50/p99)
+//   - PCA9685 드라이버를 SimulatedPCA9685 위에서: 초기화 후 레지스터(50Hz 프리스케일, AI, 안전 PWM), 네 모터 한 번 쓰기,
+//     NACK 재시도/오류 수, setMotorSpeeds 비용
+//   - 시리얼 피더: 파일 안에서 장치 순서가 섞인 기록을 시각 순서로 두 포트에 써 넣는지, 바이트 수와 지각
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 bench_transport.cpp ../src/psss/pca9685.cpp ../src/psss/motor_output.cpp ../src/ioss/rc_input.cpp ../src/oss/transport.cpp ../src/oss/serial_feed.cpp ../src/oss/blackbox.cpp ../src/oss/trace.cpp ../src/oss/perf_counters.cpp ../src/oss/timer.cpp -pthread -o bench_transport
+#include "../src/oss/transport.h"
+#include "../src/oss/serial_feed.h"
+#include "../src/oss/blackbox.h"
+#include "../src/oss/timer.h"
+#include "../src/psss/pca9685.h"
+#include "../src/ioss/rc_input.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+const char* FEED_PATH = "/tmp/bench_transport.bin";
+
+// fd에서 size바이트를 timeoutMs 안에 모두 읽기
+size_t readAll(int fd, uint8_t* out, size_t size, int timeoutMs) {
+    size_t got = 0;
+    uint64_t deadline = monotonicNs() + timeoutMs * 1000000ULL;
+    while (got < size && monotonicNs() < deadline) {
+        pollfd p = {fd, POLLIN, 0};
+        if (poll(&p, 1, 10) > 0) {
+            ssize_t n = read(fd, out + got, size - got);
+            got += n > 0 ? static_cast<size_t>(n) : 0;
+        }
+    }
+    return got;
+}
+
+void makeSbusFrame(uint16_t value, uint8_t* frame) {
+    frame[0] = 0x0F;
+    frame[SBUS_FRAME_SIZE - 1] = 0;
+    for (int i = 0; i < SBUS_CHANNELS; ++i) {
+        frame[1 + i * 2] = static_cast<uint8_t>(value >> 8);
+        frame[2 + i * 2] = static_cast<uint8_t>(value & 0xFF);
+    }
+    for (int i = 1; i < SBUS_FRAME_SIZE - 1; ++i) {
+        frame[SBUS_FRAME_SIZE - 1] ^= frame[i];
+    }
+}
+
+double percentile(std::vector<uint64_t> values, double p) {
+    std::sort(values.begin(), values.end());
+    return values.empty() ? 0.0 : values[static_cast<size_t>(p * (values.size() - 1))] * 1e-3;
+}
+
+int main() {
+    bool pass = true;
+    useSimulatedTransports(true);
+
+    // 바이트 투명성
+    {
+        int fd = openSerial("/dev/ttySIM0", B115200);
+        int peer = simulatedSerialPeer("/dev/ttySIM0");
+        uint8_t all[256], back[256];
+        for (int i = 0; i < 256; ++i) {
+            all[i] = static_cast<uint8_t>(i);
+        }
+        bool toDriver = write(peer, all, sizeof(all)) == 256 && readAll(fd, back, 256, 1000) == 256 &&
+                        std::equal(all, all + 256, back);
+        bool fromDriver = write(fd, all, sizeof(all)) == 256 && readAll(peer, back, 256, 1000) == 256 &&
+                          std::equal(all, all + 256, back);
+        std::cout << "pty raw bytes: to driver " << (toDriver ? "ok" : "CHANGED") << ", from driver "
+                  << (fromDriver ? "ok" : "CHANGED") << std::endl;
+        pass = pass && toDriver && fromDriver;
+        close(fd);
+    }
+
+    // RC 드라이버 수신 지연
+    {
+        const char* port = "/dev/ttySIM_RC";
+        initRC(port, B115200);
+        int peer = simulatedSerialPeer(port);
+        std::vector<uint64_t> latencies;
+        int received = 0;
+        for (int i = 0; i < 1000; ++i) {
+            uint8_t frame[SBUS_FRAME_SIZE];
+            uint16_t value = static_cast<uint16_t>(RC_MIN + i % (RC_MAX - RC_MIN));
+            makeSbusFrame(value, frame);
+            uint64_t before = getRCTimestampNs();
+            uint64_t sentNs = monotonicNs();
+            write(peer, frame, sizeof(frame));
+            while (monotonicNs() - sentNs < 100000000ULL) {
+                int channel = readRCChannel(1);
+                if (getRCTimestampNs() != before) {
+                    received += channel == value;
+                    latencies.push_back(monotonicNs() - sentNs);
+                    break;
+                }
+            }
+        }
+        std::cout << std::fixed << std::setprecision(1) << "rc over pty: " << received << "/1000 frames, latency p50 "
+                  << percentile(latencies, 0.5) << " us, p99 " << percentile(latencies, 0.99) << " us" << std::endl;
+        pass = pass && received == 1000;
+    }
+
+    // PCA9685 드라이버 + 모의 레지스터 파일
+    {
+        SimulatedPCA9685* chip = new SimulatedPCA9685();
+        PCA9685 driver{std::unique_ptr<I2CTransport>(chip)};
+        uint8_t mode1 = chip->reg(MODE1);
+        bool configured = chip->reg(PRESCALE) == 121 && (mode1 & 0x20) && !(mode1 & 0x10);
+        for (int m = 0; m < MOTOR_COUNT; ++m) {
+            configured = configured && chip->offCount(m) == SAFE_PWM;
+        }
+        std::cout << std::setprecision(2) << "pca9685 init: MODE1 0x" << std::hex << int(mode1) << std::dec << ", PRE_SCALE "
+                  << int(chip->reg(PRESCALE)) << " (" << chip->pwmFrequency() << " Hz), safe PWM "
+                  << (configured ? "ok" : "WRONG") << std::endl;
+        pass = pass && configured;
+
+        const int pwm[MOTOR_COUNT] = {250, 300, 350, 400};
+        uint64_t writesBefore = chip->writes();
+        bool written = driver.setMotorSpeeds(pwm);
+        for (int m = 0; m < MOTOR_COUNT; ++m) {
+            written = written && chip->offCount(m) == pwm[m] && chip->reg(LED0_ON_L + 4 * m) == 0;
+        }
+        written = written && chip->writes() == writesBefore + 1 && chip->offCount(4) == 0;
+        std::cout << "setMotorSpeeds: " << (written ? "ok" : "WRONG") << " (" << chip->writes() - writesBefore
+                  << " transaction)" << std::endl;
+        pass = pass && written;
+
+        // 두 번 NACK은 재시도로 성공, 세 번이면 실패하고 오류 1
+        chip->failNextWrites(2);
+        bool retried = driver.setMotorSpeeds(pwm) && driver.errorCount() == 0;
+        chip->failNextWrites(3);
+        bool failed = !driver.setMotorSpeeds(pwm) && driver.errorCount() == 1;
+        std::cout << "nack handling: retry " << (retried ? "ok" : "WRONG") << ", give up " << (failed ? "ok" : "WRONG")
+                  << std::endl;
+        pass = pass && retried && failed;
+
+        const int N = 1000000;
+        uint64_t start = monotonicNs();
+        for (int i = 0; i < N; ++i) {
+            driver.setMotorSpeeds(pwm);
+        }
+        std::cout << std::setprecision(1) << "setMotorSpeeds (simulated bus): "
+                  << static_cast<double>(monotonicNs() - start) / N << " ns" << std::endl;
+    }
+
+    // 피더: RC 100Hz와 GPS 10Hz 1초, 파일에는 RC를 모두 먼저 씀 (장치 사이 순서가 섞인 기록)
+    {
+        const uint64_t startNs = 1000000000ULL;
+        const int RC_FRAMES = 100, GPS_MESSAGES = 10, GPS_SIZE = 100;
+        BlackboxWriter writer;
+        if (!writer.open(FEED_PATH, startNs)) {
+            std::cerr << "Cannot write " << FEED_PATH << std::endl;
+            return 1;
+        }
+        uint8_t frame[SBUS_FRAME_SIZE];
+        makeSbusFrame(RC_MID, frame);
+        for (int i = 0; i < RC_FRAMES; ++i) {
+            writer.append(BLACKBOX_RC, frame, sizeof(frame), startNs + i * 10000000ULL);
+        }
+        uint8_t gps[GPS_SIZE] = {0xB5, 0x62, 0x01, 0x07};
+        for (int i = 0; i < GPS_MESSAGES; ++i) {
+            writer.append(BLACKBOX_GPS, gps, sizeof(gps), startNs + i * 100000000ULL + 5000000ULL);
+        }
+        writer.close();
+
+        int rcFd = openSerial("/dev/ttySIM1", B115200);
+        int gpsFd = openSerial("/dev/ttySIM2", B115200);
+        const char* const ports[BLACKBOX_DEVICES] = {nullptr, "/dev/ttySIM2", "/dev/ttySIM1", nullptr};
+        size_t rcBytes = 0, gpsBytes = 0;
+        uint64_t firstGpsNs = 0, lastRcNs = 0;
+        uint64_t feedStartNs = monotonicNs();
+        startSerialFeed(FEED_PATH, 1.0, ports);
+        uint8_t buffer[512];
+        while (!serialFeedFinished() || monotonicNs() - feedStartNs < 1200000000ULL) {
+            pollfd fds[2] = {{rcFd, POLLIN, 0}, {gpsFd, POLLIN, 0}};
+            poll(fds, 2, 10);
+            ssize_t n;
+            while ((n = read(rcFd, buffer, sizeof(buffer))) > 0) {
+                rcBytes += n;
+                lastRcNs = monotonicNs();
+            }
+            while ((n = read(gpsFd, buffer, sizeof(buffer))) > 0) {
+                gpsBytes += n;
+                firstGpsNs = firstGpsNs ? firstGpsNs : monotonicNs();
+            }
+        }
+        stopSerialFeed();
+        SerialFeedStats stats = serialFeedStats();
+        bool complete = rcBytes == RC_FRAMES * sizeof(frame) && gpsBytes == GPS_MESSAGES * sizeof(gps);
+        bool ordered = firstGpsNs && firstGpsNs < lastRcNs;
+        double wallSec = (lastRcNs - feedStartNs) * 1e-9;
+        std::cout << std::setprecision(3) << "serial feed: rc " << rcBytes << " B, gps " << gpsBytes << " B, interleaved "
+                  << (ordered ? "yes" : "NO") << ", 1 s of data in " << wallSec << " s, max late "
+                  << stats.maxLateNs / 1000 << " us, overruns " << stats.overruns << std::endl;
+        pass = pass && complete && ordered && stats.overruns == 0 && wallSec > 0.95 && wallSec < 1.2;
+    }
+
+    std::cout << (pass ? "PASS" : "FAIL") << std::endl;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// 워치독 벤치마크
+//   - kick() 비용 (제어 루프에 더해지는 비용)
+//   - 감지 지연: 1kHz로 신호를 보내던 스레드를 멈추고 마지막 신호부터 onMiss까지 (제한 20ms, 기본 감시 주기 5ms)
+//     기대값은 제한 시간 + 감시 주기 2번 (+ 스케줄 여유 2ms) 이하, 다시 신호를 보내면 onRecover
+//     VM/단일 코어에서는 스케줄 지연으로 최대값이 튀므로 판정은 p90, 최대값은 출력만
+//     멈추지 않은 동안의 놓침(거짓 경보)은 따로 셈
+//   - 감시 스레드 우선순위를 올릴 권한이 없으면 일반 스레드로 측정 (경고 출력)
+// 빌드: g++ -O2 -DNDEBUG -std=c++17 -pthread bench_watchdog.cpp ../src/oss/watchdog.cpp ../src/oss/timer.cpp -o bench_watchdog
+#include "../src/oss/watchdog.h"
+#include "../src/oss/timer.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+const uint64_t TIMEOUT_NS = 20000000ULL;
+const uint64_t CHECK_PERIOD_NS = WATCHDOG_CHECK_PERIOD_NS;
+const int STALLS = 50;
+
+int main() {
+    bool pass = true;
+
+    // kick 비용
+    {
+        Heartbeat& heartbeat = watchdogRegister("cost", UINT64_MAX / 2);
+        const int N = 100000000;
+        uint64_t start = monotonicNs();
+        for (int i = 0; i < N; ++i) {
+            heartbeat.kick();
+            asm volatile("" ::: "memory");
+        }
+        std::cout << std::fixed << std::setprecision(2) << "kick: " << static_cast<double>(monotonicNs() - start) / N
+                  << " ns" << std::endl;
+        watchdogRelease(heartbeat);
+    }
+
+    std::atomic<uint64_t> lastKickNs{0};
+    std::atomic<uint64_t> missNs{0};
+    std::atomic<int> recoveries{0};
+    std::atomic<int> falseMisses{0};
+    std::atomic<bool> stall{false};
+    std::atomic<bool> running{true};
+    Heartbeat& heartbeat = watchdogRegister("task", TIMEOUT_NS, [&] {
+        missNs = monotonicNs();
+        falseMisses += !stall;
+    }, [&] { ++recoveries; });
+    startWatchdog(CHECK_PERIOD_NS);
+
+    // 1kHz로 신호, stall이 켜지면 멈춤
+    std::thread task([&] {
+        while (running) {
+            if (!stall) {
+                heartbeat.kick();
+                lastKickNs = monotonicNs();
+            }
+            usleep(1000);
+        }
+    });
+
+    usleep(100000);
+    std::vector<double> latencies;
+    for (int i = 0; i < STALLS; ++i) {
+        missNs = 0;
+        stall = true;
+        uint64_t deadline = monotonicNs() + 10 * TIMEOUT_NS;
+        while (missNs == 0 && monotonicNs() < deadline) {
+            usleep(100);
+        }
+        if (missNs == 0) {
+            latencies.push_back(1e9);   // 감지 못함
+        } else {
+            latencies.push_back((missNs - lastKickNs) * 1e-6);
+        }
+        stall = false;
+        usleep(50000);
+    }
+    stopWatchdog();
+    running = false;
+    task.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    double limitMs = (TIMEOUT_NS + 2 * CHECK_PERIOD_NS) * 1e-6 + 2.0;
+    std::cout << std::setprecision(3) << "detection (timeout " << TIMEOUT_NS * 1e-6 << " ms, check " << CHECK_PERIOD_NS * 1e-6
+              << " ms): min " << latencies.front() << " ms, median " << latencies[STALLS / 2] << " ms, p90 " << latencies[STALLS * 9 / 10]
+              << " ms, max "
+              << latencies.back() << " ms" << std::endl;
+    std::cout << "recoveries: " << recoveries << "/" << STALLS << ", false misses " << falseMisses << std::endl;
+    for (const WatchdogStatus& s : watchdogStatus()) {
+        std::cout << "  " << s.name << ": " << s.misses << " misses" << std::endl;
+    }
+    pass = falseMisses == 0 && latencies[STALLS * 9 / 10] <= limitMs && latencies.back() < 1e9 && recoveries >= STALLS;
+    std::cout << (pass ? "PASS" : "FAIL") << std::endl;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// IMU 온도 보정표 오프라인 적합 도구
+// 정지 상태로 온도를 올리거나 내리며 기록한 CSV로부터 imu_temperature.bin 생성
+//   입력 헤더: Temperature,GyroX,GyroY,GyroZ,AccelX,AccelY,AccelZ (°C, rad/s, m/s^2)
+//   가속도는 기록 중 자세가 변하지 않아야 함 (중력은 기준 온도 값과 함께 빠짐)
+// 사용: ./fit_temperature_bias log.csv <IMU 시리얼> [imu_temperature.bin]
+// 빌드: g++ -O2 -std=c++17 -I/usr/include/eigen3 fit_temperature_bias.cpp ../src/psss/temperature_compensation.cpp -o fit_temperature_bias
+#include "../src/psss/temperature_compensation.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+
+bool readSamples(const char* path, std::vector<TemperatureSample>& samples) {
+    std::ifstream file(path);
+    if (!file) {
+        perror("Failed to open log");
+        return false;
+    }
+    std::string line;
+    std::getline(file, line);  // 헤더
+    int lineNumber = 1;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream in(line);
+        TemperatureSample s;
+        if (!(in >> s.temperatureC >> s.gyro.x() >> s.gyro.y() >> s.gyro.z()
+                 >> s.accel.x() >> s.accel.y() >> s.accel.z())) {
+            std::cerr << "Skipping malformed line " << lineNumber << std::endl;
+            continue;
+        }
+        if (std::isnan(s.temperatureC) || s.gyro.hasNaN() || s.accel.hasNaN()) {
+            continue;
+        }
+        samples.push_back(s);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <log.csv> <imu serial> [output]" << std::endl;
+        return 1;
+    }
+    const char* output = argc > 3 ? argv[3] : "imu_temperature.bin";
+    uint32_t serial = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 0));
+
+    std::vector<TemperatureSample> samples;
+    if (!readSamples(argv[1], samples) || samples.empty()) {
+        std::cerr << "No samples" << std::endl;
+        return 1;
+    }
+
+    // 격자점별 샘플 수 (데이터가 없는 구간은 외삽 값임을 표시)
+    int counts[TemperatureBiasTable::POINTS] = {0};
+    float minT = samples[0].temperatureC, maxT = samples[0].temperatureC;
+    for (const TemperatureSample& s : samples) {
+        int k = static_cast<int>(std::lround((s.temperatureC - TemperatureBiasTable::MIN_C) / TemperatureBiasTable::STEP_C));
+        counts[std::min(std::max(k, 0), TemperatureBiasTable::POINTS - 1)]++;
+        minT = std::min(minT, s.temperatureC);
+        maxT = std::max(maxT, s.temperatureC);
+    }
+
+    TemperatureBiasTable table;
+    table.fit(samples);
+
+    // 적합 잔차 (보정 후 남는 바이어스의 온도 의존성 확인용)
+    Eigen::Matrix<double, 6, 1> before = Eigen::Matrix<double, 6, 1>::Zero();
+    Eigen::Matrix<double, 6, 1> after = Eigen::Matrix<double, 6, 1>::Zero();
+    Eigen::Matrix<double, 6, 1> meanBefore = Eigen::Matrix<double, 6, 1>::Zero();
+    Eigen::Matrix<double, 6, 1> meanAfter = Eigen::Matrix<double, 6, 1>::Zero();
+    std::vector<Eigen::Matrix<double, 6, 1>> raw(samples.size()), corrected(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        Eigen::Vector3f gyro = samples[i].gyro, accel = samples[i].accel;
+        raw[i] << gyro.cast<double>(), accel.cast<double>();
+        table.correct(samples[i].temperatureC, gyro, accel);
+        corrected[i] << gyro.cast<double>(), accel.cast<double>();
+        meanBefore += raw[i];
+        meanAfter += corrected[i];
+    }
+    meanBefore /= samples.size();
+    meanAfter /= samples.size();
+    for (size_t i = 0; i < samples.size(); ++i) {
+        before += (raw[i] - meanBefore).cwiseAbs2();
+        after += (corrected[i] - meanAfter).cwiseAbs2();
+    }
+    before = (before / samples.size()).cwiseSqrt();
+    after = (after / samples.size()).cwiseSqrt();
+
+    std::cout << samples.size() << " samples, " << minT << " ~ " << maxT << " C" << std::endl;
+    std::cout << std::fixed << std::setprecision(5)
+              << "  T[C]     gx        gy        gz        ax        ay        az     samples" << std::endl;
+    for (int k = 0; k < TemperatureBiasTable::POINTS; ++k) {
+        float t = TemperatureBiasTable::MIN_C + k * TemperatureBiasTable::STEP_C;
+        TemperatureBiasTable::Row row = table.biasAt(t);
+        std::cout << std::setw(6) << std::setprecision(1) << t << std::setprecision(5);
+        for (int a = 0; a < 6; ++a) {
+            std::cout << std::setw(10) << row(a);
+        }
+        std::cout << std::setw(8) << counts[k] << (counts[k] == 0 ? " (extrapolated)" : "") << std::endl;
+    }
+    std::cout << "std before  " << before.transpose() << std::endl
+              << "std after   " << after.transpose() << std::endl;
+
+    if (!table.save(output, serial)) {
+        return 1;
+    }
+    std::cout << "Wrote " << output << " for IMU " << serial << std::endl;
+    return 0;
+}
@@ -263,7 +263,13 @@ int main() {
     auto previousTime = std::chrono::steady_clock::now();
 
     while (true) {
-        float dt = 0.025f;
+        // 실제 루프 간격으로 dt 계산
+        auto currentTime = std::chrono::steady_clock::now();
+        float dt = std::chrono::duration<float>(currentTime - previousTime).count();
+        previousTime = currentTime;
+        if (dt <= 0.0f) {
+            dt = 0.001f;
+        }
 
         int throttle_value = readRCChannel(3); // 채널 3에서 스로틀 값 읽기
         int aileron_value = readRCChannel(1);  // 채널 1에서 에일러론 값 읽기
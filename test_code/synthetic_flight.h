@@ -0,0 +1,184 @@
+// 벤치마크용 합성 비행 기록과 재생 (bench_replay, bench_suite)
+//   - 참값을 아는 20초 비행(정지 4초 → 북쪽 1 m/s^2 가속 2초 → 2 m/s 순항)을 센서 바이트로 합성
+//     (IMU $VNRRG,20 400Hz, GPS UBX NAV-PVT 10Hz, GY-39 기압 10Hz)
+//   - 재생은 fork한 자식 프로세스에서 실행 (드라이버 정적 상태와 센서 스레드가 실행마다 새로 시작하도록)
+#ifndef SYNTHETIC_FLIGHT_H
+#define SYNTHETIC_FLIGHT_H
+
+#include "../src/psss/pose_estimator.h"
+#include "../src/psss/geodetic.h"
+#include "../src/ioss/imu_sensor.h"
+#include "../src/ioss/gps_sensor.h"
+#include "../src/ioss/barometer_sensor.h"
+#include "../src/oss/blackbox.h"
+#include "../src/oss/timer.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <cmath>
+#include <cstdio>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+inline const char* SYNTHETIC_PATH = "/tmp/bench_replay.bin";
+const double GRAVITY = 9.80665;
+const double DURATION = 20.0;
+const double STILL_END = 4.0;
+const double ACCEL_END = 6.0;
+const double ACCELERATION = 1.0;
+const double HOME_LAT = 37.5665, HOME_LON = 126.9780, HOME_ALT = 50.0;
+const double FLIGHT_VIBRATION = 20.0;     // 정지 대비 비행 중 IMU 잡음 배율
+
+struct ReplayResult {
+    float pose[9];
+    bool ready;
+    double wallSec;
+    double dataSec;
+};
+
+// 북쪽 위치/속도 참값 (동쪽/수직은 0, 자세는 수평 북향)
+inline void truthAt(double t, double& north, double& velocity, double& accel) {
+    if (t < STILL_END) {
+        north = velocity = accel = 0;
+    } else if (t < ACCEL_END) {
+        double s = t - STILL_END;
+        north = 0.5 * ACCELERATION * s * s;
+        velocity = ACCELERATION * s;
+        accel = ACCELERATION;
+    } else {
+        double cruise = ACCELERATION * (ACCEL_END - STILL_END);
+        north = 0.5 * cruise * (ACCEL_END - STILL_END) + cruise * (t - ACCEL_END);
+        velocity = cruise;
+        accel = 0;
+    }
+}
+
+inline void putLE(uint8_t* p, int32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<uint8_t>(static_cast<uint32_t>(value) >> (8 * i));
+    }
+}
+
+inline void putBE(uint8_t* p, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        p[i] = static_cast<uint8_t>(value >> (8 * (bytes - 1 - i)));
+    }
+}
+
+inline bool writeSyntheticLog(const char* path) {
+    const uint64_t startNs = 1000000000ULL;
+    BlackboxWriter writer;
+    if (!writer.open(path, startNs)) {
+        return false;
+    }
+    std::mt19937 rng(42);
+    std::normal_distribution<double> gyroNoise(0.0, 0.002), accelNoise(0.0, 0.02), gpsNoise(0.0, 0.3), baroNoise(0.0, 2.0);
+
+    // 자기장: 편각 -9도, 복각 54도, 0.5 gauss (추정기 설정과 같음), 북향 수평이므로 기체 좌표 = NED
+    const double declination = -9.0 * M_PI / 180.0, inclination = 54.0 * M_PI / 180.0;
+    Eigen::Vector3d field = 0.5 * Eigen::Vector3d(std::cos(inclination) * std::cos(declination),
+                                                  std::cos(inclination) * std::sin(declination), std::sin(inclination));
+    LocalFrame home;
+    home.setOrigin(HOME_LAT, HOME_LON, HOME_ALT);
+    double metersPerDegLat = home.toNEDd(HOME_LAT + 1e-4, HOME_LON, HOME_ALT)(0) / 1e-4;
+
+    const int imuRate = 400, gpsRate = 10, baroRate = 10;
+    for (int k = 1; k <= static_cast<int>(DURATION * imuRate); ++k) {
+        double t = static_cast<double>(k) / imuRate;
+        uint64_t timeNs = startNs + static_cast<uint64_t>(t * 1e9);
+        double north, velocity, accel;
+        truthAt(t, north, velocity, accel);
+
+        // 비행 중에는 모터 진동 추가 (없으면 등속 구간을 정지로 판정하여 영속도 업데이트가 들어감)
+        double vibration = t < STILL_END ? 1.0 : FLIGHT_VIBRATION;
+        char line[160];
+        int n = snprintf(line, sizeof(line), "$VNRRG,20,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.5f,%.5f,%.5f",
+                         field(0), field(1), field(2),
+                         accel + vibration * accelNoise(rng), vibration * accelNoise(rng), -GRAVITY + vibration * accelNoise(rng),
+                         vibration * gyroNoise(rng), vibration * gyroNoise(rng), vibration * gyroNoise(rng));
+        unsigned short crc = calculateIMUCRC(reinterpret_cast<unsigned char*>(line) + 1, n - 1);
+        n += snprintf(line + n, sizeof(line) - n, "*%04X\r\n", crc);
+        writer.append(BLACKBOX_IMU, line, n, timeNs);
+
+        if (k % (imuRate / gpsRate) == 0) {
+            // NAV-PVT: 헤더 6 + 페이로드 92 + 체크섬 2 (드라이버는 체크섬을 검사하지 않음)
+            uint8_t frame[100] = {0xB5, 0x62, 0x01, 0x07, 92, 0};
+            uint8_t* payload = frame + 6;
+            putLE(payload + 0, static_cast<int32_t>(t * 1000));
+            payload[23] = 12;
+            double dn = north + gpsNoise(rng), de = gpsNoise(rng), dd = gpsNoise(rng);
+            putLE(payload + 24, static_cast<int32_t>(std::lround((HOME_LON + de / (metersPerDegLat * std::cos(HOME_LAT * M_PI / 180.0))) * 1e7)));
+            putLE(payload + 28, static_cast<int32_t>(std::lround((HOME_LAT + dn / metersPerDegLat) * 1e7)));
+            putLE(payload + 32, static_cast<int32_t>(std::lround((HOME_ALT - dd) * 1000)));
+            putLE(payload + 48, static_cast<int32_t>(std::lround(velocity * 1000)));
+            putLE(payload + 60, static_cast<int32_t>(std::lround(velocity * 1000)));
+            writer.append(BLACKBOX_GPS, frame, sizeof(frame), timeNs);
+        }
+        if (k % (imuRate / baroRate) == 0) {
+            // GY-39 0x45: 온도, 기압(0.01Pa), 습도, 고도 (빅엔디언) + 합 체크섬
+            uint8_t frame[15] = {0x5A, 0x5A, 0x45, 10};
+            double pressure = 101325.0 * std::pow(1.0 - 2.25577e-5 * HOME_ALT, 5.25588) + baroNoise(rng);
+            putBE(frame + 4, 2500, 2);
+            putBE(frame + 6, static_cast<uint32_t>(std::lround(pressure * 100)), 4);
+            putBE(frame + 10, 4000, 2);
+            putBE(frame + 12, static_cast<uint32_t>(HOME_ALT), 2);
+            uint8_t sum = 0;
+            for (int i = 0; i < 14; ++i) {
+                sum += frame[i];
+            }
+            frame[14] = sum;
+            writer.append(BLACKBOX_BARO, frame, sizeof(frame), timeNs);
+        }
+    }
+    writer.close();
+    return true;
+}
+
+// 자식 프로세스에서 재생하고 결과를 파이프로 전달 (센서 스레드가 드라이버 안에서 끝나지 않으므로 _exit)
+inline bool replay(const char* path, double speed, ReplayResult& result) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        ReplayResult r = {};
+        if (startReplay(path, speed)) {
+            initIMU("/dev/null", B115200);
+            initGPS("/dev/null", B115200);
+            initBarometer("/dev/null", B9600);
+            uint64_t start = monotonicNs();
+            PoseEstimator* estimator = new PoseEstimator();  // 소멸자는 센서 스레드를 기다리므로 해제하지 않음
+            while (!replayFinished()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            r.wallSec = (monotonicNs() - start) * 1e-9;
+            Eigen::VectorXf pose = estimator->getPose();
+            for (int i = 0; i < 9; ++i) {
+                r.pose[i] = pose(i);
+            }
+            r.ready = estimator->isReady();
+            BlackboxReader reader;
+            BlackboxChunk chunk;
+            uint64_t lastNs = 0;
+            if (reader.open(path)) {
+                while (reader.next(chunk)) {
+                    lastNs = std::max(lastNs, chunk.timestampNs);
+                }
+                r.dataSec = (lastNs - reader.startNs()) * 1e-9;
+            }
+        }
+        ssize_t written = write(fds[1], &r, sizeof(r));
+        _exit(written == sizeof(r) ? 0 : 1);
+    }
+    close(fds[1]);
+    ssize_t n = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return n == sizeof(result) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+#endif
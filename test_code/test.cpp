@@ -16,6 +16,7 @@
 #include <algorithm>           // std::clamp 함수 사용
 #include <chrono>              // 시간 측정을 위한 라이브러리
 #include <thread>
+#include "../src/oss/loop_stats.h"  // 루프 주기/실행 시간 통계
 
 #define PCA9685_ADDR 0x40      // PCA9685 I2C 주소
 #define MODE1 0x00             // 모드1 레지스터
@@ -374,17 +375,17 @@ void *controlLoop(void *arg) {
 
     //     // std::this_thread::sleep_for(std::chrono::milliseconds(25)); 
     //         }
+    LoopStats& loopStats = registerLoop("attitude", 0);  // IMU 수신 주기로 실행
     while (true) {
-        // 현재 시간 계산
-        auto imuStartTime = std::chrono::steady_clock::now();
-
         // IMU 데이터 읽기
         IMUData imuData = readIMU();
 
-        // 현재 시간과 IMU 시작 시간의 경과 시간 측정
-        auto imuEndTime = std::chrono::steady_clock::now();
-        std::chrono::duration<float> imuElapsed = imuEndTime - imuStartTime;
-        float dt = imuElapsed.count(); // dt는 초 단위
+        // 이전 반복부터의 경과 시간 (IMU 읽기 시간이 아니라 루프 주기)
+        auto currentTime = std::chrono::steady_clock::now();
+        std::chrono::duration<float> elapsed = currentTime - previousTime;
+        previousTime = currentTime;
+        float dt = elapsed.count(); // dt는 초 단위
+        loopStats.begin();
 
         // IMU 데이터 보정
         float correctedGyroZ = imuData.gyroZ - offsetGyroZ; // 보정된 자이로 Z값
@@ -417,6 +418,7 @@ void *controlLoop(void *arg) {
         pca9685.setMotorSpeed(1, motor2_PWM);
         pca9685.setMotorSpeed(2, motor3_PWM);
         pca9685.setMotorSpeed(3, motor4_PWM);
+        loopStats.end();
      
         // 디버깅 출력
         std::cout << "\rRoll Adj: " << roll_adj 
@@ -437,8 +439,6 @@ void *controlLoop(void *arg) {
         return nullptr;
     }
 
-auto previousTime = std::chrono::steady_clock::now();
-
 int main() {
         // 메모리 잠금
     if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {